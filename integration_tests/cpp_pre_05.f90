@@ -0,0 +1,11 @@
+program cpp_pre_05
+implicit none
+#include "guarded.h"
+#include "once.h"
+#include "guarded.h"
+#include "once.h"
+print *, guarded_value, once_value
+if (guarded_value /= 3) error stop
+if (once_value /= 4) error stop
+if (GUARDED_VALUE + once_value /= 7) error stop
+end program
@@ -0,0 +1,5 @@
+#ifndef CPP_PRE_05_GUARDED_H
+#define CPP_PRE_05_GUARDED_H
+#define GUARDED_VALUE 3
+integer, parameter :: guarded_value = GUARDED_VALUE
+#endif
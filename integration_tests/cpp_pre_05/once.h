@@ -0,0 +1,2 @@
+#pragma once
+integer, parameter :: once_value = 4
@@ -8,22 +8,22 @@ program file_11
 
     open(newunit=u, file="file_01_data.txt", status="old")
     print *, u
-    ! -10 is returned by gfortran, 3 is returned by lfortran
-    ! similarly for other asserts below
-    if (u /= -10 .and. u /= 3) error stop
+    ! Negative units, like in gfortran, which do not clash with units
+    ! picked by the program
+    if (u /= -10) error stop
     close(unit = 1)
 
     open(newunit=u, file="file_01_data.txt", status="old")
     print *, u
-    if (u /= -11 .and. u /= 1) error stop
+    if (u /= -11) error stop
 
     open(newunit=u, file="file_01_data.txt", status="old")
     print *, u
-    if (u /= -12 .and. u /= 4) error stop
+    if (u /= -12) error stop
 
     close(unit = 0)
     open(newunit=u, file="file_01_data.txt", status="old")
     print *, u
-    if (u /= -13 .and. u /= 0) error stop
+    if (u /= -13) error stop
 
 end program
@@ -0,0 +1,68 @@
+program file_21
+    implicit none
+    integer :: u = 11, ios, i, n
+    integer :: a(3, 4), b(3, 4)
+    real(8), allocatable :: x(:), y(:)
+    character(len=5) :: s, t
+    logical :: l(3), m(3)
+
+    a = reshape([(i, i = 1, 12)], [3, 4])
+    allocate(x(1000), y(1000))
+    do i = 1, 1000
+        x(i) = i / 4.0d0
+    end do
+    s = "hello"
+
+    open(u, file="file_21_tmp.dat", form="unformatted")
+    write(u) 12, a, s
+    write(u) x
+    write(u)
+    write(u) -7
+    close(u)
+
+    open(u, file="file_21_tmp.dat", form="unformatted", status="old")
+    read(u) n, b, t
+    print *, n, t
+    if (n /= 12 .or. any(a /= b) .or. t /= "hello") error stop
+    read(u) y
+    print *, sum(y)
+    if (any(x /= y)) error stop
+    read(u)
+    ! Only the first item of the record is read
+    read(u) n
+    if (n /= -7) error stop
+    read(u, iostat=ios) n
+    print *, ios
+    if (ios /= -1) error stop
+    close(u)
+
+    open(u, file="file_21_tmp.dat", form="unformatted", access="stream")
+    write(u) a, x(1:3)
+    close(u)
+    open(u, file="file_21_tmp.dat", form="unformatted", access="stream", status="old")
+    read(u) b
+    read(u) y(1), y(2), y(3)
+    close(u)
+    print *, b(3, 4), y(3)
+    if (any(a /= b) .or. any(x(1:3) /= y(1:3))) error stop
+
+    ! Array sections and logicals are written as one record, logicals with
+    ! 4 bytes like in gfortran
+    l = [.true., .false., .true.]
+    open(u, file="file_21_tmp.dat", form="unformatted")
+    write(u) 5, x(1:10:2), l
+    write(u) a(2, ::2)
+    close(u)
+    open(u, file="file_21_tmp.dat", form="unformatted", access="stream", status="old")
+    read(u) n
+    print *, n
+    if (n /= 4 + 5*8 + 3*4) error stop
+    close(u)
+    open(u, file="file_21_tmp.dat", form="unformatted", status="old")
+    read(u) n, y(1:5), m
+    if (n /= 5 .or. any(y(1:5) /= x(1:10:2)) .or. any(m .neqv. l)) error stop
+    read(u) b(1, 1:2)
+    print *, b(1, 1:2)
+    if (b(1, 1) /= 2 .or. b(1, 2) /= 8) error stop
+    close(u, status="delete")
+end program
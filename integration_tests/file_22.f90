@@ -0,0 +1,35 @@
+program file_22
+    ! List-directed input: separators, repeat counts, null values and slashes;
+    ! the comma starting the second record belongs to the record end before it
+    implicit none
+    integer :: u = 11, a(12), ios
+    real(8) :: x(6)
+    complex :: z(2)
+    integer(1) :: i1
+    integer(2) :: i2
+    integer(8) :: i8
+
+    a = -1
+    open(u, file="file_22_data.txt", status="old")
+    read(u, *) a
+    print *, a
+    if (any(a /= [1, 2, 3, 7, 7, 7, 7, -1, -1, 5, -1, -1])) error stop
+
+    read(u, *) x
+    print *, x
+    if (abs(x(1) - 150) > 1d-12 .or. abs(x(2) + 2.5d-3) > 1d-15) error stop
+    if (any(abs(x(3:5) - 0.1d0) > 1d-15) .or. abs(x(6) - 100) > 1d-12) error stop
+
+    read(u, *) z
+    print *, z
+    if (abs(z(1) - (1.5, -2)) > 1e-6 .or. abs(z(2) - (3, 40)) > 1e-6) error stop
+
+    read(u, *) i1, i2, i8
+    print *, i1, i2, i8
+    if (i1 /= -128 .or. i2 /= 32767 .or. i8 /= -huge(i8) - 1) error stop
+
+    read(u, *, iostat=ios) a(1)
+    print *, ios
+    if (ios /= -1) error stop
+    close(u)
+end program
@@ -0,0 +1,44 @@
+program file_23
+    implicit none
+    integer :: u = 12, ios, i, id1, id2
+    integer, asynchronous :: n
+    real(8), asynchronous, allocatable :: x(:), y(:)
+    integer, asynchronous :: a(100), b(100)
+
+    allocate(x(100000), y(100000))
+    do i = 1, size(x)
+        x(i) = i / 8.0d0
+    end do
+    a = [(i, i = 1, 100)]
+    n = 5
+
+    open(u, file="file_23_tmp.dat", form="unformatted", asynchronous="yes")
+    write(u, asynchronous="yes", id=id1) n, x
+    write(u, asynchronous="yes", id=id2) a
+    wait(u, id=id1)
+    ! A synchronous transfer follows the pending ones
+    write(u) 42
+    wait(u, id=id2, iostat=ios)
+    print *, id1 < id2, ios
+    if (id1 >= id2 .or. ios /= 0) error stop
+    close(u)
+
+    open(u, file="file_23_tmp.dat", form="unformatted", status="old", &
+        asynchronous="yes")
+    read(u, asynchronous="yes") n, y
+    read(u, asynchronous="yes") b
+    wait(u, iostat=ios)
+    print *, n, sum(y), sum(b), ios
+    if (n /= 5 .or. any(x /= y) .or. any(a /= b) .or. ios /= 0) error stop
+    read(u) n
+    print *, n
+    if (n /= 42) error stop
+    ! The end of the file is reported by the wait
+    read(u, asynchronous="yes") n
+    wait(u, iostat=ios)
+    print *, ios /= 0
+    if (ios == 0) error stop
+    close(u)
+    ! A unit that is not connected has no pending transfers
+    wait(u)
+end program
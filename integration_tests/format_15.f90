@@ -0,0 +1,41 @@
+! test formatted output of whole arrays
+program format_15
+    implicit none
+
+    real(8), allocatable :: x(:)
+    integer, allocatable :: m(:, :)
+    integer :: i, n(4)
+    logical :: l(3)
+
+    allocate(x(6), m(2, 3))
+    do i = 1, 6
+        x(i) = i / 4.0_8
+    end do
+    m = reshape([1, 2, 3, 4, 5, 6], [2, 3])
+    n = [10, 20, 30, 40]
+    l = [.true., .false., .true.]
+
+    print "(3f8.3)", x
+    print "(f8.3)", x
+    print "(6i3)", m
+    print "('m:', 3i3)", m
+    write (*, "(a, 6i3, a, i4)") "m =", m, " n1 =", n(1)
+    print "(4i4)", n
+    print "(3l2)", l
+    call print_assumed_shape(x(1:6:2))
+    call print_explicit_shape(x, 6)
+
+contains
+
+    subroutine print_assumed_shape(a)
+    real(8), intent(in) :: a(:)
+    print "(3f8.3)", a
+    end subroutine
+
+    subroutine print_explicit_shape(a, k)
+    integer, intent(in) :: k
+    real(8), intent(in) :: a(k)
+    write (*, "(2es12.4)") a
+    end subroutine
+
+end program
@@ -0,0 +1,53 @@
+program intrinsics_290
+    ! random_seed and random_number on whole arrays
+    implicit none
+    integer :: n
+    integer, allocatable :: seed(:), seed2(:)
+    real :: x(1000), y(1000), z(4, 250)
+    real(8), allocatable :: d(:)
+    real :: s(10)
+
+    call random_seed(size=n)
+    print *, n
+    if (n < 1) error stop
+    allocate(seed(n), seed2(n))
+
+    call random_seed(get=seed)
+    call random_number(x)
+    call random_seed(put=seed)
+    call random_number(y)
+    if (any(x /= y)) error stop
+
+    ! The same numbers are drawn one at a time after reseeding
+    call random_seed(put=seed)
+    call random_number(y(1))
+    if (y(1) /= x(1)) error stop
+
+    call random_seed(put=seed)
+    call random_number(z)
+    if (any(reshape(z, [1000]) /= x)) error stop
+
+    call random_seed(get=seed2)
+    call random_number(y)
+    if (all(x == y)) error stop
+    call random_seed(put=seed2)
+    call random_number(x)
+    if (any(x /= y)) error stop
+
+    if (minval(x) < 0 .or. maxval(x) >= 1) error stop
+    print *, abs(sum(x) / size(x) - 0.5) < 0.05
+
+    allocate(d(100000))
+    call random_number(d)
+    if (minval(d) < 0 .or. maxval(d) >= 1) error stop
+    print *, abs(sum(d) / size(d) - 0.5d0) < 0.01d0
+    print *, abs(sum((d - 0.5d0)**2) / size(d) - 1/12.d0) < 0.005d0
+
+    ! Non contiguous section
+    s = -1
+    call random_number(s(1:10:2))
+    if (any(s(2:10:2) /= -1)) error stop
+    if (any(s(1:10:2) < 0)) error stop
+
+    call random_seed()
+end program
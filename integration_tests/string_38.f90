@@ -0,0 +1,43 @@
+program string_38
+    ! Temporaries of concatenations, substrings and comparisons
+    implicit none
+    character(len=20) :: line
+    character(len=:), allocatable :: acc
+    character(len=5) :: a, b
+    integer :: i, n_words, n_chars
+
+    a = "ab"
+    b = "cd"
+    acc = trim(a) // "-" // trim(b) // "-" // "ef"
+    print *, acc
+    if (acc /= "ab-cd-ef") error stop
+    if (len(trim(a) // trim(b) // "x") /= 5) error stop
+
+    line = "alpha beta  gamma"
+    n_words = 0
+    n_chars = 0
+    do i = 1, len(line)
+        if (line(i:i) /= " ") then
+            n_chars = n_chars + 1
+            if (i == 1) then
+                n_words = n_words + 1
+            else if (line(i-1:i-1) == " ") then
+                n_words = n_words + 1
+            end if
+        end if
+    end do
+    print *, n_words, n_chars
+    if (n_words /= 3) error stop
+    if (n_chars /= 14) error stop
+
+    if (line(1:5) // line(7:10) /= "alphabeta") error stop
+    if (.not. (line(1:5) // "x" < line(7:10) // "y")) error stop
+
+    acc = ""
+    do i = 1, 1000
+        acc = acc // line(i - (i-1)/5*5:i - (i-1)/5*5) // ""
+    end do
+    print *, len(acc), acc(1:10)
+    if (len(acc) /= 1000) error stop
+    if (acc(996:1000) /= "alpha") error stop
+end program
@@ -0,0 +1,49 @@
+program sum_03
+    implicit none
+    integer, parameter :: n = 100003
+    real(8) :: x(n), m(4, 5)
+    real :: y(10)
+    real(8), allocatable :: z(:)
+    real(8) :: s, big(3)
+    integer :: i
+
+    do i = 1, n
+        x(i) = 1.0d0 / i
+    end do
+    s = sum(x)
+    print *, s
+    if (abs(s - 12.090176129263348d0) > 1d-12) error stop
+    if (abs(maxval(x) - 1d0) > 0) error stop
+    if (abs(minval(x) - 1d0 / n) > 1d-20) error stop
+
+    do i = 1, 10
+        y(i) = i
+    end do
+    print *, sum(y), product(y), maxval(y), minval(y), norm2(y)
+    if (abs(sum(y) - 55) > 1e-6) error stop
+    if (abs(product(y) - 3628800) > 1) error stop
+    if (abs(norm2(y) - sqrt(385.0)) > 1e-5) error stop
+
+    m = 2
+    m(3, 4) = -7
+    print *, sum(m), minval(m), maxval(m)
+    if (abs(sum(m) - 31) > 1d-12) error stop
+    if (abs(minval(m) + 7) > 0) error stop
+
+    allocate(z(1000))
+    z = -1.5d0
+    print *, sum(z), maxval(z), product(z(1:3))
+    if (abs(sum(z) + 1500) > 1d-9) error stop
+    if (abs(maxval(z) + 1.5d0) > 0) error stop
+    deallocate(z)
+
+    ! The squares overflow
+    big = [3d200, 4d200, 0d0]
+    print *, norm2(big)
+    if (abs(norm2(big) / 5d200 - 1) > 1d-15) error stop
+
+    allocate(z(0))
+    if (maxval(z) /= -huge(z)) error stop
+    if (minval(z) /= huge(z)) error stop
+    if (sum(z) /= 0) error stop
+end program
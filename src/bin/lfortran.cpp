@@ -3,6 +3,13 @@
 #include <stdlib.h>
 #include <filesystem>
 #include <random>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <deque>
+#include <map>
+#include <set>
 #define CLI11_HAS_FILESYSTEM 0
 #include <bin/CLI11.hpp>
 
@@ -19,6 +26,7 @@
 #include <libasr/codegen/asr_to_x86.h>
 #include <libasr/codegen/asr_to_wasm.h>
 #include <lfortran/ast_to_src.h>
+#include <lfortran/ast_serialization.h>
 #include <lfortran/fortran_evaluator.h>
 #include <libasr/codegen/evaluator.h>
 #include <libasr/pass/pass_manager.h>
@@ -56,6 +64,14 @@
     #include <emscripten/emscripten.h>
 #endif
 
+#ifdef _WIN32
+    #include <process.h>
+#else
+    #include <spawn.h>
+    #include <sys/wait.h>
+    extern char **environ;
+#endif
+
 extern std::string lcompilers_unique_ID;
 
 namespace {
@@ -68,8 +84,9 @@ enum Backend {
 };
 
 std::string get_unique_ID() {
-    static std::random_device dev;
-    static std::mt19937 rng(dev());
+    // Files are compiled in parallel with `-j`
+    static thread_local std::random_device dev;
+    static thread_local std::mt19937 rng(dev());
     std::uniform_int_distribution<int> dist(0, 61);
     const std::string v =
         "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789";
@@ -98,6 +115,31 @@ std::string read_file(const std::string &filename)
 
 #ifdef HAVE_LFORTRAN_LLVM
 
+// Runs the program `args[0]` (looked up in PATH) with the arguments `args`,
+// without a shell, so that they need no quoting. Returns 0 on success.
+int run_program(const std::vector<std::string> &args)
+{
+    std::vector<char*> argv;
+    for (auto &arg : args) {
+        argv.push_back(const_cast<char*>(arg.c_str()));
+    }
+    argv.push_back(nullptr);
+#ifdef _WIN32
+    return _spawnvp(_P_WAIT, argv[0], argv.data()) == 0 ? 0 : 1;
+#else
+    pid_t pid;
+    if (posix_spawnp(&pid, argv[0], nullptr, nullptr, argv.data(),
+            environ) != 0) {
+        return 1;
+    }
+    int status;
+    if (waitpid(pid, &status, 0) == -1) {
+        return 1;
+    }
+    return WIFEXITED(status) ? WEXITSTATUS(status) : 1;
+#endif
+}
+
 void section(const std::string &s)
 {
     std::cout << color(LCompilers::style::bold) << color(LCompilers::fg::blue) << s << color(LCompilers::style::reset) << color(LCompilers::fg::reset) << std::endl;
@@ -788,6 +830,21 @@ int dump_all_passes(const std::string &infile, CompilerOptions &compiler_options
     return 0;
 }
 
+// Writes `path` as a new file that is renamed over the old one, so that the
+// old file stays intact for anyone who still has it mapped (modfiles are
+// read using LCompilers::map_file())
+void replace_file(const std::filesystem::path &path, const std::string &text)
+{
+    std::filesystem::path tmp = path;
+    tmp += "." + get_unique_ID() + ".tmp";
+    {
+        std::ofstream out;
+        out.open(tmp, std::ofstream::out | std::ofstream::binary);
+        out << text;
+    }
+    std::filesystem::rename(tmp, path);
+}
+
 int save_mod_files(const LCompilers::ASR::TranslationUnit_t &u,
     const LCompilers::CompilerOptions &compiler_options)
 {
@@ -814,7 +871,8 @@ int save_mod_files(const LCompilers::ASR::TranslationUnit_t &u,
             LCompilers::diag::Diagnostics diagnostics;
             LCOMPILERS_ASSERT(LCompilers::asr_verify(*tu, true, diagnostics));
 
-            std::string modfile_binary = LCompilers::save_modfile(*tu);
+            std::string modfile_binary = LCompilers::save_modfile(*tu,
+                &compiler_options.po);
 
             m->m_symtab->parent = orig_symtab;
 
@@ -822,11 +880,7 @@ int save_mod_files(const LCompilers::ASR::TranslationUnit_t &u,
 
 	    std::filesystem::path filename { std::string(m->m_name) + ".mod" };
             std::filesystem::path fullpath = compiler_options.po.mod_files_dir / filename;
-            {
-                std::ofstream out;
-		out.open(fullpath, std::ofstream::out | std::ofstream::binary);
-                out << modfile_binary;
-            }
+            replace_file(fullpath, modfile_binary);
         }
     }
     return 0;
@@ -886,43 +940,274 @@ int emit_asm(const std::string &infile, CompilerOptions &compiler_options)
     }
 }
 
-int compile_to_object_file(const std::string &infile,
-        const std::string &outfile,
-        bool assembly,
-        CompilerOptions &compiler_options,
-        LCompilers::PassManager& lpm)
+// Modules defined and used by one source file
+struct SourceModuleDeps {
+    std::vector<std::string> modules;
+    std::vector<std::string> uses;
+};
+
+class ModuleDepsVisitor : public LCompilers::LFortran::AST::BaseWalkVisitor<ModuleDepsVisitor>
 {
-    std::string input = read_file(infile);
+public:
+    SourceModuleDeps &deps;
 
-    LCompilers::FortranEvaluator fe(compiler_options);
-    LCompilers::ASR::TranslationUnit_t* asr;
+    ModuleDepsVisitor(SourceModuleDeps &deps) : deps{deps} {}
 
+    void visit_Module(const LCompilers::LFortran::AST::Module_t &x) {
+        deps.modules.push_back(LCompilers::to_lower(x.m_name));
+        BaseWalkVisitor::visit_Module(x);
+    }
 
-    // Src -> AST -> ASR
+    void visit_Submodule(const LCompilers::LFortran::AST::Submodule_t &x) {
+        // A submodule needs the modfile of its ancestor module
+        deps.uses.push_back(LCompilers::to_lower(x.m_id));
+        BaseWalkVisitor::visit_Submodule(x);
+    }
+
+    void visit_Use(const LCompilers::LFortran::AST::Use_t &x) {
+        deps.uses.push_back(LCompilers::to_lower(x.m_module));
+    }
+};
+
+// The compiler options that can change the object file or the modfiles
+// generated from a given AST
+std::string get_cache_options_key(const CompilerOptions &co)
+{
+    std::stringstream ss;
+    // The values are separated and the strings prefixed by their length, so
+    // that different options cannot give the same key
+    ss << co.po.default_integer_kind << ";" << co.po.fast << ";"
+        << co.po.realloc_lhs << ";" << co.po.use_loop_variable_after_loop << ";"
+        << co.po.module_name_mangling << ";" << co.po.global_symbols_mangling
+        << ";" << co.po.intrinsic_symbols_mangling << ";"
+        << co.po.all_symbols_mangling << ";" << co.po.bindc_mangling << ";"
+        << co.po.fortran_mangling << ";" << co.po.mangle_underscore << ";"
+        << co.po.openmp << ";" << co.disable_main << ";" << co.symtab_only
+        << ";" << co.logical_casting << ";" << co.enable_bounds_checking << ";"
+        << co.implicit_typing << ";" << co.implicit_interface << ";"
+        << co.implicit_argument_casting << ";" << co.print_leading_space << ";"
+        << co.rtlib << ";" << co.legacy_array_sections << ";"
+        << co.ignore_pragma << ";" << co.stack_arrays << ";" << co.openmp << ";"
+        << co.generate_object_code << ";" << co.emit_debug_info << ";"
+        << co.emit_debug_line_column << ";" << co.opt_level << ";"
+        << co.opt_size_level << ";" << co.target.size() << ":" << co.target
+        << ";" << co.po.runtime_library_dir.size() << ":"
+        << co.po.runtime_library_dir;
+    return ss.str();
+}
+
+/*
+    Returns the key of the compilation cache entry for the file `infile`
+    parsed into `ast`: a hash of the AST (so of the preprocessed source,
+    including the included files), of the compiler options and of the modules
+    used by the file.
+
+    For a used module normally only its interface hash is taken, so that
+    changes to the bodies of its procedures do not invalidate the file. When
+    the bodies can end up in the object file (without
+    `--generate-object-code` the main program is compiled together with all
+    the modules it uses; with `--fast` procedures get inlined), the module
+    hash is taken instead.
+*/
+std::string get_compilation_cache_key(const std::string &infile,
+        LCompilers::LFortran::AST::TranslationUnit_t &ast,
+        const CompilerOptions &compiler_options)
+{
+    uint64_t h = LCompilers::string_hash(LFORTRAN_VERSION);
+    h = LCompilers::string_hash(LCompilers::LFortran::serialize(ast), h);
+    h = LCompilers::string_hash(get_cache_options_key(compiler_options), h);
+    if (compiler_options.emit_debug_info) {
+        h = LCompilers::string_hash(infile, h);
+    }
+
+    SourceModuleDeps deps;
+    ModuleDepsVisitor v(deps);
+    v.visit_TranslationUnit(ast);
+    std::set<std::string> uses(deps.uses.begin(), deps.uses.end());
+    bool use_module_hash = !compiler_options.generate_object_code
+        || compiler_options.po.fast;
+    for (auto &u : uses) {
+        if (std::find(deps.modules.begin(), deps.modules.end(), u)
+                != deps.modules.end()) continue;
+        h = LCompilers::string_hash(u, h);
+        std::shared_ptr<const LCompilers::MappedFile> modfile
+            = LCompilers::ASRUtils::find_modfile(u, compiler_options.po);
+        if (!modfile) {
+            modfile = LCompilers::ASRUtils::find_modfile(
+                "lfortran_intrinsic_" + u, compiler_options.po);
+        }
+        if (modfile) {
+            std::shared_ptr<const LCompilers::Modfile> parsed
+                = LCompilers::get_modfile(modfile);
+            const std::string &interface_hash = parsed->interface_hash;
+            const std::string &module_hash = parsed->module_hash;
+            if (interface_hash.empty()) {
+                // Modfile without hashes, use its full contents
+                h = LCompilers::string_hash(modfile->view(), h);
+            } else {
+                h = LCompilers::string_hash(use_module_hash ? module_hash
+                    : interface_hash, h);
+            }
+        }
+    }
+    return LCompilers::hash_to_hex(h);
+}
+
+// If the compilation cache has the entry `key`, copies its object file to
+// `outfile` and its modfiles to the modfile directory and returns true
+bool load_from_compilation_cache(const std::string &key,
+        const std::string &outfile, const CompilerOptions &compiler_options)
+{
+    std::filesystem::path entry = std::filesystem::path(compiler_options.cache_dir) / key;
+    std::error_code ec;
+    if (!std::filesystem::exists(entry / "object.o", ec)) return false;
+    for (auto &f : std::filesystem::directory_iterator(entry, ec)) {
+        if (f.path().extension() == ".mod") {
+            // Replaced (not overwritten) like in replace_file()
+            std::filesystem::path modfile = compiler_options.po.mod_files_dir
+                / f.path().filename();
+            std::filesystem::path tmp = modfile;
+            tmp += "." + get_unique_ID() + ".tmp";
+            std::filesystem::copy_file(f.path(), tmp, ec);
+            if (ec) return false;
+            std::filesystem::rename(tmp, modfile, ec);
+            if (ec) return false;
+        }
+    }
+    if (ec) return false;
+    std::filesystem::copy_file(entry / "object.o", outfile,
+        std::filesystem::copy_options::overwrite_existing, ec);
+    return !ec;
+}
+
+// Stores `outfile` and the modfiles of `modules` as the entry `key` of the
+// compilation cache. Failures are ignored (the file is just not cached).
+void save_to_compilation_cache(const std::string &key,
+        const std::string &outfile, const std::vector<std::string> &modules,
+        const CompilerOptions &compiler_options)
+{
+    std::filesystem::path cache_dir = compiler_options.cache_dir;
+    std::filesystem::path entry = cache_dir / key;
+    std::error_code ec;
+    if (std::filesystem::exists(entry, ec)) return;
+    // Fill a temporary directory and rename it, so that other compiler
+    // processes sharing the cache never see an incomplete entry
+    std::filesystem::path tmp = cache_dir / (key + ".tmp." + get_unique_ID());
+    std::filesystem::create_directories(tmp, ec);
+    if (!ec) {
+        std::filesystem::copy_file(outfile, tmp / "object.o", ec);
+    }
+    for (auto &m : modules) {
+        if (ec) break;
+        std::filesystem::path modfile = compiler_options.po.mod_files_dir / (m + ".mod");
+        if (std::filesystem::exists(modfile, ec)) {
+            std::filesystem::copy_file(modfile, tmp / modfile.filename(), ec);
+        }
+    }
+    if (!ec) {
+        std::filesystem::rename(tmp, entry, ec);
+    }
+    if (ec) {
+        std::filesystem::remove_all(tmp, ec);
+    }
+}
+
+// A source file parsed into its AST, together with the FortranEvaluator that
+// owns the AST and compiles it further
+struct ParsedSource {
+    std::unique_ptr<LCompilers::FortranEvaluator> fe;
     LCompilers::LocationManager lm;
+    LCompilers::LFortran::AST::TranslationUnit_t* ast = nullptr;
+};
 
+int parse_source(const std::string &infile, CompilerOptions &compiler_options,
+        ParsedSource &parsed)
+{
+    // The AST does not point into the source, so it is not kept in memory
+    // for the rest of the compilation
+    std::string input = read_file(infile);
+    parsed.fe = std::make_unique<LCompilers::FortranEvaluator>(compiler_options);
     {
         LCompilers::LocationManager::FileLocations fl;
         fl.in_filename = infile;
-        lm.files.push_back(fl);
-        lm.file_ends.push_back(input.size());
+        parsed.lm.files.push_back(fl);
+        parsed.lm.file_ends.push_back(input.size());
     }
     LCompilers::diag::Diagnostics diagnostics;
-    LCompilers::Result<LCompilers::ASR::TranslationUnit_t*>
-        result = fe.get_asr2(input, lm, diagnostics);
-    std::cerr << diagnostics.render(lm, compiler_options);
-    if (result.ok) {
-        asr = result.result;
-    } else {
+    LCompilers::Result<LCompilers::LFortran::AST::TranslationUnit_t*>
+        result = parsed.fe->get_ast2(input, parsed.lm, diagnostics);
+    std::cerr << diagnostics.render(parsed.lm, compiler_options);
+    if (!result.ok) {
         LCOMPILERS_ASSERT(diagnostics.has_error())
         return 1;
     }
+    parsed.ast = result.result;
+    return 0;
+}
+
+// `parsed` is the already parsed `infile`, or nullptr to parse it here
+int compile_to_object_file(const std::string &infile,
+        const std::string &outfile,
+        bool assembly,
+        CompilerOptions &compiler_options,
+        LCompilers::PassManager& lpm,
+        const std::function<void()> &mod_files_saved=nullptr,
+        ParsedSource *parsed=nullptr)
+{
+    // Number the symbol tables of every file from the start, also when a
+    // thread compiles several files
+    LCompilers::SymbolTable::reset_global_counter();
+
+    // Src -> AST -> ASR
+    ParsedSource source;
+    if (parsed == nullptr) {
+        int err = parse_source(infile, compiler_options, source);
+        if (err) return err;
+        parsed = &source;
+    }
+    LCompilers::FortranEvaluator &fe = *parsed->fe;
+    LCompilers::LocationManager &lm = parsed->lm;
+    LCompilers::LFortran::AST::TranslationUnit_t* ast = parsed->ast;
+    LCompilers::ASR::TranslationUnit_t* asr;
+    LCompilers::diag::Diagnostics diagnostics;
+
+    std::string cache_key;
+    if (compiler_options.cache_dir.size() > 0 && !assembly) {
+        cache_key = get_compilation_cache_key(infile, *ast, compiler_options);
+        if (load_from_compilation_cache(cache_key, outfile, compiler_options)) {
+            if (mod_files_saved) mod_files_saved();
+            return 0;
+        }
+    }
+
+    {
+        diagnostics.diagnostics.clear();
+        LCompilers::Result<LCompilers::ASR::TranslationUnit_t*>
+            result = fe.get_asr3(*ast, diagnostics);
+        std::cerr << diagnostics.render(lm, compiler_options);
+        if (result.ok) {
+            asr = result.result;
+        } else {
+            LCOMPILERS_ASSERT(diagnostics.has_error())
+            return 1;
+        }
+    }
 
     // Save .mod files
     {
         int err = save_mod_files(*asr, compiler_options);
         if (err) return err;
     }
+    if (mod_files_saved) mod_files_saved();
+
+    std::vector<std::string> modules;
+    for (auto &item : asr->m_symtab->get_scope()) {
+        if (LCompilers::ASR::is_a<LCompilers::ASR::Module_t>(*item.second)
+                && !LCompilers::ASR::down_cast<LCompilers::ASR::Module_t>(
+                    item.second)->m_loaded_from_mod) {
+            modules.push_back(item.first);
+        }
+    }
 
     // ASR -> LLVM
     LCompilers::LLVMEvaluator e(compiler_options.target);
@@ -932,6 +1217,10 @@ int compile_to_object_file(const std::string &infile,
         // Create an empty object file (things will be actually
         // compiled and linked when the main program is present):
         e.create_empty_object_file(outfile);
+        if (cache_key.size() > 0) {
+            save_to_compilation_cache(cache_key, outfile, modules,
+                compiler_options);
+        }
         return 0;
     }
 
@@ -960,15 +1249,56 @@ int compile_to_object_file(const std::string &infile,
         return 5;
     }
 
-    if (compiler_options.po.fast) {
-        e.opt(*m->m_m);
+    // `--fast` implies at least -O3
+    int opt_level = compiler_options.po.fast
+        ? std::max(compiler_options.opt_level, 3) : compiler_options.opt_level;
+    bool parallel_codegen = compiler_options.codegen_units > 1 && !assembly;
+#ifdef _WIN32
+    // The object files of the parts cannot be merged with `ld -r`
+    parallel_codegen = false;
+#else
+    // The parts are merged with the host `ld`, which cannot link object
+    // files of another target
+    if (compiler_options.target != "" && compiler_options.target
+            != LCompilers::LLVMEvaluator::get_default_target_triple()) {
+        parallel_codegen = false;
+    }
+#endif
+    if ((opt_level > 0 || compiler_options.opt_size_level > 0)
+            && !parallel_codegen) {
+        e.opt(*m->m_m, opt_level, compiler_options.opt_size_level);
     }
 
     // LLVM -> Machine code (saves to an object file)
     if (assembly) {
         e.save_asm_file(*(m->m_m), outfile);
     } else {
-        e.save_object_file(*(m->m_m), outfile);
+        if (parallel_codegen) {
+            std::vector<std::string> parts = e.save_object_files_parallel(
+                *m->m_m, outfile, compiler_options.codegen_units, opt_level,
+                compiler_options.opt_size_level);
+            // Merge the object files of the parts into `outfile`
+            std::vector<std::string> args = {"ld", "-r", "-o", outfile};
+            args.insert(args.end(), parts.begin(), parts.end());
+            int err = run_program(args);
+            for (auto &part : parts) {
+                std::filesystem::remove(part);
+            }
+            if (err) {
+                std::string cmd;
+                for (auto &arg : args) {
+                    cmd += (cmd.empty() ? "" : " ") + arg;
+                }
+                std::cout << "The command '" + cmd + "' failed." << std::endl;
+                return 10;
+            }
+        } else {
+            e.save_object_file(*(m->m_m), outfile);
+        }
+        if (cache_key.size() > 0) {
+            save_to_compilation_cache(cache_key, outfile, modules,
+                compiler_options);
+        }
     }
 
     return 0;
@@ -980,6 +1310,186 @@ int compile_to_assembly_file(const std::string &infile,
 {
     return compile_to_object_file(infile, outfile, true, compiler_options, lpm);
 }
+
+// Parses `infile` into `parsed` and collects its module dependencies
+int get_source_module_deps(const std::string &infile,
+        CompilerOptions &compiler_options, SourceModuleDeps &deps,
+        ParsedSource &parsed)
+{
+    if (parse_source(infile, compiler_options, parsed)) {
+        return 2;
+    }
+    ModuleDepsVisitor v(deps);
+    v.visit_TranslationUnit(*parsed.ast);
+    return 0;
+}
+
+/*
+    Compiles `infiles[i]` into the object file `outfiles[i]` using up to
+    `n_jobs` threads. The module dependencies between the files are collected
+    from their `use` statements; a file is only started once the modfiles of
+    all the modules it uses from the other files have been written. Every file
+    is compiled by its own FortranEvaluator and LLVMEvaluator (and thus its own
+    Allocator and LLVMContext). The ASTs from collecting the dependencies are
+    kept until the files are compiled, so that every file is parsed once.
+*/
+int compile_to_object_files_parallel(const std::vector<std::string> &infiles,
+        const std::vector<std::string> &outfiles,
+        std::vector<CompilerOptions> &compiler_options, size_t n_jobs,
+        LCompilers::PassManager& lpm)
+{
+    size_t n = infiles.size();
+    n_jobs = std::max<size_t>(1, std::min(n_jobs, n));
+
+    // Initialize the LLVM targets once, before any of the threads does
+    {
+        LCompilers::LLVMEvaluator e(compiler_options[0].target);
+    }
+
+    auto run_parallel = [&](const std::function<void()> &worker) {
+        std::vector<std::thread> threads;
+        for (size_t j = 1; j < n_jobs; j++) {
+            threads.emplace_back(worker);
+        }
+        worker();
+        for (auto &t : threads) {
+            t.join();
+        }
+    };
+
+    // Source -> AST, to collect the module dependencies
+    std::vector<SourceModuleDeps> deps(n);
+    std::vector<ParsedSource> parsed(n);
+    std::vector<int> errs(n, 0);
+    {
+        std::mutex mtx;
+        size_t next = 0;
+        run_parallel([&]() {
+            while (true) {
+                size_t i;
+                {
+                    std::lock_guard<std::mutex> lock(mtx);
+                    if (next == n) return;
+                    i = next++;
+                }
+                errs[i] = get_source_module_deps(infiles[i],
+                    compiler_options[i], deps[i], parsed[i]);
+            }
+        });
+        for (size_t i = 0; i < n; i++) {
+            if (errs[i]) return errs[i];
+        }
+    }
+
+    // Build the dependency graph between the files
+    std::map<std::string, size_t> module_file;
+    for (size_t i = 0; i < n; i++) {
+        for (auto &m : deps[i].modules) {
+            if (module_file.find(m) != module_file.end()
+                    && module_file[m] != i) {
+                std::cerr << "The module `" << m << "` is defined in both `"
+                    << infiles[module_file[m]] << "` and `" << infiles[i]
+                    << "`" << std::endl;
+                return 1;
+            }
+            module_file[m] = i;
+        }
+    }
+    std::vector<std::vector<size_t>> dependents(n);
+    std::vector<size_t> n_pending(n, 0);
+    for (size_t i = 0; i < n; i++) {
+        std::set<size_t> used_files;
+        for (auto &u : deps[i].uses) {
+            // Modules that are not defined in any of the files (intrinsic
+            // or precompiled modules) are found by the usual modfile lookup
+            auto it = module_file.find(u);
+            if (it != module_file.end() && it->second != i) {
+                used_files.insert(it->second);
+            }
+        }
+        for (size_t d : used_files) {
+            dependents[d].push_back(i);
+        }
+        n_pending[i] = used_files.size();
+    }
+    {
+        // Check for cycles (Kahn's algorithm)
+        std::vector<size_t> pending = n_pending;
+        std::vector<size_t> stack;
+        size_t n_visited = 0;
+        for (size_t i = 0; i < n; i++) {
+            if (pending[i] == 0) stack.push_back(i);
+        }
+        while (!stack.empty()) {
+            size_t i = stack.back();
+            stack.pop_back();
+            n_visited++;
+            for (size_t d : dependents[i]) {
+                if (--pending[d] == 0) stack.push_back(d);
+            }
+        }
+        if (n_visited != n) {
+            std::cerr << "Circular module dependency between the source files:";
+            for (size_t i = 0; i < n; i++) {
+                if (pending[i] > 0) std::cerr << " " << infiles[i];
+            }
+            std::cerr << std::endl;
+            return 1;
+        }
+    }
+
+    // AST -> ASR -> LLVM -> object file, in dependency order
+    std::mutex mtx;
+    std::condition_variable cv;
+    std::deque<size_t> ready;
+    std::vector<bool> released(n, false);
+    size_t n_started = 0;
+    int err = 0;
+    for (size_t i = 0; i < n; i++) {
+        if (n_pending[i] == 0) ready.push_back(i);
+    }
+    // Must be called with `mtx` locked
+    auto release_dependents = [&](size_t i) {
+        if (released[i]) return;
+        released[i] = true;
+        for (size_t d : dependents[i]) {
+            if (--n_pending[d] == 0) ready.push_back(d);
+        }
+        cv.notify_all();
+    };
+    run_parallel([&]() {
+        while (true) {
+            size_t i;
+            {
+                std::unique_lock<std::mutex> lock(mtx);
+                cv.wait(lock, [&]() {
+                    return err != 0 || n_started == n || !ready.empty();
+                });
+                if (err != 0 || ready.empty()) return;
+                i = ready.front();
+                ready.pop_front();
+                n_started++;
+                if (n_started == n) cv.notify_all();
+            }
+            LCompilers::PassManager file_lpm = lpm;
+            int file_err = compile_to_object_file(infiles[i], outfiles[i],
+                false, compiler_options[i], file_lpm, [&, i]() {
+                    std::lock_guard<std::mutex> lock(mtx);
+                    release_dependents(i);
+                }, &parsed[i]);
+            // Free the AST and ASR of the file
+            parsed[i].fe.reset();
+            std::lock_guard<std::mutex> lock(mtx);
+            if (file_err) {
+                if (err == 0) err = file_err;
+                cv.notify_all();
+            } else {
+                release_dependents(i);
+            }
+        }
+    });
+    return err;
+}
 #endif // HAVE_LFORTRAN_LLVM
 
 
@@ -1642,7 +2152,7 @@ int link_executable(const std::vector<std::string> &infiles,
             if (!extra_linker_flags.empty()) {
                 compile_cmd += extra_linker_flags;
             }
-            compile_cmd += " -l" + runtime_lib + " -lm";
+            compile_cmd += " -l" + runtime_lib + " -lm -lpthread";
             if (compiler_options.openmp) {
                 std::string openmp_shared_library = compiler_options.openmp_lib_dir;
                 std::string omp_cmd =  " -L" + openmp_shared_library + " -Wl,-rpath," + openmp_shared_library + " -lomp";
@@ -1702,7 +2212,7 @@ int link_executable(const std::vector<std::string> &infiles,
         if (!extra_linker_flags.empty()) {
             cmd += extra_linker_flags;
         }
-        cmd += " -l" + runtime_lib + " -lm";
+        cmd += " -l" + runtime_lib + " -lm -lpthread";
         if (verbose) {
             std::cout << cmd << std::endl;
         }
@@ -1765,7 +2275,7 @@ int link_executable(const std::vector<std::string> &infiles,
         }
         cmd += " -L" + base_path
             + " -Wl,-rpath," + base_path;
-        cmd += " -l" + runtime_lib + " -lm";
+        cmd += " -l" + runtime_lib + " -lm -lpthread";
         if (verbose) {
             std::cout << cmd << std::endl;
         }
@@ -2014,6 +2524,7 @@ int main_app(int argc, char *argv[]) {
     std::vector<std::string> linker_flags;
     std::vector<std::string> f_flags;
     std::vector<std::string> O_flags;
+    size_t arg_jobs = 1;
 
     CompilerOptions compiler_options;
     compiler_options.po.runtime_library_dir = LCompilers::LFortran::get_runtime_library_dir();
@@ -2041,7 +2552,7 @@ int main_app(int argc, char *argv[]) {
     app.add_flag("--version", arg_version, "Display compiler version information");
     app.add_option("-W", linker_flags, "Linker flags")->allow_extra_args(false);
     app.add_option("-f", f_flags, "All `-f*` flags (only -fPIC supported for now)")->allow_extra_args(false);
-    app.add_option("-O", O_flags, "Optimization level (ignored for now)")->allow_extra_args(false);
+    app.add_option("-O", O_flags, "Optimization level (0, 1, 2, 3, s, z, fast)")->allow_extra_args(false);
 
     // LFortran specific options
     app.add_flag("--cpp", cpp, "Enable C preprocessing");
@@ -2074,7 +2585,12 @@ int main_app(int argc, char *argv[]) {
     app.add_flag("--show-fortran", show_fortran, "Show Fortran translation source for the given file and exit");
     app.add_flag("--show-stacktrace", compiler_options.show_stacktrace, "Show internal stacktrace on compiler errors");
     app.add_flag("--symtab-only", compiler_options.symtab_only, "Only create symbol tables in ASR (skip executable stmt)");
-    app.add_flag("--time-report", time_report, "Show compilation time report");
+    app.add_flag("--time-report", time_report, "Show compilation time report (including the time, ASR size and memory of each ASR pass)");
+    app.add_flag("--time-report-json", compiler_options.po.time_report_json, "Print the report of the ASR passes of --time-report as JSON");
+    app.add_option("-j,--jobs", arg_jobs, "Number of source files to compile in parallel")->capture_default_str();
+    app.add_option("--codegen-units", compiler_options.codegen_units, "Number of parts the LLVM module of a file is split into, which are optimized and compiled in parallel (procedures are not inlined across the parts)")->capture_default_str();
+    app.add_option("--parse-jobs", compiler_options.parse_jobs, "Number of threads that parse the program units of a free-form source file")->capture_default_str();
+    app.add_option("--cache-dir", compiler_options.cache_dir, "Directory of the compilation cache (ASTs, object files and modfiles of unchanged sources are reused)");
     app.add_flag("--static", static_link, "Create a static executable");
     app.add_flag("--shared", shared_link, "Create a shared executable");
     app.add_flag("--logical-casting", compiler_options.logical_casting, "Allow logical casting");
@@ -2197,11 +2713,33 @@ int main_app(int argc, char *argv[]) {
         return 1;
     }
 
+    for (auto &o : O_flags) {
+        if (o == "0" || o == "1" || o == "2" || o == "3") {
+            compiler_options.opt_level = std::stoi(o);
+            compiler_options.opt_size_level = 0;
+        } else if (o == "s") {
+            compiler_options.opt_level = 2;
+            compiler_options.opt_size_level = 1;
+        } else if (o == "z") {
+            compiler_options.opt_level = 2;
+            compiler_options.opt_size_level = 2;
+        } else if (o == "fast") {
+            compiler_options.opt_level = 3;
+            compiler_options.opt_size_level = 0;
+            compiler_options.po.fast = true;
+        } else {
+            std::cerr << "The option `-O" << o << "` is not supported" << std::endl;
+            return 1;
+        }
+    }
+
     compiler_options.use_colors = !arg_no_color;
     compiler_options.indent = !arg_no_indent;
     compiler_options.prescan = !arg_no_prescan;
     // set openmp in pass options
     compiler_options.po.openmp = compiler_options.openmp;
+    compiler_options.po.time_report = time_report
+        || compiler_options.po.time_report_json;
 
     for (auto &f_flag : f_flags) {
         if (f_flag == "PIC") {
@@ -2279,31 +2817,48 @@ int main_app(int argc, char *argv[]) {
 #endif
     }
 
-    // TODO: for now we ignore the other filenames, only handle
-    // the first:
+    // Fortran source files; the other files are passed to the linker
+    std::vector<std::string> fortran_files;
+    std::vector<std::string> other_files;
+    for (auto &f : arg_files) {
+        if (endswith(f, ".f90") || endswith(f, ".f") || endswith(f, ".F90") || endswith(f, ".F")) {
+            fortran_files.push_back(f);
+        } else {
+            other_files.push_back(f);
+        }
+    }
+
+    // Except for the multi-file compilation below, we only handle the
+    // first file for now
     std::string arg_file = arg_files[0];
     if (CLI::NonexistentPath(arg_file).empty())
         throw LCompilers::LCompilersException("File does not exist: " + arg_file);
 
-    // Decide if a file is fixed format based on the extension
-    // Gfortran does the same thing
-    if (fixed_form_infer && endswith(arg_file, ".f")) {
-        compiler_options.fixed_form = true;
-    }
-
     if (cpp && no_cpp) {
         throw LCompilers::LCompilersException("Cannot use --cpp and --no-cpp at the same time");
-    } else if(cpp) {
-        compiler_options.c_preprocessor = true;
-    } else if(no_cpp) {
-        compiler_options.c_preprocessor = false;
-    // Decide if a file gets preprocessing based on the extension
-    // Gfortran does the same thing
-    } else if (cpp_infer && (endswith(arg_file, ".F90") || endswith(arg_file, ".F"))) {
-        compiler_options.c_preprocessor = true;
-    } else {
-        compiler_options.c_preprocessor = false;
     }
+    auto set_source_file_options = [&](CompilerOptions &options,
+            const std::string &file) {
+        // Decide if a file is fixed format based on the extension
+        // Gfortran does the same thing
+        if (fixed_form_infer && endswith(file, ".f")) {
+            options.fixed_form = true;
+        }
+
+        if(cpp) {
+            options.c_preprocessor = true;
+        } else if(no_cpp) {
+            options.c_preprocessor = false;
+        // Decide if a file gets preprocessing based on the extension
+        // Gfortran does the same thing
+        } else if (cpp_infer && (endswith(file, ".F90") || endswith(file, ".F"))) {
+            options.c_preprocessor = true;
+        } else {
+            options.c_preprocessor = false;
+        }
+    };
+    CompilerOptions common_compiler_options = compiler_options;
+    set_source_file_options(compiler_options, arg_file);
 
     std::string outfile;
     std::filesystem::path basename = std::filesystem::path(arg_file).filename();
@@ -2404,6 +2959,42 @@ int main_app(int argc, char *argv[]) {
             LCOMPILERS_ASSERT(false);
         }
     }
+#ifdef HAVE_LFORTRAN_LLVM
+    if (backend == Backend::llvm && fortran_files.size() > 1) {
+        if (arg_c && compiler_options.arg_o.size() > 0) {
+            std::cerr << "Cannot specify -o with -c and multiple files" << std::endl;
+            return 1;
+        }
+        if (arg_jobs < 1) {
+            std::cerr << "The number of jobs must be at least 1" << std::endl;
+            return 1;
+        }
+        std::vector<CompilerOptions> file_options;
+        std::vector<std::string> object_files;
+        for (size_t i = 0; i < fortran_files.size(); i++) {
+            if (CLI::NonexistentPath(fortran_files[i]).empty())
+                throw LCompilers::LCompilersException("File does not exist: " + fortran_files[i]);
+            file_options.push_back(common_compiler_options);
+            set_source_file_options(file_options.back(), fortran_files[i]);
+            if (arg_c) {
+                object_files.push_back(std::filesystem::path(fortran_files[i])
+                    .filename().replace_extension(".o").string());
+            } else {
+                object_files.push_back(outfile + "." + std::to_string(i) + ".tmp.o");
+            }
+        }
+        int err = compile_to_object_files_parallel(fortran_files, object_files,
+            file_options, arg_jobs, lfortran_pass_manager);
+        if (err) return err;
+        if (arg_c) return 0;
+        object_files.insert(object_files.end(), other_files.begin(),
+            other_files.end());
+        return link_executable(object_files, outfile, runtime_library_dir,
+                backend, static_link, shared_link, link_with_gcc, true, arg_v, arg_L,
+		arg_l, linker_flags, compiler_options);
+    }
+#endif
+
     if (arg_c) {
         if (backend == Backend::llvm) {
 #ifdef HAVE_LFORTRAN_LLVM
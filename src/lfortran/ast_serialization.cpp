@@ -1,4 +1,8 @@
 #include <string>
+#include <cctype>
+#include <sstream>
+#include <filesystem>
+#include <fstream>
 
 #include <libasr/config.h>
 #include <lfortran/ast_serialization.h>
@@ -52,7 +56,7 @@ class ASTDeserializationVisitor :
     public AST::DeserializationBaseVisitor<ASTDeserializationVisitor>
 {
 public:
-    ASTDeserializationVisitor(Allocator &al, const std::string &s) :
+    ASTDeserializationVisitor(Allocator &al, std::string_view s) :
 #ifdef WITH_LFORTRAN_BINARY_MODFILES
         BinaryReader(s),
 #else
@@ -74,10 +78,150 @@ public:
     }
 };
 
-AST::ast_t* deserialize_ast(Allocator &al, const std::string &s) {
+AST::ast_t* deserialize_ast(Allocator &al, std::string_view s) {
     ASTDeserializationVisitor v(al, s);
     return v.deserialize_node();
 }
 
+const std::string lfortran_ast_cache_type_string = "LFortran AST cache";
+
+#ifdef WITH_LFORTRAN_BINARY_MODFILES
+typedef BinaryWriter ASTCacheWriter;
+typedef BinaryReader ASTCacheReader;
+#else
+typedef TextWriter ASTCacheWriter;
+typedef TextReader ASTCacheReader;
+#endif
+
+// Conservatively returns true if `s` might make the preprocessor or the
+// prescanner read another file (`#include` or an `include` line, in any case)
+bool may_include_files(std::string_view s) {
+    const std::string_view include = "include";
+    for (size_t i = 0; i + include.size() <= s.size(); i++) {
+        size_t j = 0;
+        while (j < include.size()
+                && std::tolower((unsigned char)s[i+j]) == include[j]) j++;
+        if (j == include.size()) return true;
+    }
+    return false;
+}
+
+std::string get_ast_cache_key(const std::string &input,
+        const std::string &filename, const CompilerOptions &compiler_options)
+{
+    if (may_include_files(input)) return "";
+    std::stringstream ss;
+    ss << compiler_options.fixed_form << compiler_options.interactive
+        << compiler_options.c_preprocessor << compiler_options.prescan;
+    if (compiler_options.c_preprocessor) {
+        // The predefined macros depend on the platform and `__FILE__`
+        // expands to the filename
+        ss << ";" << (int)compiler_options.platform << ";" << filename;
+        for (auto &d : compiler_options.c_preprocessor_defines) {
+            if (may_include_files(d)) return "";
+            ss << ";" << d.size() << ":" << d;
+        }
+    }
+    uint64_t h = string_hash(LFORTRAN_VERSION);
+    h = string_hash(ss.str(), h);
+    h = string_hash(input, h);
+    return hash_to_hex(h);
+}
+
+void write_vector(ASTCacheWriter &b, const std::vector<uint32_t> &v) {
+    b.write_int64(v.size());
+    for (auto &x : v) b.write_int32(x);
+}
+
+void read_vector(ASTCacheReader &b, std::vector<uint32_t> &v) {
+    size_t n = b.read_int64();
+    v.clear();
+    for (size_t i = 0; i < n; i++) v.push_back(b.read_int32());
+}
+
+AST::TranslationUnit_t* load_from_ast_cache(Allocator &al,
+        const std::string &cache_dir, const std::string &key,
+        size_t input_size, LocationManager::FileLocations &fl)
+{
+    std::string entry;
+    std::filesystem::path path = std::filesystem::path(cache_dir) / "ast" / key;
+    std::error_code ec;
+    if (!std::filesystem::exists(path, ec)) return nullptr;
+    if (!read_file(path.string(), entry)) return nullptr;
+    LocationManager::FileLocations fl2;
+    AST::ast_t *ast;
+    try {
+        ASTCacheReader b(entry);
+        if (b.read_string() != lfortran_ast_cache_type_string) return nullptr;
+        if (b.read_string() != LFORTRAN_VERSION) return nullptr;
+        // Guards against hash collisions
+        if (b.read_int64() != input_size) return nullptr;
+        read_vector(b, fl2.out_start);
+        read_vector(b, fl2.in_start);
+        read_vector(b, fl2.in_newlines);
+        fl2.preprocessor = b.read_int8();
+        read_vector(b, fl2.out_start0);
+        read_vector(b, fl2.in_start0);
+        read_vector(b, fl2.in_size0);
+        read_vector(b, fl2.interval_type0);
+        read_vector(b, fl2.in_newlines0);
+        ast = deserialize_ast(al, b.read_string_view());
+    } catch (const LCompilersException &) {
+        // Truncated or otherwise corrupted entry
+        return nullptr;
+    }
+    if (!AST::is_a<AST::unit_t>(*ast)) return nullptr;
+    fl.out_start = std::move(fl2.out_start);
+    fl.in_start = std::move(fl2.in_start);
+    fl.in_newlines = std::move(fl2.in_newlines);
+    fl.preprocessor = fl2.preprocessor;
+    fl.out_start0 = std::move(fl2.out_start0);
+    fl.in_start0 = std::move(fl2.in_start0);
+    fl.in_size0 = std::move(fl2.in_size0);
+    fl.interval_type0 = std::move(fl2.interval_type0);
+    fl.in_newlines0 = std::move(fl2.in_newlines0);
+    return AST::down_cast2<AST::TranslationUnit_t>(ast);
+}
+
+void save_to_ast_cache(const std::string &cache_dir,
+        const std::string &key, size_t input_size,
+        const AST::TranslationUnit_t &ast,
+        const LocationManager::FileLocations &fl)
+{
+    ASTCacheWriter b;
+    b.write_string(lfortran_ast_cache_type_string);
+    b.write_string(LFORTRAN_VERSION);
+    b.write_int64(input_size);
+    write_vector(b, fl.out_start);
+    write_vector(b, fl.in_start);
+    write_vector(b, fl.in_newlines);
+    b.write_int8(fl.preprocessor);
+    write_vector(b, fl.out_start0);
+    write_vector(b, fl.in_start0);
+    write_vector(b, fl.in_size0);
+    write_vector(b, fl.interval_type0);
+    write_vector(b, fl.in_newlines0);
+    b.write_string(serialize(ast));
+
+    std::filesystem::path dir = std::filesystem::path(cache_dir) / "ast";
+    std::error_code ec;
+    std::filesystem::create_directories(dir, ec);
+    if (ec) return;
+    // Written to a temporary file and renamed, so that other compiler
+    // processes sharing the cache never see an incomplete entry
+    std::filesystem::path tmp = dir / (key + ".tmp." + get_unique_ID());
+    {
+        std::ofstream out(tmp, std::ofstream::out | std::ofstream::binary);
+        out << b.get_str();
+        if (!out) ec = std::make_error_code(std::errc::io_error);
+    }
+    if (!ec) {
+        std::filesystem::rename(tmp, dir / key, ec);
+    }
+    if (ec) {
+        std::filesystem::remove(tmp, ec);
+    }
+}
+
 
 } // namespace LCompilers::LFortran
@@ -1,14 +1,40 @@
 #ifndef LFORTRAN_SERIALIZATION_H
 #define LFORTRAN_SERIALIZATION_H
 
+#include <string_view>
+
 #include <lfortran/ast.h>
 #include <libasr/asr.h>
+#include <libasr/location.h>
+#include <libasr/utils.h>
 
 namespace LCompilers::LFortran {
 
     std::string serialize(const AST::ast_t &ast);
     std::string serialize(const AST::TranslationUnit_t &unit);
-    AST::ast_t* deserialize_ast(Allocator &al, const std::string &s);
+    AST::ast_t* deserialize_ast(Allocator &al, std::string_view s);
+
+    // The AST cache stores the parsed ASTs of source files in the
+    // subdirectory `ast` of the compilation cache (`cache_dir`), together
+    // with the location maps of the file, so that unchanged files do not
+    // have to be preprocessed and parsed again.
+
+    // Returns the key of the AST cache entry of the source `input` of the
+    // file `filename`, or an empty string if the file cannot be cached (it
+    // might include other files)
+    std::string get_ast_cache_key(const std::string &input,
+        const std::string &filename, const CompilerOptions &compiler_options);
+    // Returns the AST of the entry `key` and fills in the location maps of
+    // `fl`, or returns nullptr if the cache does not have a valid entry
+    AST::TranslationUnit_t* load_from_ast_cache(Allocator &al,
+        const std::string &cache_dir, const std::string &key,
+        size_t input_size, LocationManager::FileLocations &fl);
+    // Stores `ast` and the location maps of `fl` as the entry `key`.
+    // Failures are ignored (the file is just not cached).
+    void save_to_ast_cache(const std::string &cache_dir,
+        const std::string &key, size_t input_size,
+        const AST::TranslationUnit_t &ast,
+        const LocationManager::FileLocations &fl);
 
 } // namespace LCompilers::LFortran
 
@@ -9,6 +9,7 @@
 #include <libasr/codegen/asr_to_fortran.h>
 #include <libasr/codegen/wasm_to_wat.h>
 #include <lfortran/ast_to_src.h>
+#include <lfortran/ast_serialization.h>
 #include <libasr/exception.h>
 #include <lfortran/ast.h>
 #include <libasr/asr.h>
@@ -192,6 +193,18 @@ Result<LFortran::AST::TranslationUnit_t*> FortranEvaluator::get_ast2(
             diag::Diagnostics &diagnostics)
 {
     // Src -> AST
+    std::string ast_cache_key;
+    if (compiler_options.cache_dir.size() > 0 && lm.files.size() == 1) {
+        ast_cache_key = LFortran::get_ast_cache_key(code_orig,
+            lm.files.back().in_filename, compiler_options);
+        if (ast_cache_key.size() > 0) {
+            LFortran::AST::TranslationUnit_t *ast
+                = LFortran::load_from_ast_cache(al, compiler_options.cache_dir,
+                    ast_cache_key, code_orig.size(), lm.files.back());
+            if (ast) return ast;
+        }
+    }
+    size_t n_diagnostics = diagnostics.diagnostics.size();
     const std::string *code=&code_orig;
     std::string tmp;
     if (compiler_options.c_preprocessor) {
@@ -200,7 +213,9 @@ Result<LFortran::AST::TranslationUnit_t*> FortranEvaluator::get_ast2(
         tmp = cpp.run(code_orig, lm, cpp.macro_definitions);
         code = &tmp;
     }
-    if (compiler_options.prescan || compiler_options.fixed_form) {
+    if ((compiler_options.prescan || compiler_options.fixed_form)
+            && !LFortran::prescan_identity(*code, lm,
+                compiler_options.fixed_form)) {
         std::vector<std::filesystem::path> include_dirs;
         include_dirs.push_back(parent_path(lm.files.back().in_filename));
         include_dirs.insert(include_dirs.end(),
@@ -212,6 +227,13 @@ Result<LFortran::AST::TranslationUnit_t*> FortranEvaluator::get_ast2(
     Result<LFortran::AST::TranslationUnit_t*>
         res = LFortran::parse(al, *code, diagnostics, compiler_options);
     if (res.ok) {
+        // Files with warnings are not cached, the warnings would be lost
+        if (ast_cache_key.size() > 0
+                && diagnostics.diagnostics.size() == n_diagnostics) {
+            LFortran::save_to_ast_cache(compiler_options.cache_dir,
+                ast_cache_key, code_orig.size(), *res.result,
+                lm.files.back());
+        }
         return res.result;
     } else {
         LCOMPILERS_ASSERT(diagnostics.has_error())
@@ -368,8 +390,12 @@ Result<std::unique_ptr<LLVMModule>> FortranEvaluator::get_llvm3(
         return res.error;
     }
 
-    if (compiler_options.po.fast) {
-        e->opt(*m->m_m);
+    if (compiler_options.po.fast || compiler_options.opt_level > 0
+            || compiler_options.opt_size_level > 0) {
+        // `--fast` implies at least -O3
+        e->opt(*m->m_m, compiler_options.po.fast
+            ? std::max(compiler_options.opt_level, 3)
+            : compiler_options.opt_level, compiler_options.opt_size_level);
     }
 
     return m;
@@ -18,12 +18,11 @@ Note: The prescanner removes CR, so we only handle LF here.
 #include <lfortran/pickle.h>
 
 
-int position = 0;
 #define TOK(pos, arg) std::cout << std::string(pos, ' ') << "TOKEN: " << arg << std::endl;
 
 namespace LCompilers::LFortran {
 
-std::map<std::string, yytokentype> identifiers_map = {
+const std::map<std::string, yytokentype> identifiers_map = {
     {"EOF", END_OF_FILE},
     {"\n", TK_NEWLINE},
     {"name", TK_NAME},
@@ -267,7 +266,7 @@ std::map<std::string, yytokentype> identifiers_map = {
     {"uminus", UMINUS}
 };
 
-std::vector<std::string> declarators{
+const std::vector<std::string> declarators{
             "integer",
             "real",
             "complex",
@@ -283,9 +282,7 @@ std::vector<std::string> declarators{
             "class"
         };
 
-std::vector<std::string> lines{};
-
-std::vector<std::string> io_names{"open", "read", "write", "format", "close", "print"};
+const std::vector<std::string> io_names{"open", "read", "write", "format", "close", "print"};
 
 void FixedFormTokenizer::set_string(const std::string &str)
 {
@@ -313,6 +310,9 @@ struct FixedFormRecursiveDescent {
     std::vector<Location> locations;
     // Stack of do labels
     std::vector<int64_t> do_labels;
+    // The tokenized lines. This is per tokenizer state (not global), since
+    // several files can be tokenized concurrently.
+    std::vector<std::string> lines;
 
     FixedFormRecursiveDescent(diag::Diagnostics &diag,
         Allocator &m_a) : diag{diag}, m_a{m_a} {
@@ -447,7 +447,9 @@ struct FixedFormRecursiveDescent {
 
     // token_type automatically determined
     void push_token_no_advance(unsigned char *cur, const std::string &token_str) {
-        push_token_no_advance_token(cur, token_str, identifiers_map[token_str]);
+        auto search = identifiers_map.find(token_str);
+        push_token_no_advance_token(cur, token_str,
+            search != identifiers_map.end() ? search->second : yytokentype(0));
     }
 
     void push_integer_no_advance(unsigned char *cur, int32_t n) {
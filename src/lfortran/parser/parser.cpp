@@ -2,6 +2,9 @@
 #include <string>
 #include <sstream>
 #include <cctype>
+#include <cstring>
+#include <mutex>
+#include <thread>
 
 #include <lfortran/parser/parser.h>
 #include <lfortran/parser/parser.tab.hh>
@@ -116,33 +119,44 @@ void fix_program_without_program_line(Allocator &al, AST::TranslationUnit_t &ast
     ast.n_items = global_items.size();
 }
 
+bool parse_parallel(Allocator &al, const std::string &s,
+        diag::Diagnostics &diagnostics, size_t n_jobs, Vec<AST::ast_t*> &items);
+
 Result<AST::TranslationUnit_t*> parse(Allocator &al, const std::string &s,
         diag::Diagnostics &diagnostics, const CompilerOptions &co)
 {
-    Parser p(al, diagnostics, co.fixed_form);
-    try {
-        if (!p.parse(s)) {
-            return Error();
-        };
-    } catch (const parser_local::TokenizerError &e) {
-        Error error;
-        diagnostics.diagnostics.push_back(e.d);
-        return error;
-    } catch (const parser_local::ParserError &e) {
-        Error error;
-        diagnostics.diagnostics.push_back(e.d);
-        return error;
+    Vec<AST::ast_t*> items;
+    bool parsed = false;
+    if (co.parse_jobs > 1 && !co.fixed_form && !co.interactive) {
+        parsed = parse_parallel(al, s, diagnostics, co.parse_jobs, items);
+    }
+    if (!parsed) {
+        Parser p(al, diagnostics, co.fixed_form);
+        try {
+            if (!p.parse(s)) {
+                return Error();
+            };
+        } catch (const parser_local::TokenizerError &e) {
+            Error error;
+            diagnostics.diagnostics.push_back(e.d);
+            return error;
+        } catch (const parser_local::ParserError &e) {
+            Error error;
+            diagnostics.diagnostics.push_back(e.d);
+            return error;
+        }
+        items = p.result;
     }
     Location l;
-    if (p.result.size() == 0) {
+    if (items.size() == 0) {
         l.first=0;
         l.last=0;
     } else {
-        l.first=p.result[0]->loc.first;
-        l.last=p.result[p.result.size()-1]->loc.last;
+        l.first=items[0]->loc.first;
+        l.last=items[items.size()-1]->loc.last;
     }
     AST::TranslationUnit_t* ast = (AST::TranslationUnit_t*)AST::make_TranslationUnit_t(al, l,
-        p.result.p, p.result.size());
+        items.p, items.size());
     if (!co.interactive && !co.fixed_form && is_program_needed(*ast)) {
         try {
             fix_program_without_program_line(al, *ast);
@@ -155,21 +169,25 @@ Result<AST::TranslationUnit_t*> parse(Allocator &al, const std::string &s,
     return ast;
 }
 
-bool Parser::parse(const std::string &input)
+bool Parser::parse(const std::string &input, uint32_t offset)
 {
-    inp = input;
-    if (inp.size() > 0) {
-        if (inp[inp.size()-1] != '\n') inp.append("\n");
-    } else {
+    // The tokenizers need the input to end with a newline. The prescanner
+    // output usually does, so it is tokenized in place, and only copied if
+    // the newline has to be appended.
+    const std::string *text = &input;
+    if (input.size() == 0 || input[input.size()-1] != '\n') {
+        inp.reserve(input.size() + 1);
+        inp = input;
         inp.append("\n");
+        text = &inp;
     }
     if (!fixed_form) {
-        m_tokenizer.set_string(inp);
+        m_tokenizer.set_string(*text, offset);
         if (yyparse(*this) == 0) {
             return true;
         }
     } else {
-        f_tokenizer.set_string(inp);
+        f_tokenizer.set_string(*text);
         if (!f_tokenizer.tokenize_input(diag, m_a)) return false;
         if (yyparse(*this) == 0) {
             return true;
@@ -303,6 +321,21 @@ LineType determine_line_type(const unsigned char *pos)
     }
 }
 
+// Starts a new interval of the location map at the position `out_pos` of the
+// output and `in_pos` of the input. If the previous interval would be empty it
+// is replaced instead, which keeps the maps small when many characters are
+// skipped in a row (such as all whitespace in fixed-form).
+void start_interval(LocationManager::FileLocations &fl, uint32_t out_pos,
+        uint32_t in_pos)
+{
+    if (fl.out_start.size() > 0 && fl.out_start.back() == out_pos) {
+        fl.in_start.back() = in_pos;
+    } else {
+        fl.out_start.push_back(out_pos);
+        fl.in_start.push_back(in_pos);
+    }
+}
+
 void skip_rest_of_line(const std::string &s, size_t &pos)
 {
     while (pos < s.size() && s[pos] != '\n') {
@@ -365,13 +398,11 @@ void copy_rest_of_line(std::string &out, const std::string &s, size_t &pos,
         } else if (s[pos] == ' ') {
             // Skip white space in a fixed-form parser
             pos++;
-            lm.files.back().out_start.push_back(out.size());
-            lm.files.back().in_start.push_back(pos);
+            start_interval(lm.files.back(), out.size(), pos);
         } else if (s[pos] == '\r') {
             // Skip CR in a fixed-form parser
             pos++;
-            lm.files.back().out_start.push_back(out.size());
-            lm.files.back().in_start.push_back(pos);
+            start_interval(lm.files.back(), out.size(), pos);
         } else {
             // Copy the character, but covert to lowercase
             out += tolower(s[pos]);
@@ -439,8 +470,7 @@ void process_include(std::string& out, const std::string& s,
     // lm.files.back().out_start.push_back(out.size());
     out += include;
     while (pos < s.size() && s[pos] != '\n') pos++;
-    lm.files.back().out_start.push_back(out.size());
-    lm.files.back().in_start.push_back(pos);
+    start_interval(lm.files.back(), out.size(), pos);
 }
 
 bool is_include(const std::string &s, uint32_t pos) {
@@ -458,6 +488,32 @@ bool is_include(const std::string &s, uint32_t pos) {
     }
 }
 
+// Appends the positions of all '\n' in s[first:last] to `newlines`
+void append_newlines(const std::string &s, size_t first, size_t last,
+        std::vector<uint32_t> &newlines)
+{
+    const char *begin = s.data();
+    const char *p = begin + first;
+    const char *end = begin + last;
+    while ((p = (const char *)memchr(p, '\n', end - p)) != nullptr) {
+        newlines.push_back(p - begin);
+        p++;
+    }
+}
+
+bool prescan_identity(const std::string &s, LocationManager &lm,
+        bool fixed_form)
+{
+    if (fixed_form || s.find('&') != std::string::npos
+            || s.find("include") != std::string::npos) {
+        return false;
+    }
+    start_interval(lm.files.back(), 0, 0);
+    append_newlines(s, 0, s.size(), lm.files.back().in_newlines);
+    start_interval(lm.files.back(), s.size(), s.size());
+    return true;
+}
+
 std::string prescan(const std::string &s, LocationManager &lm,
         bool fixed_form, std::vector<std::filesystem::path> &include_dirs)
 {
@@ -465,9 +521,10 @@ std::string prescan(const std::string &s, LocationManager &lm,
         // `pos` is the position in the original code `s`
         // `out` is the final code (outcome)
         lm.get_newlines(s, lm.files.back().in_newlines);
-        lm.files.back().out_start.push_back(0);
-        lm.files.back().in_start.push_back(0);
+        start_interval(lm.files.back(), 0, 0);
         std::string out;
+        // The output is at most as long as the input (without includes)
+        out.reserve(s.size());
         size_t pos = 0;
         /* Note:
          * This is a fixed-form prescanner, which:
@@ -496,23 +553,20 @@ std::string prescan(const std::string &s, LocationManager &lm,
                 case LineType::Comment : {
                     // Skip
                     skip_rest_of_line(s, pos);
-                    lm.files.back().out_start.push_back(out.size());
-                    lm.files.back().in_start.push_back(pos);
+                    start_interval(lm.files.back(), out.size(), pos);
                     break;
                 }
                 case LineType::Statement : {
                     // Copy from column 7
                     pos += 6;
-                    lm.files.back().out_start.push_back(out.size());
-                    lm.files.back().in_start.push_back(pos);
+                    start_interval(lm.files.back(), out.size(), pos);
                     copy_rest_of_line(out, s, pos, lm);
                     break;
                 }
                 case LineType::StatementTab : {
                     // Copy from column 2
                     pos += 1;
-                    lm.files.back().out_start.push_back(out.size());
-                    lm.files.back().in_start.push_back(pos);
+                    start_interval(lm.files.back(), out.size(), pos);
                     copy_rest_of_line(out, s, pos, lm);
                     break;
                 }
@@ -520,26 +574,23 @@ std::string prescan(const std::string &s, LocationManager &lm,
                     // Copy the label
                     copy_label(out, s, pos);
                     // Copy from column 7
-                    lm.files.back().out_start.push_back(out.size());
-                    lm.files.back().in_start.push_back(pos);
+                    start_interval(lm.files.back(), out.size(), pos);
                     copy_rest_of_line(out, s, pos, lm);
                     break;
                 }
                 case LineType::Continuation : {
                     // Append from column 7 to previous line
-                    out = out.substr(0, out.size()-1); // Remove the last '\n'
+                    if (out.size() > 0) out.pop_back(); // Remove the last '\n'
                     pos += 6;
-                    lm.files.back().out_start.push_back(out.size());
-                    lm.files.back().in_start.push_back(pos);
+                    start_interval(lm.files.back(), out.size(), pos);
                     copy_rest_of_line(out, s, pos, lm);
                     break;
                 }
                 case LineType::ContinuationTab : {
                     // Append from column 3 to previous line
-                    out = out.substr(0, out.size()-1); // Remove the last '\n'
+                    if (out.size() > 0) out.pop_back(); // Remove the last '\n'
                     pos += 2;
-                    lm.files.back().out_start.push_back(out.size());
-                    lm.files.back().in_start.push_back(pos);
+                    start_interval(lm.files.back(), out.size(), pos);
                     copy_rest_of_line(out, s, pos, lm);
                     break;
                 }
@@ -560,18 +611,45 @@ std::string prescan(const std::string &s, LocationManager &lm,
             };
             if (lt == LineType::EndOfFile) break;
         }
-        lm.files.back().in_start.push_back(pos);
-        lm.files.back().out_start.push_back(out.size());
+        start_interval(lm.files.back(), out.size(), pos);
         return out;
     } else {
         // `pos` is the position in the original code `s`
         // `out` is the final code (outcome)
-        lm.files.back().out_start.push_back(0);
-        lm.files.back().in_start.push_back(0);
+        start_interval(lm.files.back(), 0, 0);
         std::string out;
+        // The output is at most as long as the input (without includes)
+        out.reserve(s.size());
         size_t pos = 0;
         bool in_comment = false, newline = true;
+        // The next `&` and `include` in `s`, only the lines with them need
+        // to be processed character by character
+        size_t next_amp = std::min(s.find('&'), s.size());
+        size_t next_include = std::min(s.find("include"), s.size());
         while (pos < s.size()) {
+            if (newline) {
+                if (next_amp < pos) {
+                    next_amp = std::min(s.find('&', pos), s.size());
+                }
+                if (next_include < pos) {
+                    next_include = std::min(s.find("include", pos), s.size());
+                }
+                size_t next = std::min(next_amp, next_include);
+                size_t line_start = next;
+                if (next < s.size()) {
+                    line_start = s.rfind('\n', next);
+                    line_start = (line_start == std::string::npos
+                        || line_start < pos) ? pos : line_start + 1;
+                }
+                if (line_start > pos) {
+                    // Copy the lines before it at once
+                    append_newlines(s, pos, line_start,
+                        lm.files.back().in_newlines);
+                    out.append(s, pos, line_start - pos);
+                    pos = line_start;
+                    if (pos == s.size()) break;
+                }
+            }
             if (newline && is_include(s, pos)) {
                 while (pos < s.size() && s[pos] == ' ') pos++;
                 LCOMPILERS_ASSERT(pos + 6 < s.size() && s.substr(pos, 7) == "include")
@@ -600,8 +678,7 @@ std::string prescan(const std::string &s, LocationManager &lm,
                     if (s[pos] == '&') pos++;
                     // Start a new interval (just the starts, the size will be
                     // filled in later)
-                    lm.files.back().out_start.push_back(out.size());
-                    lm.files.back().in_start.push_back(pos);
+                    start_interval(lm.files.back(), out.size(), pos);
                 }
             } else {
                 if (s[pos] == '\n') {
@@ -619,13 +696,295 @@ std::string prescan(const std::string &s, LocationManager &lm,
 
         // Add the position of EOF as the last \n, whether or not the original
         // file has it
-        lm.files.back().in_start.push_back(pos);
-        lm.files.back().out_start.push_back(out.size());
+        start_interval(lm.files.back(), out.size(), pos);
         return out;
     }
 }
 
 
+/*
+    Parallel parsing of the program units of one free-form file.
+
+    `split_program_units` scans the (prescanned) source line by line and
+    tracks the nesting of the program units: `module`, `submodule`,
+    `program`, `block data`, `subroutine` and `function` statements open a
+    unit, the corresponding `end` statements close it. The positions where
+    the nesting returns to zero are the boundaries between the top level
+    units. A boundary is placed at the first line with code after the `end`
+    statement, so that the comments that follow the `end` statement stay
+    with it, just like in the serial parser.
+
+    The scanner only needs to be conservative: if it finds a statement it
+    does not understand (the nesting goes negative), the file is not split
+    at all. If it splits at a wrong place, one of the chunks fails to parse
+    and the whole file is parsed again serially, so that the errors are
+    exactly the same as without `parse_jobs`.
+*/
+
+// Minimum size of a chunk parsed by one thread
+const size_t parse_chunk_min_size = 16*1024;
+
+enum class UnitStatement {
+    Open, Close, Other
+};
+
+bool is_name_start(char c)
+{
+    return ('a' <= c && c <= 'z') || ('A' <= c && c <= 'Z') || c == '_';
+}
+
+bool is_name_char(char c)
+{
+    return is_name_start(c) || is_digit(c);
+}
+
+// Reads the next "atom" of the statement `s[pos:end]`: a lowercase name, a
+// balanced parenthesized group (returned as "()"), a kind selector such as
+// "*8" (returned as "*") or a single other character.
+// Returns an empty string at the end of the statement.
+std::string next_atom(const std::string &s, size_t &pos, size_t end)
+{
+    while (pos < end && (s[pos] == ' ' || s[pos] == '\t' || s[pos] == '\r')) pos++;
+    if (pos >= end) return "";
+    if (is_name_start(s[pos])) {
+        std::string name;
+        while (pos < end && is_name_char(s[pos])) {
+            name += tolower(s[pos]);
+            pos++;
+        }
+        return name;
+    }
+    if (s[pos] == '(') {
+        int depth = 0;
+        while (pos < end) {
+            if (s[pos] == '(') depth++;
+            if (s[pos] == ')') depth--;
+            pos++;
+            if (depth == 0) break;
+        }
+        return "()";
+    }
+    if (s[pos] == '*' && pos+1 < end
+            && (is_digit(s[pos+1]) || s[pos+1] == '(')) {
+        pos++;
+        if (s[pos] == '(') {
+            next_atom(s, pos, end);
+        } else {
+            while (pos < end && is_digit(s[pos])) pos++;
+        }
+        return "*";
+    }
+    return std::string(1, s[pos++]);
+}
+
+// Classifies the statement `s[pos:end]` (without a label)
+UnitStatement classify_unit_statement(const std::string &s, size_t pos,
+        size_t end)
+{
+    std::string a = next_atom(s, pos, end);
+    if (a.size() >= 3 && a.substr(0, 3) == "end") {
+        std::string kind = a.substr(3);
+        if (kind.size() == 0) kind = next_atom(s, pos, end);
+        if (kind == "subroutine" || kind == "function" || kind == "module"
+                || kind == "submodule" || kind == "program"
+                || kind == "blockdata") {
+            return UnitStatement::Close;
+        }
+        if (kind == "block" && next_atom(s, pos, end) == "data") {
+            return UnitStatement::Close;
+        }
+        if (kind.size() == 0) {
+            // Just `end`
+            return UnitStatement::Close;
+        }
+        return UnitStatement::Other;
+    }
+    std::string b = next_atom(s, pos, end);
+    if (a == "program" || a == "blockdata") {
+        return (b.size() == 0 || is_name_start(b[0]))
+            ? UnitStatement::Open : UnitStatement::Other;
+    }
+    if (a == "block" && b == "data") return UnitStatement::Open;
+    if (a == "submodule" && b == "()") return UnitStatement::Open;
+    if (a == "module" && b.size() > 0 && is_name_start(b[0])
+            && b != "procedure" && b != "subroutine" && b != "function"
+            && b != "recursive" && b != "pure" && b != "impure"
+            && b != "elemental" && b != "non_recursive") {
+        std::string c = next_atom(s, pos, end);
+        return (c.size() == 0) ? UnitStatement::Open : UnitStatement::Other;
+    }
+    // [prefix...] subroutine|function name
+    static const std::vector<std::string> prefixes = {"recursive", "pure",
+        "impure", "elemental", "non_recursive", "module", "integer", "real",
+        "complex", "logical", "character", "double", "precision",
+        "doubleprecision", "type", "class", "()", "*"};
+    std::string prev = a;
+    std::string cur = b;
+    while (true) {
+        if (prev == "subroutine" || prev == "function") {
+            return (cur.size() > 0 && is_name_start(cur[0]))
+                ? UnitStatement::Open : UnitStatement::Other;
+        }
+        if (std::find(prefixes.begin(), prefixes.end(), prev)
+                == prefixes.end()) {
+            return UnitStatement::Other;
+        }
+        prev = cur;
+        cur = next_atom(s, pos, end);
+    }
+}
+
+/*
+    Returns the positions in `s` where the top level program units start
+    (excluding 0). Returns an empty vector if the units cannot be determined.
+*/
+std::vector<size_t> split_program_units(const std::string &s)
+{
+    std::vector<size_t> boundaries;
+    int depth = 0;
+    bool boundary_pending = false;
+    size_t pos = 0;
+    while (pos < s.size()) {
+        size_t line_end = s.find('\n', pos);
+        if (line_end == std::string::npos) line_end = s.size();
+        size_t p = pos;
+        while (p < line_end && (s[p] == ' ' || s[p] == '\t')) p++;
+        bool code = (p < line_end && s[p] != '!' && s[p] != '#'
+            && s[p] != '\r');
+        if (code && boundary_pending) {
+            boundaries.push_back(pos);
+            boundary_pending = false;
+        }
+        // Statements of the line, separated by `;`
+        while (code && p < line_end) {
+            // Skip a label
+            while (p < line_end && is_digit(s[p])) p++;
+            size_t stmt_end = p;
+            char quote = 0;
+            while (stmt_end < line_end) {
+                char c = s[stmt_end];
+                if (quote) {
+                    if (c == quote) quote = 0;
+                } else if (c == '"' || c == '\'') {
+                    quote = c;
+                } else if (c == ';' || c == '!') {
+                    break;
+                }
+                stmt_end++;
+            }
+            switch (classify_unit_statement(s, p, stmt_end)) {
+                case UnitStatement::Open : {
+                    depth++;
+                    break;
+                }
+                case UnitStatement::Close : {
+                    depth--;
+                    if (depth < 0) return {};
+                    if (depth == 0) boundary_pending = true;
+                    break;
+                }
+                case UnitStatement::Other : {
+                    break;
+                }
+            }
+            if (stmt_end < line_end && s[stmt_end] == ';') {
+                p = stmt_end + 1;
+            } else {
+                break;
+            }
+        }
+        pos = line_end + 1;
+    }
+    if (depth != 0) return {};
+    return boundaries;
+}
+
+/*
+    Parses the chunks of `s` delimited by the program unit boundaries on up
+    to `n_jobs` threads. Every chunk is parsed by its own Parser into its own
+    Allocator, the memory of which is then moved to `al`. The items of all
+    chunks are appended to `items` in order and their locations refer to `s`.
+
+    Returns false if `s` was not split or if parsing of any chunk failed; the
+    caller then parses `s` serially.
+*/
+bool parse_parallel(Allocator &al, const std::string &s,
+        diag::Diagnostics &diagnostics, size_t n_jobs, Vec<AST::ast_t*> &items)
+{
+    size_t n_chunks = std::min(n_jobs, s.size() / parse_chunk_min_size);
+    if (n_chunks < 2) return false;
+    std::vector<size_t> boundaries = split_program_units(s);
+    // Join the units into `n_chunks` chunks of about the same size
+    std::vector<size_t> starts = {0};
+    size_t target = s.size() / n_chunks;
+    for (size_t b : boundaries) {
+        if (b - starts.back() >= target && s.size() - b >= target / 2) {
+            starts.push_back(b);
+        }
+    }
+    n_chunks = starts.size();
+    if (n_chunks < 2) return false;
+    starts.push_back(s.size());
+
+    struct Chunk {
+        std::unique_ptr<Allocator> al;
+        diag::Diagnostics diagnostics;
+        Vec<AST::ast_t*> result;
+        bool ok = false;
+    };
+    std::vector<Chunk> chunks(n_chunks);
+    std::mutex mtx;
+    size_t next = 0;
+    auto worker = [&]() {
+        while (true) {
+            size_t i;
+            {
+                std::lock_guard<std::mutex> lock(mtx);
+                if (next == n_chunks) return;
+                i = next++;
+            }
+            Chunk &c = chunks[i];
+            c.al = std::make_unique<Allocator>(
+                std::max<size_t>(64*1024, 4*(starts[i+1] - starts[i])));
+            Parser p(*c.al, c.diagnostics);
+            try {
+                c.ok = p.parse(s.substr(starts[i], starts[i+1] - starts[i]),
+                    starts[i]);
+            } catch (...) {
+                // The serial parser reports the error
+                c.ok = false;
+            }
+            c.result = p.result;
+        }
+    };
+    std::vector<std::thread> threads;
+    for (size_t j = 1; j < std::min(n_jobs, n_chunks); j++) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto &t : threads) {
+        t.join();
+    }
+
+    for (auto &c : chunks) {
+        if (!c.ok) return false;
+    }
+    size_t n_items = 0;
+    for (auto &c : chunks) {
+        n_items += c.result.size();
+    }
+    items.reserve(al, n_items);
+    for (auto &c : chunks) {
+        for (size_t i = 0; i < c.result.size(); i++) {
+            items.push_back(al, c.result[i]);
+        }
+        diagnostics.diagnostics.insert(diagnostics.diagnostics.end(),
+            c.diagnostics.diagnostics.begin(), c.diagnostics.diagnostics.end());
+        al.adopt(*c.al);
+    }
+    return true;
+}
+
 
 #define T(tk, name) case (yytokentype::tk) : return name;
 
@@ -7,6 +7,7 @@
 #include <filesystem>
 
 #include <libasr/utils.h>
+#include <libasr/string_utils.h>
 #include <libasr/containers.h>
 #include <libasr/diagnostics.h>
 #include <lfortran/parser/tokenizer.h>
@@ -27,13 +28,17 @@ public:
     FixedFormTokenizer f_tokenizer;
     Vec<AST::ast_t*> result;
     bool fixed_form;
+    // All occurrences of an identifier in the AST share the same string
+    StringInterner m_interner;
 
     Parser(Allocator &al, diag::Diagnostics &diagnostics, const bool &fixed_form=false)
-            : diag{diagnostics}, m_a{al}, fixed_form{fixed_form}{
+            : diag{diagnostics}, m_a{al}, fixed_form{fixed_form}, m_interner{al} {
         result.reserve(al, 32);
     }
 
-    bool parse(const std::string &input);
+    // `offset` is the position of `input` in the whole source, if `input`
+    // is only a part of it (free-form only)
+    bool parse(const std::string &input, uint32_t offset=0);
     void handle_yyerror(const Location &loc, const std::string &msg);
 };
 
@@ -56,6 +61,13 @@ std::string token2text(const int token);
 std::string prescan(const std::string &s, LocationManager &lm,
         bool fixed_form, std::vector<std::filesystem::path> &include_dirs);
 
+// If the free-form source `s` has no `&` and no `include`, the prescanner
+// would return it unchanged. In that case fills in the identity location
+// map of `s` in `lm` and returns true, so that `s` can be parsed as is.
+// Otherwise returns false and `s` has to be passed to `prescan`.
+bool prescan_identity(const std::string &s, LocationManager &lm,
+        bool fixed_form);
+
 } // namespace LCompilers::LFortran
 
 #endif
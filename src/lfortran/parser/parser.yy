@@ -4,7 +4,7 @@
 %param {LCompilers::LFortran::Parser &p}
 %locations
 %glr-parser
-%expect    210 // shift/reduce conflicts
+%expect    211 // shift/reduce conflicts
 %expect-rr 189 // reduce/reduce conflicts
 
 // Uncomment this to get verbose error messages
@@ -450,6 +450,7 @@ void yyerror(YYLTYPE *yyloc, LCompilers::LFortran::Parser &p,
 %type <ast> format
 %type <ast> open_statement
 %type <ast> flush_statement
+%type <ast> wait_statement
 %type <ast> close_statement
 %type <ast> write_statement
 %type <ast> read_statement
@@ -1653,6 +1654,7 @@ single_line_statement
     | sync_images_statement
     | sync_memory_statement
     | sync_team_statement
+    | wait_statement
     | where_statement_single
     | write_statement
     ;
@@ -1819,6 +1821,10 @@ flush_statement
     | KW_FLUSH TK_INTEGER { $$ = FLUSH1($2, @$); }
     ;
 
+wait_statement
+    : KW_WAIT "(" write_arg_list ")" { $$ = WAIT($3, @$); }
+    ;
+
 endfile_statement
     : end_file "(" write_arg_list ")" { $$ = ENDFILE($3, @$); }
     | end_file id { $$ = ENDFILE2($2, @$); }
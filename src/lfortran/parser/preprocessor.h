@@ -1,6 +1,9 @@
 #ifndef LFORTRAN_SRC_PARSER_PREPROCESSOR_H
 #define LFORTRAN_SRC_PARSER_PREPROCESSOR_H
 
+#include <set>
+#include <unordered_map>
+
 #include <libasr/exception.h>
 #include <lfortran/utils.h>
 #include <lfortran/parser/parser.h>
@@ -19,17 +22,45 @@ struct CPPMacro {
     std::string expansion;
 };
 
-typedef std::map<std::string, CPPMacro> cpp_symtab;
+typedef std::unordered_map<std::string, CPPMacro> cpp_symtab;
+
+// A file included with `#include`. It is read once per process and shared by
+// all the translation units that include it.
+struct CPPIncludeFile {
+    std::shared_ptr<const MappedFile> file;
+    std::string text;
+    // The file has a `#pragma once` line
+    bool pragma_once=false;
+    /*
+        The name of the include guard, if the whole file is inside of
+
+            #ifndef guard
+            ...
+            #endif
+
+        with only whitespace before and after, otherwise empty. If `guard`
+        is defined, the file expands to `guard_prefix` + `guard_suffix`
+        (the whitespace before and after) and does not need to be processed.
+    */
+    std::string guard;
+    std::string guard_prefix, guard_suffix;
+};
+
+// Returns the include file `filename`, or nullptr if it cannot be read
+std::shared_ptr<const CPPIncludeFile> get_include_file(
+    const std::string &filename);
 
 class CPreprocessor
 {
 public:
     CompilerOptions &compiler_options;
     cpp_symtab macro_definitions;
+    // The files with `#pragma once` that were already included
+    std::set<std::string> included_once;
     CPreprocessor(CompilerOptions &compiler_options);
     std::string token(unsigned char *tok, unsigned char* cur) const;
     std::string run(const std::string &input, LocationManager &lm,
-        cpp_symtab &macro_definitions) const;
+        cpp_symtab &macro_definitions);
 
     // Return the current token's location
     void token_loc(Location &loc, unsigned char *tok, unsigned char* cur,
@@ -40,10 +71,13 @@ public:
     }
 };
 
-std::string function_like_macro_expansion(
-            std::vector<std::string> &def_args,
-            std::string &expansion,
-            std::vector<std::string> &call_args);
+// Appends the expansion of a function-like macro with the arguments
+// `def_args` and the body `expansion`, called with `call_args`, to `output`
+void function_like_macro_expansion(
+            const std::vector<std::string> &def_args,
+            const std::string &expansion,
+            const std::vector<std::string> &call_args,
+            std::string &output);
 
 } // namespace LCompilers::LFortran
 
@@ -841,7 +841,7 @@ char *str2str_null(Allocator &al, const LCompilers::Str &s) {
     }
 }
 
-#define SYMBOL(x, l) make_Name_t(p.m_a, l, x.c_str(p.m_a), nullptr, 0)
+#define SYMBOL(x, l) make_Name_t(p.m_a, l, p.m_interner.intern(x), nullptr, 0)
 // `x.int_n` is of type BigInt but we store the int64_t directly in AST
 #define INTEGER(x, l) make_Num_t(p.m_a, l, x.int_n.n, str2str_null(p.m_a, x.int_kind))
 #define INT1(l) make_Num_t(p.m_a, l, 1, nullptr)
@@ -1102,6 +1102,7 @@ ast_t* builtin3(Allocator &al,
 #define NULLIFY(args0, l) builtin1(p.m_a, args0, l, make_Nullify_t)
 #define BACKSPACE(args0, l) builtin1(p.m_a, args0, l, make_Backspace_t)
 #define FLUSH(args0, l) builtin1(p.m_a, args0, l, make_Flush_t)
+#define WAIT(args0, l) builtin1(p.m_a, args0, l, make_Wait_t)
 #define ENDFILE(args0, l) builtin1(p.m_a, args0, l, make_Endfile_t)
 
 #define INCLUDE(arg, l) make_Include_t(p.m_a, l, 0, arg.c_str(p.m_a), nullptr)
@@ -2133,7 +2134,7 @@ ast_t* COARRAY(Allocator &al, const ast_t *id,
         TYPE_STMTS(body), body.size(), trivia_cast(trivia), nullptr)
 
 #define TYPE_STMTNAME(x, trivia, body, l) make_TypeStmtName_t(p.m_a, l, \
-        x.c_str(p.m_a), trivia_cast(trivia), STMTS(body), body.size())
+        p.m_interner.intern(x), trivia_cast(trivia), STMTS(body), body.size())
 #define TYPE_STMTVAR(vartype, trivia, body, l) make_TypeStmtType_t(p.m_a, l, \
         down_cast<decl_attribute_t>(vartype), trivia_cast(trivia), STMTS(body), body.size())
 #define CLASS_STMT(id, trivia, body, l) make_ClassStmt_t(p.m_a, l, \
@@ -2429,6 +2430,7 @@ void set_m_trivia(stmt_t *s, trivia_t *trivia) {
         TRIVIA_SET(SyncImages)
         TRIVIA_SET(SyncMemory)
         TRIVIA_SET(SyncTeam)
+        TRIVIA_SET(Wait)
         TRIVIA_SET(Write)
         TRIVIA_SET(AssociateBlock)
         TRIVIA_SET(Block)
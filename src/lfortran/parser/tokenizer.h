@@ -14,6 +14,8 @@ public:
     unsigned char *cur_line;
     unsigned int line_num;
     unsigned char *string_start;
+    // Added to all locations, if the string is a part of a larger input
+    uint32_t string_offset=0;
     bool fixed_form=false;
 
     int last_token=-1;
@@ -25,8 +27,9 @@ public:
 
 public:
     // Set the string to tokenize. The caller must ensure `str` will stay valid
-    // as long as `lex` is being called.
-    void set_string(const std::string &str);
+    // as long as `lex` is being called. If `str` starts at the position
+    // `offset` of the whole input, the locations are relative to the input.
+    void set_string(const std::string &str, uint32_t offset=0);
 
     // Get next token. Token ID is returned as function result, the semantic
     // value is put into `yylval`.
@@ -57,8 +60,8 @@ public:
     // Return the current token's location
     void token_loc(Location &loc) const
     {
-        loc.first = tok-string_start;
-        loc.last = cur-string_start-1;
+        loc.first = tok-string_start+string_offset;
+        loc.last = cur-string_start+string_offset-1;
     }
     void add_rel_warning(diag::Diagnostics &diagnostics, bool fixed_form, int rel_token) const;
 };
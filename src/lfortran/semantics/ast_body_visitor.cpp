@@ -198,8 +198,26 @@ public:
         print_statements.clear();
     }
 
+    // The value of an `asynchronous=` specifier has to be known at compile
+    // time, as asynchronous transfers are lowered differently
+    bool is_asynchronous_yes(ASR::expr_t* value, const Location& loc) {
+        std::string s;
+        if( !ASRUtils::is_value_constant(ASRUtils::expr_value(value), s) ) {
+            throw SemanticError("`asynchronous` must be a constant character expression", loc);
+        }
+        s = to_lower(s);
+        s.erase(s.find_last_not_of(' ') + 1);
+        if( s == "yes" ) {
+            return true;
+        } else if( s == "no" ) {
+            return false;
+        }
+        throw SemanticError("ASYNCHRONOUS= specifier must have value = YES or NO", loc);
+    }
+
     void visit_Open(const AST::Open_t& x) {
-        ASR::expr_t *a_newunit = nullptr, *a_filename = nullptr, *a_status = nullptr, *a_form = nullptr;
+        ASR::expr_t *a_newunit = nullptr, *a_filename = nullptr, *a_status = nullptr, *a_form = nullptr,
+            *a_access = nullptr, *a_asynchronous = nullptr;
         if( x.n_args > 1 ) {
             throw SemanticError("Number of arguments cannot be more than 1 in Open statement.",
                                 x.base.base.loc);
@@ -276,8 +294,31 @@ public:
                 if (!ASRUtils::is_character(*a_form_type)) {
                         throw SemanticError("`form` must be of type, Character or CharacterPointer", x.base.base.loc);
                 }
+            } else if( m_arg_str == std::string("access") ) {
+                if ( a_access != nullptr ) {
+                    throw SemanticError(R"""(Duplicate value of `access` found, unit has already been specified via arguments or keyword arguments)""",
+                                        x.base.base.loc);
+                }
+                this->visit_expr(*kwarg.m_value);
+                a_access = ASRUtils::EXPR(tmp);
+                ASR::ttype_t* a_access_type = ASRUtils::expr_type(a_access);
+                if (!ASRUtils::is_character(*a_access_type)) {
+                        throw SemanticError("`access` must be of type, Character or CharacterPointer", x.base.base.loc);
+                }
+            } else if( m_arg_str == std::string("asynchronous") ) {
+                if ( a_asynchronous != nullptr ) {
+                    throw SemanticError(R"""(Duplicate value of `asynchronous` found, unit has already been specified via arguments or keyword arguments)""",
+                                        x.base.base.loc);
+                }
+                this->visit_expr(*kwarg.m_value);
+                a_asynchronous = ASRUtils::EXPR(tmp);
+                ASR::ttype_t* a_asynchronous_type = ASRUtils::expr_type(a_asynchronous);
+                if (!ASRUtils::is_character(*a_asynchronous_type)) {
+                        throw SemanticError("`asynchronous` must be of type, Character or CharacterPointer", x.base.base.loc);
+                }
+                is_asynchronous_yes(a_asynchronous, kwarg.loc);
             } else {
-                const std::unordered_set<std::string> unsupported_args {"iostat", "iomsg", "err", "blank", "access", \
+                const std::unordered_set<std::string> unsupported_args {"iostat", "iomsg", "err", "blank", \
                                                                         "recl", "fileopt", "action", "position", "pad"};
                 if (unsupported_args.find(m_arg_str) == unsupported_args.end()) {
                     throw SemanticError("Invalid argument `" + m_arg_str + "` supplied", x.base.base.loc);
@@ -295,7 +336,7 @@ public:
                                 x.base.base.loc);
         }
         tmp = ASR::make_FileOpen_t(al, x.base.base.loc, x.m_label,
-                               a_newunit, a_filename, a_status, a_form);
+                               a_newunit, a_filename, a_status, a_form, a_access, a_asynchronous);
         tmp_vec.push_back(tmp);
         tmp = nullptr;
     }
@@ -472,7 +513,16 @@ public:
         a_unit = a_fmt = a_iomsg = a_iostat = a_size = a_id = a_separator = a_end = a_fmt_constant = nullptr;
         ASR::stmt_t *overloaded_stmt = nullptr;
         std::string read_write = "";
-        bool formatted = (n_args == 2);
+        // Without a unit the format is given as `read fmt, list`, with a
+        // unit the transfer is unformatted if neither fmt nor nml is given
+        bool has_unit = (n_args > 0), has_fmt = (n_args == 2);
+        for( std::uint32_t i = 0; i < n_kwargs; i++ ) {
+            std::string m_arg_str = to_lower(m_kwargs[i].m_arg);
+            has_unit = has_unit || m_arg_str == "unit";
+            has_fmt = has_fmt || m_arg_str == "fmt" || m_arg_str == "nml";
+        }
+        bool formatted = !has_unit || has_fmt;
+        bool asynchronous = false, asynchronous_given = false;
         Vec<ASR::expr_t*> a_values_vec;
         a_values_vec.reserve(al, n_values);
 
@@ -558,10 +608,21 @@ public:
                 }
                 this->visit_expr(*kwarg.m_value);
                 a_id = ASRUtils::EXPR(tmp);
-                ASR::ttype_t* a_status_type = ASRUtils::expr_type(a_id);
-                if (!ASR::is_a<ASR::Character_t>(*ASRUtils::type_get_past_pointer(a_status_type))) {
-                        throw SemanticError("`status` must be of type Character", loc);
+                ASR::ttype_t* a_id_type = ASRUtils::expr_type(a_id);
+                if (!ASRUtils::is_variable(a_id)) {
+                    throw SemanticError("Non-variable expression for `id`", loc);
+                }
+                if (!ASR::is_a<ASR::Integer_t>(*ASRUtils::type_get_past_pointer(a_id_type))) {
+                        throw SemanticError("`id` must be of type, Integer", loc);
                 }
+            } else if( m_arg_str == std::string("asynchronous") ) {
+                if( asynchronous_given ) {
+                    throw SemanticError(R"""(Duplicate value of `asynchronous` found, it has already been specified via arguments or keyword arguments)""",
+                                        loc);
+                }
+                asynchronous_given = true;
+                this->visit_expr(*kwarg.m_value);
+                asynchronous = is_asynchronous_yes(ASRUtils::EXPR(tmp), kwarg.loc);
             } else if( m_arg_str == std::string("fmt")  ) {
                 if( a_fmt != nullptr ) {
                     throw SemanticError(R"""(Duplicate value of `fmt` found, it has already been specified via arguments or keyword arguments)""",
@@ -613,7 +674,7 @@ public:
                     body.push_back(al, ASRUtils::STMT(
                         ASR::make_FileWrite_t(al, loc, 0, a_unit,
                         nullptr, nullptr, nullptr,
-                        nullptr, 0, nullptr, newline, nullptr)));
+                        nullptr, 0, nullptr, newline, nullptr, true, false)));
                     // TODO: Compare with "no" (case-insensitive) in else part
                     // Throw runtime error if advance expression does not match "no"
                     newline_for_advance.push_back(ASR::make_If_t(al, loc, test, body.p,
@@ -626,7 +687,13 @@ public:
             throw SemanticError(R"""(List directed format(*) is not allowed with a ADVANCE= specifier)""",
                                 loc);
         }
-        if (_type == AST::stmtType::Write && a_fmt == nullptr
+        if( a_id != nullptr && !asynchronous ) {
+            throw SemanticError("`id` can only be specified for an asynchronous data transfer", loc);
+        }
+        if( asynchronous && a_unit == nullptr ) {
+            throw SemanticError("An asynchronous data transfer requires an external unit", loc);
+        }
+        if (_type == AST::stmtType::Write && a_fmt == nullptr && formatted
                 && compiler_options.print_leading_space) {
             ASR::asr_t* file_write_asr_t = construct_leading_space(false, loc);
             ASR::FileWrite_t* file_write = ASR::down_cast<ASR::FileWrite_t>(ASRUtils::STMT(file_write_asr_t));
@@ -693,11 +760,11 @@ public:
                 if( _type == AST::stmtType::Write ) {
                     tmp = ASR::make_FileWrite_t(al, loc, m_label, a_unit,
                         a_iomsg, a_iostat, a_id, a_values_vec.p,
-                        a_values_vec.size(), a_separator, a_end, nullptr);
+                        a_values_vec.size(), a_separator, a_end, nullptr, formatted, asynchronous);
                     print_statements[tmp] = std::make_pair(&w->base,label);
                 } else if( _type == AST::stmtType::Read ) {
                     tmp = ASR::make_FileRead_t(al, loc, m_label, a_unit, a_fmt,
-                                a_iomsg, a_iostat, a_size, a_id, a_values_vec.p, a_values_vec.size(), nullptr);
+                                a_iomsg, a_iostat, a_size, a_id, a_values_vec.p, a_values_vec.size(), nullptr, formatted, asynchronous);
                     print_statements[tmp] = std::make_pair(&r->base,label);
                 }
                 return;
@@ -719,10 +786,10 @@ public:
         if( _type == AST::stmtType::Write ) {
             tmp = ASR::make_FileWrite_t(al, loc, m_label, a_unit,
                 a_iomsg, a_iostat, a_id, a_values_vec.p,
-                a_values_vec.size(), a_separator, a_end, overloaded_stmt);
+                a_values_vec.size(), a_separator, a_end, overloaded_stmt, formatted, asynchronous);
         } else if( _type == AST::stmtType::Read ) {
             tmp = ASR::make_FileRead_t(al, loc, m_label, a_unit, a_fmt,
-                a_iomsg, a_iostat, a_size, a_id, a_values_vec.p, a_values_vec.size(), overloaded_stmt);
+                a_iomsg, a_iostat, a_size, a_id, a_values_vec.p, a_values_vec.size(), overloaded_stmt, formatted, asynchronous);
         }
 
         tmp_vec.push_back(tmp);
@@ -859,6 +926,21 @@ public:
         tmp = ASR::make_Flush_t(al, x.base.base.loc, x.m_label, unit, err, iomsg, iostat);
     }
 
+    void visit_Wait(const AST::Wait_t& x) {
+        std::map<std::string, size_t> argname2idx = {{"unit", 0}, {"id", 1}, {"iostat", 2}, {"iomsg", 3}, {"err", 4}};
+        std::vector<ASR::expr_t*> args;
+        std::string node_name = "Wait";
+        fill_args_for_rewind_inquire_flush(x, 5, args, 5, argname2idx, node_name);
+        if( !args[0] ) {
+            throw SemanticError("unit must be present in wait statement arguments", x.base.base.loc);
+        }
+        ASR::expr_t *unit = args[0], *id = args[1], *iostat = args[2], *iomsg = args[3], *err = args[4];
+        if( id && !ASRUtils::is_integer(*ASRUtils::expr_type(id)) ) {
+            throw SemanticError("id must be an integer in wait statement", id->base.loc);
+        }
+        tmp = ASR::make_FileWait_t(al, x.base.base.loc, x.m_label, unit, id, iostat, iomsg, err);
+    }
+
     void visit_Associate(const AST::Associate_t& x) {
         this->visit_expr(*(x.m_target));
         ASR::expr_t* target = ASRUtils::EXPR(tmp);
@@ -2630,6 +2712,9 @@ public:
                     ASRUtils::create_intrinsic_subroutine create_func =
                         ASRUtils::IntrinsicImpureSubroutineRegistry::get_create_subroutine(var_name);
                     tmp = create_func(al, x.base.base.loc, args, diag);
+                    if (tmp == nullptr) {
+                        throw SemanticAbort();
+                    }
                     return tmp;
                 }
             }
@@ -3068,7 +3153,7 @@ public:
                 args.p, args.size(), nullptr, empty_string);
         } else {
             return ASR::make_FileWrite_t(al, loc, 0, nullptr, nullptr,
-                nullptr, nullptr, args.p, args.size(), nullptr, empty_string, nullptr);
+                nullptr, nullptr, args.p, args.size(), nullptr, empty_string, nullptr, true, false);
         }
     }
 
@@ -73,6 +73,7 @@ static inline int64_t stmt_label(AST::stmt_t *f)
         LFORTRAN_STMT_LABEL_TYPE(SyncImages)
         LFORTRAN_STMT_LABEL_TYPE(SyncMemory)
         LFORTRAN_STMT_LABEL_TYPE(SyncTeam)
+        LFORTRAN_STMT_LABEL_TYPE(Wait)
         LFORTRAN_STMT_LABEL_TYPE(Write)
         LFORTRAN_STMT_LABEL_TYPE(AssociateBlock)
         LFORTRAN_STMT_LABEL_TYPE(Block)
@@ -849,6 +850,7 @@ public:
         {"dshiftl", {IntrinsicSignature({"i", "j", "shift"}, 3, 3)}},
         {"dshiftr", {IntrinsicSignature({"i", "j", "shift"}, 3, 3)}},
         {"random_number", {IntrinsicSignature({"r"}, 1, 1)}},
+        {"random_seed", {IntrinsicSignature({"size", "put", "get"}, 0, 3)}},
         {"mvbits", {IntrinsicSignature({"from", "frompos", "len", "to", "topos"}, 5, 5)}},
         {"modulo", {IntrinsicSignature({"a", "p"}, 2, 2)}},
         {"bessel_jn", {IntrinsicSignature({"n", "x"}, 2, 2)}},
@@ -2683,6 +2685,11 @@ public:
                                         x.base.base.loc);
                                 }
                                 // Do nothing for now
+                            } else if (sa->m_attr == AST::simple_attributeType
+                                    ::AttrAsynchronous) {
+                                // Nothing to do: asynchronous transfers get
+                                // the addresses of their variables, so the
+                                // accesses are not moved across a WAIT
                             } else if (sa->m_attr == AST::simple_attributeType
                                     ::AttrAllocatable) {
                                 // TODO
@@ -6756,10 +6763,11 @@ public:
 
         SymbolTable *tu_symtab = ASRUtils::get_tu_symtab(current_scope);
 
+        std::vector<std::string> remote_syms = {remote_sym};
         ASR::Module_t *m = ASRUtils::load_module(al, tu_symtab, module_name,
                 loc, true, compiler_options.po, true,
-                [&](const std::string &msg, const Location &loc) { throw SemanticError(msg, loc); }
-                );
+                [&](const std::string &msg, const Location &loc) { throw SemanticError(msg, loc); },
+                &remote_syms);
 
         ASR::symbol_t *t = m->m_symtab->resolve_symbol(remote_sym);
         if (!t) {
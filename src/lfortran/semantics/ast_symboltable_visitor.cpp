@@ -2578,6 +2578,54 @@ public:
         }
     }
 
+    // Returns the name of the symbol `x` in the module it is imported from
+    std::string get_use_remote_sym(const AST::use_symbol_t &x,
+            const Location &loc) {
+        std::string remote_sym;
+        switch (x.type)
+        {
+            case AST::use_symbolType::UseSymbol: {
+                remote_sym = to_lower(AST::down_cast<AST::UseSymbol_t>(&x)->m_remote_sym);
+                break;
+            }
+            case AST::use_symbolType::UseAssignment: {
+                remote_sym = "~assign";
+                break;
+            }
+            case AST::use_symbolType::IntrinsicOperator: {
+                AST::intrinsicopType op_type = AST::down_cast<AST::IntrinsicOperator_t>(&x)->m_op;
+                remote_sym = intrinsic2str[op_type];
+                break;
+            }
+            case AST::use_symbolType::DefinedOperator: {
+                remote_sym = AST::down_cast<AST::DefinedOperator_t>(
+                    &x)->m_opName;
+                break;
+            }
+            case AST::use_symbolType::UseWrite: {
+                remote_sym = AST::down_cast<AST::UseWrite_t>(
+                    &x)->m_id;
+                if (remote_sym != "formatted" && remote_sym != "unformatted") {
+                    throw SemanticError("Can only be `formatted` or `unformatted`", x.base.loc);
+                }
+                remote_sym = "~write_" + remote_sym;
+                break;
+            }
+            case AST::use_symbolType::UseRead: {
+                remote_sym = AST::down_cast<AST::UseRead_t>(
+                    &x)->m_id;
+                if (remote_sym != "formatted" && remote_sym != "unformatted") {
+                    throw SemanticError("Can only be `formatted` or `unformatted`", x.base.loc);
+                }
+                remote_sym = "~read_" + remote_sym;
+                break;
+            }
+            default:
+                throw SemanticError("Symbol with use not supported yet " + std::to_string(x.type), loc);
+        }
+        return remote_sym;
+    }
+
     void visit_Use(const AST::Use_t &x) {
         std::string msym = to_lower(x.m_module);
         if (msym == "ieee_arithmetic") {
@@ -2588,14 +2636,22 @@ public:
         current_module_dependencies.push_back(al, msym_cc);
 
         ASR::symbol_t *t = current_scope->resolve_symbol(msym);
-        if (!t) {
+        if (!t || ASR::is_a<ASR::Module_t>(*t)) {
             SymbolTable *tu_symtab = current_scope;
             while (tu_symtab->parent != nullptr) {
                 tu_symtab = tu_symtab->parent;
             }
+            // With `only:`, only the imported symbols of a module are
+            // loaded from its modfile
+            std::vector<std::string> remote_syms;
+            for (size_t i = 0; i < x.n_symbols; i++) {
+                remote_syms.push_back(get_use_remote_sym(*x.m_symbols[i],
+                    x.base.base.loc));
+            }
             t = (ASR::symbol_t*)(ASRUtils::load_module(al, tu_symtab,
                 msym, x.base.base.loc, false, compiler_options.po, true,
-                [&](const std::string &msg, const Location &loc) { throw SemanticError(msg, loc); }
+                [&](const std::string &msg, const Location &loc) { throw SemanticError(msg, loc); },
+                x.n_symbols > 0 ? &remote_syms : nullptr
                 ));
         }
         if (!ASR::is_a<ASR::Module_t>(*t)) {
@@ -2613,48 +2669,8 @@ public:
             //     use a, only: x, y, z
             std::queue<std::pair<std::string, std::string>> to_be_imported_later;
             for (size_t i = 0; i < x.n_symbols; i++) {
-                std::string remote_sym;
-                switch (x.m_symbols[i]->type)
-                {
-                    case AST::use_symbolType::UseSymbol: {
-                        remote_sym = to_lower(AST::down_cast<AST::UseSymbol_t>(x.m_symbols[i])->m_remote_sym);
-                        break;
-                    }
-                    case AST::use_symbolType::UseAssignment: {
-                        remote_sym = "~assign";
-                        break;
-                    }
-                    case AST::use_symbolType::IntrinsicOperator: {
-                        AST::intrinsicopType op_type = AST::down_cast<AST::IntrinsicOperator_t>(x.m_symbols[i])->m_op;
-                        remote_sym = intrinsic2str[op_type];
-                        break;
-                    }
-                    case AST::use_symbolType::DefinedOperator: {
-                        remote_sym = AST::down_cast<AST::DefinedOperator_t>(
-                            x.m_symbols[i])->m_opName;
-                        break;
-                    }
-                    case AST::use_symbolType::UseWrite: {
-                        remote_sym = AST::down_cast<AST::UseWrite_t>(
-                            x.m_symbols[i])->m_id;
-                        if (remote_sym != "formatted" && remote_sym != "unformatted") {
-                            throw SemanticError("Can only be `formatted` or `unformatted`", x.m_symbols[i]->base.loc);
-                        }
-                        remote_sym = "~write_" + remote_sym;
-                        break;
-                    }
-                    case AST::use_symbolType::UseRead: {
-                        remote_sym = AST::down_cast<AST::UseRead_t>(
-                            x.m_symbols[i])->m_id;
-                        if (remote_sym != "formatted" && remote_sym != "unformatted") {
-                            throw SemanticError("Can only be `formatted` or `unformatted`", x.m_symbols[i]->base.loc);
-                        }
-                        remote_sym = "~read_" + remote_sym;
-                        break;
-                    }
-                    default:
-                        throw SemanticError("Symbol with use not supported yet " + std::to_string(x.m_symbols[i]->type), x.base.base.loc);
-                }
+                std::string remote_sym = get_use_remote_sym(*x.m_symbols[i],
+                    x.base.base.loc);
                 std::string local_sym;
                 if (AST::is_a<AST::UseSymbol_t>(*x.m_symbols[i]) &&
                     AST::down_cast<AST::UseSymbol_t>(x.m_symbols[i])->m_local_rename) {
@@ -57,5 +57,35 @@ end program
     CHECK(!asr_verify(*asr, true, diagnostics));
 }
 
+TEST_CASE("SymbolTable") {
+    Allocator al(4*1024);
+    Location loc;
+    SymbolTable parent(nullptr), child(&parent);
+    std::vector<ASR::symbol_t*> syms;
+    for (size_t i = 0; i < 100; i++) {
+        syms.push_back(ASR::down_cast<ASR::symbol_t>(ASR::make_Module_t(al,
+            loc, nullptr, s2c(al, "m" + std::to_string(i)), nullptr, 0,
+            false, false)));
+        parent.add_symbol("m" + std::to_string(i), syms[i]);
+    }
+    // Remove every other symbol, the rest must still be found
+    for (size_t i = 0; i < 100; i += 2) {
+        parent.erase_symbol("m" + std::to_string(i));
+    }
+    child.add_symbol("m1", syms[0]);
+    for (size_t i = 0; i < 100; i++) {
+        std::string name = "m" + std::to_string(i);
+        CHECK(parent.get_symbol(name) == (i % 2 ? syms[i] : nullptr));
+        CHECK(child.resolve_symbol(name)
+            == (i == 1 ? syms[0] : i % 2 ? syms[i] : nullptr));
+    }
+    parent.overwrite_symbol("m3", syms[4]);
+    CHECK(child.resolve_symbol("m3") == syms[4]);
+
+    // Iterated in the order of the names
+    CHECK(parent.get_scope().size() == 50);
+    CHECK(parent.get_scope().begin()->first == "m1");
+    CHECK(parent.get_scope().rbegin()->first == "m99");
+}
 
 } // namespace LCompilers::LFortran
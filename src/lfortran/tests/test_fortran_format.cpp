@@ -0,0 +1,41 @@
+#include <tests/doctest.h>
+
+#include <libasr/fortran_format.h>
+
+namespace LCompilers {
+
+TEST_CASE("compile_fortran_format") {
+    std::vector<uint8_t> code;
+    REQUIRE(compile_fortran_format("('x=', 2 (I3.2, 1X), f8.3)", code));
+    std::vector<uint8_t> expected = {
+        (uint8_t)FormatOp::Literal, 2, 'x', '=',
+        (uint8_t)FormatOp::Reversion,
+        (uint8_t)FormatOp::Repeat, 2,
+        (uint8_t)FormatOp::I, 3, 3,
+        (uint8_t)FormatOp::Space, 1,
+        (uint8_t)FormatOp::RepeatEnd,
+        (uint8_t)FormatOp::F, 8, 3,
+        (uint8_t)FormatOp::End};
+    CHECK(code == expected);
+
+    REQUIRE(compile_fortran_format("(-1p, 3es12.4e3, 'it''s', /, t200)", code));
+    expected = {
+        (uint8_t)FormatOp::Scale, 1, 1,
+        (uint8_t)FormatOp::Repeat, 3,
+        (uint8_t)FormatOp::ES, 12, 4, 3,
+        (uint8_t)FormatOp::RepeatEnd,
+        (uint8_t)FormatOp::Literal, 4, 'i', 't', '\'', 's',
+        (uint8_t)FormatOp::Newline,
+        (uint8_t)FormatOp::Tab, 200, 1,
+        (uint8_t)FormatOp::End};
+    CHECK(code == expected);
+
+    // Left to the runtime format parser
+    CHECK(!compile_fortran_format("(g10.3)", code));
+    CHECK(!compile_fortran_format("(e10)", code));
+    CHECK(!compile_fortran_format("(tl2, a)", code));
+    CHECK(!compile_fortran_format("('abc)", code));
+    CHECK(!compile_fortran_format("(2(a)", code));
+}
+
+} // namespace LCompilers
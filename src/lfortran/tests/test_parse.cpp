@@ -7,6 +7,7 @@
 
 #include <lfortran/parser/parser.h>
 #include <lfortran/parser/parser.tab.hh>
+#include <lfortran/pickle.h>
 #include <libasr/bigint.h>
 
 using LCompilers::LFortran::parse;
@@ -1315,6 +1316,55 @@ TEST_CASE("Location") {
     CHECK(result->loc.last == 49);
 }
 
+TEST_CASE("Parallel parsing") {
+    std::string input = "! Generated\n";
+    for (int i = 0; i < 200; i++) {
+        std::string n = std::to_string(i);
+        input += "module m" + n + "\n"
+            "implicit none\n"
+            "contains\n"
+            "subroutine a" + n + "(x)\n"
+            "    real, intent(inout) :: x(:)\n"
+            "    x = x + " + n + "; print *, \"end subroutine\"\n"
+            "end subroutine a" + n + "\n"
+            "end module m" + n + "\n"
+            "! Comment after module m" + n + "\n\n"
+            "integer(8) pure function f" + n + "(y) result(r)\n"
+            "    integer(8), intent(in) :: y\n"
+            "    r = y * " + n + "\n"
+            "contains\n"
+            "    subroutine g()\n"
+            "    end\n"
+            "end function\n";
+    }
+    input += "program main\nend program\n";
+    REQUIRE(input.size() > 64*1024);
+
+    Allocator al(1024*1024);
+    LCompilers::diag::Diagnostics diagnostics;
+    LCompilers::CompilerOptions co;
+    auto serial = TRY(parse(al, input, diagnostics, co));
+    co.parse_jobs = 4;
+    auto parallel = TRY(parse(al, input, diagnostics, co));
+    CHECK(diagnostics.diagnostics.size() == 0);
+    REQUIRE(parallel->n_items == serial->n_items);
+    CHECK(parallel->n_items == 401);
+    for (size_t i = 0; i < serial->n_items; i++) {
+        CHECK(parallel->m_items[i]->loc.first == serial->m_items[i]->loc.first);
+        CHECK(parallel->m_items[i]->loc.last == serial->m_items[i]->loc.last);
+    }
+    CHECK(LCompilers::LFortran::pickle(*parallel)
+        == LCompilers::LFortran::pickle(*serial));
+
+    // An error in one of the units is reported by the serial parser
+    input.replace(input.find("r = y * 100"), 11, "r = y * * 100");
+    diagnostics.diagnostics.clear();
+    auto res = parse(al, input, diagnostics, co);
+    CHECK(res.ok == false);
+    REQUIRE(diagnostics.diagnostics.size() == 1);
+    CHECK(diagnostics.diagnostics[0].stage == LCompilers::diag::Stage::Parser);
+}
+
 TEST_CASE("Errors") {
     Allocator al(1024*1024);
     std::string input;
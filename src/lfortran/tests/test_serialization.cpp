@@ -1,9 +1,12 @@
 #include <tests/doctest.h>
 #include <iostream>
+#include <fstream>
+#include <filesystem>
 
 #include <libasr/bwriter.h>
 #include <libasr/serialization.h>
 #include <lfortran/ast_serialization.h>
+#include <lfortran/fortran_evaluator.h>
 #include <libasr/modfile.h>
 #include <lfortran/pickle.h>
 #include <libasr/pickle.h>
@@ -322,6 +325,277 @@ end module
 
 }
 
+std::string module_interface_hash(Allocator &al, const std::string &src) {
+    // The symbol table counters are part of the ASR
+    LCompilers::SymbolTable::reset_global_counter();
+    LCompilers::LFortran::AST::TranslationUnit_t* ast0;
+    LCompilers::diag::Diagnostics diagnostics;
+    LCompilers::CompilerOptions compiler_options;
+    ast0 = TRY(LCompilers::LFortran::parse(al, src, diagnostics, compiler_options));
+    LCompilers::ASR::TranslationUnit_t* asr = TRY(LCompilers::LFortran::ast_to_asr(al, *ast0,
+        diagnostics, nullptr, false, compiler_options));
+    LCompilers::ASR::Module_t *m = LCompilers::ASR::down_cast<LCompilers::ASR::Module_t>(
+        asr->m_symtab->get_symbol("a"));
+    std::string hash = LCompilers::get_module_interface_hash(*m, compiler_options.po);
+
+    std::string modfile = LCompilers::save_modfile(*asr, &compiler_options.po);
+    std::string interface_hash, module_hash;
+    LCompilers::load_modfile_hashes(modfile, interface_hash, module_hash);
+    CHECK(interface_hash == hash);
+    CHECK(module_hash.size() == 16);
+    return hash;
+}
+
+TEST_CASE("ASR modfile interface hash") {
+    Allocator al(4*1024);
+    std::string h1 = module_interface_hash(al, R"""(
+module a
+implicit none
+integer, parameter :: n = 5
+contains
+integer function f(x)
+integer, intent(in) :: x
+f = x + n
+end function
+end module
+)""");
+    // Only the body of `f` changed
+    std::string h2 = module_interface_hash(al, R"""(
+module a
+implicit none
+integer, parameter :: n = 5
+contains
+integer function f(x)
+integer, intent(in) :: x
+f = 2*x + n
+end function
+end module
+)""");
+    // The type of the argument changed
+    std::string h3 = module_interface_hash(al, R"""(
+module a
+implicit none
+integer, parameter :: n = 5
+contains
+integer function f(x)
+integer(8), intent(in) :: x
+f = x + n
+end function
+end module
+)""");
+    // The value of the parameter changed
+    std::string h4 = module_interface_hash(al, R"""(
+module a
+implicit none
+integer, parameter :: n = 6
+contains
+integer function f(x)
+integer, intent(in) :: x
+f = x + n
+end function
+end module
+)""");
+    CHECK(h1 == h2);
+    CHECK(h1 != h3);
+    CHECK(h1 != h4);
+}
+
+TEST_CASE("ASR modfile lazy loading") {
+    Allocator al(4*1024);
+    LCompilers::LFortran::AST::TranslationUnit_t* ast0;
+    LCompilers::diag::Diagnostics diagnostics;
+    LCompilers::CompilerOptions compiler_options;
+    ast0 = TRY(LCompilers::LFortran::parse(al, R"""(
+module a
+implicit none
+integer, parameter :: n = 5
+type :: t
+    integer :: i
+end type
+contains
+integer function f(x)
+integer, intent(in) :: x
+f = g(x) + n
+end function
+integer function g(x)
+integer, intent(in) :: x
+g = 2*x
+end function
+integer function h(y)
+type(t), intent(in) :: y
+h = y%i
+end function
+end module
+)""", diagnostics, compiler_options));
+    LCompilers::ASR::TranslationUnit_t* asr = TRY(LCompilers::LFortran::ast_to_asr(al, *ast0,
+        diagnostics, nullptr, false, compiler_options));
+    std::string modfile = LCompilers::save_modfile(*asr, &compiler_options.po);
+
+    // Only `f` and the symbols it needs are loaded
+    LCompilers::ASR::TranslationUnit_t *tu = LCompilers::load_modfile_lazy(al,
+        LCompilers::parse_modfile(modfile), {"f"});
+    REQUIRE(tu != nullptr);
+    LCompilers::ASR::Module_t *m = LCompilers::ASRUtils::extract_module(*tu);
+    CHECK(m->m_symtab->get_symbol("f") != nullptr);
+    CHECK(m->m_symtab->get_symbol("g") != nullptr);
+    CHECK(m->m_symtab->get_symbol("n") != nullptr);
+    CHECK(m->m_symtab->get_symbol("h") == nullptr);
+    CHECK(m->m_symtab->get_symbol("t") == nullptr);
+    CHECK(LCompilers::is_module_partially_loaded(*m));
+
+    // `h` needs `t`
+    std::vector<std::string> symbols = {"h"};
+    LCompilers::load_modfile_symbols(al, *m, &symbols);
+    CHECK(m->m_symtab->get_symbol("h") != nullptr);
+    CHECK(m->m_symtab->get_symbol("t") != nullptr);
+
+    // The rest
+    LCompilers::load_modfile_symbols(al, *m, nullptr);
+    CHECK(!LCompilers::is_module_partially_loaded(*m));
+    CHECK(m->m_symtab->get_scope().size() == LCompilers::ASRUtils::extract_module(
+        *asr)->m_symtab->get_scope().size());
+}
+
+TEST_CASE("Mapped files") {
+    std::filesystem::path path = std::filesystem::temp_directory_path()
+        / ("lfortran_test_" + LCompilers::get_unique_ID() + ".mod");
+    std::ofstream(path, std::ios::binary) << "abc";
+    std::shared_ptr<const LCompilers::MappedFile> f1 = LCompilers::map_file(path.string());
+    REQUIRE(f1 != nullptr);
+    CHECK(f1->view() == "abc");
+    // The file is mapped only once
+    CHECK(LCompilers::map_file(path.string()) == f1);
+
+    // A new file replaces the old one, which stays valid
+    std::filesystem::path tmp = path;
+    tmp += ".tmp";
+    std::ofstream(tmp, std::ios::binary) << "abcd";
+    std::filesystem::rename(tmp, path);
+    std::shared_ptr<const LCompilers::MappedFile> f2 = LCompilers::map_file(path.string());
+    REQUIRE(f2 != nullptr);
+    CHECK(f2 != f1);
+    CHECK(f2->view() == "abcd");
+    CHECK(f1->view() == "abc");
+
+    std::filesystem::remove(path);
+    CHECK(LCompilers::map_file(path.string()) == nullptr);
+}
+
+TEST_CASE("Modfile cache") {
+    Allocator al(4*1024);
+    LCompilers::LFortran::AST::TranslationUnit_t* ast0;
+    LCompilers::diag::Diagnostics diagnostics;
+    LCompilers::CompilerOptions compiler_options;
+    ast0 = TRY(LCompilers::LFortran::parse(al, R"""(
+module a
+implicit none
+integer, parameter :: n = 5
+contains
+integer function f(x)
+integer, intent(in) :: x
+f = x + n
+end function
+end module
+)""", diagnostics, compiler_options));
+    LCompilers::ASR::TranslationUnit_t* asr = TRY(LCompilers::LFortran::ast_to_asr(al, *ast0,
+        diagnostics, nullptr, false, compiler_options));
+    std::string modfile = LCompilers::save_modfile(*asr, &compiler_options.po);
+
+    std::filesystem::path path = std::filesystem::temp_directory_path()
+        / ("lfortran_test_" + LCompilers::get_unique_ID() + ".mod");
+    std::ofstream(path, std::ios::binary) << modfile;
+    std::shared_ptr<const LCompilers::Modfile> m1 = LCompilers::get_modfile(
+        LCompilers::map_file(path.string()));
+    // The modfile is parsed only once
+    CHECK(LCompilers::get_modfile(LCompilers::map_file(path.string())) == m1);
+
+    // Each load is a separate copy of the module
+    Allocator al1(4*1024), al2(4*1024);
+    LCompilers::SymbolTable symtab1(nullptr), symtab2(nullptr);
+    LCompilers::ASR::TranslationUnit_t *tu1 = LCompilers::load_modfile(al1,
+        *m1, false, symtab1);
+    LCompilers::ASR::TranslationUnit_t *tu2 = LCompilers::load_modfile(al2,
+        *m1, false, symtab2);
+    CHECK(tu1 != tu2);
+    CHECK(LCompilers::pickle(*tu1) == LCompilers::pickle(*tu2));
+
+    // A replaced modfile is parsed again
+    std::filesystem::path tmp = path;
+    tmp += ".tmp";
+    std::ofstream(tmp, std::ios::binary) << modfile;
+    std::filesystem::rename(tmp, path);
+    std::shared_ptr<const LCompilers::Modfile> m2 = LCompilers::get_modfile(
+        LCompilers::map_file(path.string()));
+    CHECK(m2 != m1);
+    CHECK(m2->interface_hash == m1->interface_hash);
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("AST cache") {
+    std::string src = R"""(program cache_01
+integer :: x
+x = 1 + &
+    2
+print *, x
+end program
+)""";
+    std::filesystem::path cache_dir = std::filesystem::temp_directory_path()
+        / ("lfortran_test_" + LCompilers::get_unique_ID());
+    LCompilers::CompilerOptions compiler_options;
+    compiler_options.cache_dir = cache_dir.string();
+
+    std::string ast1, ast2;
+    LCompilers::LocationManager lm1, lm2;
+    for (auto *lm : {&lm1, &lm2}) {
+        LCompilers::LocationManager::FileLocations fl;
+        fl.in_filename = "cache_01.f90";
+        lm->files.push_back(fl);
+        lm->file_ends.push_back(src.size());
+    }
+    {
+        LCompilers::FortranEvaluator fe(compiler_options);
+        LCompilers::diag::Diagnostics diagnostics;
+        LCompilers::LFortran::AST::TranslationUnit_t *ast
+            = TRY(fe.get_ast2(src, lm1, diagnostics));
+        ast1 = LCompilers::LFortran::pickle(*ast);
+    }
+    std::string key = LCompilers::LFortran::get_ast_cache_key(src,
+        "cache_01.f90", compiler_options);
+    REQUIRE(key.size() > 0);
+    {
+        Allocator al(4*1024);
+        LCompilers::LocationManager::FileLocations fl;
+        CHECK(LCompilers::LFortran::load_from_ast_cache(al,
+            compiler_options.cache_dir, key, src.size(), fl) != nullptr);
+        // The size of the source is checked
+        CHECK(LCompilers::LFortran::load_from_ast_cache(al,
+            compiler_options.cache_dir, key, src.size() + 1, fl) == nullptr);
+    }
+    {
+        // Loaded from the cache
+        LCompilers::FortranEvaluator fe(compiler_options);
+        LCompilers::diag::Diagnostics diagnostics;
+        LCompilers::LFortran::AST::TranslationUnit_t *ast
+            = TRY(fe.get_ast2(src, lm2, diagnostics));
+        ast2 = LCompilers::LFortran::pickle(*ast);
+        // The locations point to the same source positions
+        uint32_t first = ast->m_items[0]->loc.first;
+        CHECK(lm1.output_to_input_pos(first, false)
+            == lm2.output_to_input_pos(first, false));
+    }
+    CHECK(ast1 == ast2);
+    CHECK(lm1.files.back().out_start == lm2.files.back().out_start);
+    CHECK(lm1.files.back().in_start == lm2.files.back().in_start);
+    CHECK(lm1.files.back().in_newlines == lm2.files.back().in_newlines);
+
+    // Files that might include other files are not cached
+    CHECK(LCompilers::LFortran::get_ast_cache_key("include 'a.h'\n",
+        "cache_01.f90", compiler_options) == "");
+
+    std::filesystem::remove_all(cache_dir);
+}
+
 TEST_CASE("Topological sorting mod_int") {
     std::map<std::string, std::vector<std::string>> deps;
     // 1 depends on 2
@@ -21,6 +21,8 @@ class Allocator
     size_t current_pos;
     size_t size;
     std::vector<void*> blocks;
+    // Bytes used in the chunks before the current one
+    size_t used_previous = 0;
 public:
     Allocator(size_t s) {
         s += ALIGNMENT;
@@ -74,6 +76,8 @@ public:
     }
 
     void *new_chunk(size_t s) {
+        // alloc() has already moved `current_pos` past the end for `s`
+        used_previous += size_current() - align(s);
         size_t snew = std::max(s+ALIGNMENT, 2*size);
         start = malloc(snew);
         blocks.push_back(start);
@@ -112,6 +116,21 @@ public:
         //return new T(std::forward<Args>(args)...);
     }
 
+    // Takes over all the memory of `other`, which must not be used to
+    // allocate afterwards. Everything that was allocated by `other` stays
+    // valid for as long as this allocator.
+    void adopt(Allocator &other) {
+        for (size_t i = 0; i < other.blocks.size(); i++) {
+            if (other.blocks[i] != nullptr) blocks.push_back(other.blocks[i]);
+        }
+        used_previous += other.size_used();
+        other.blocks.clear();
+        other.start = nullptr;
+        other.current_pos = 0;
+        other.size = 0;
+        other.used_previous = 0;
+    }
+
     size_t size_current() {
         return current_pos - (size_t)start;
     }
@@ -123,6 +142,11 @@ public:
     size_t num_chunks() {
         return blocks.size();
     }
+
+    // Bytes allocated in all chunks
+    size_t size_used() {
+        return used_previous + size_current();
+    }
 };
 
 #endif
@@ -1421,9 +1421,12 @@ class PickleVisitorVisitor(ASDLVisitor):
         self.emit(  "std::string s, indented = \"\";", 1)
         self.emit(  "bool use_colors;", 1)
         self.emit(  "bool indent;", 1)
+        self.emit(  "// Print the IDs of symbol tables, which depend on what else was", 1)
+        self.emit(  "// compiled before", 1)
+        self.emit(  "bool show_counters;", 1)
         self.emit(  "int indent_level = 0, indent_spaces = 4;", 1)
         self.emit("public:")
-        self.emit(  "PickleBaseVisitor() : use_colors(false), indent(false) { s.reserve(100000); }", 1)
+        self.emit(  "PickleBaseVisitor() : use_colors(false), indent(false), show_counters(true) { s.reserve(100000); }", 1)
         self.emit(  "void inc_indent() {", 1)
         self.emit(      "indent_level++;", 2)
         self.emit(      "indented = std::string(indent_level*indent_spaces, ' ');",2)
@@ -1603,7 +1606,7 @@ class PickleVisitorVisitor(ASDLVisitor):
                 assert not field.seq
                 if field.name == "parent_symtab":
                     level = 2
-                    self.emit('s.append(x.m_%s->get_counter());' % field.name, level)
+                    self.emit('s.append(show_counters ? x.m_%s->get_counter() : "_");' % field.name, level)
                 else:
                     level = 2
                     self.emit(      's.append("(");', level)
@@ -1620,7 +1623,7 @@ class PickleVisitorVisitor(ASDLVisitor):
                     self.emit('} else {', level)
                     self.emit('    s.append(" ");', level)
                     self.emit('}', level)
-                    self.emit('s.append(x.m_%s->get_counter());' % field.name, level)
+                    self.emit('s.append(show_counters ? x.m_%s->get_counter() : "_");' % field.name, level)
                     self.emit('if(indent) s.append("\\n" + indented);', level)
                     self.emit('else s.append(" ");', level)
                     self.emit(      's.append("{");', level)
@@ -2450,9 +2453,10 @@ class DeserializationVisitorVisitor(ASDLVisitor):
         self.emit(    'Location loc;', 2)
         self.emit(    'loc.first = self().read_int64();', 2)
         self.emit(    'loc.last = self().read_int64();', 2)
-        if subs["lcompiler"] == "lfortran":
+        if subs["MOD"] == "ASR":
             # Set the location to 0 for now, since we do not yet
-            # support multiple files
+            # support multiple files. The AST keeps its locations, it is
+            # loaded together with the location maps of its file.
             self.emit(    'loc.first = 0;', 2)
             self.emit(    'loc.last = 0;', 2)
         for line in lines:
@@ -1,5 +1,6 @@
 #include <iomanip>
 #include <sstream>
+#include <algorithm>
 
 #include <libasr/asr_scopes.h>
 #include <libasr/asr_utils.h>
@@ -18,7 +19,10 @@ std::string hexify(T i)
     return buf.str();
 }
 
-unsigned int symbol_table_counter = 0;
+// Thread local and reset before compiling each file, so that files compiled
+// in parallel by different threads each get the same symbol table numbering
+// as when compiled on their own
+thread_local unsigned int symbol_table_counter = 0;
 
 SymbolTable::SymbolTable(SymbolTable *parent) : parent{parent} {
     symbol_table_counter++;
@@ -29,6 +33,72 @@ void SymbolTable::reset_global_counter() {
     symbol_table_counter = 0;
 }
 
+void SymbolTable::index_insert(
+        std::pair<const std::string, ASR::symbol_t*> *item, size_t h) {
+    // Keep the load factor at most 3/4
+    if (4*(n_index + 1) > 3*index.size()) {
+        std::vector<IndexEntry> old_index(std::max<size_t>(8, 2*index.size()),
+            IndexEntry{0, nullptr});
+        old_index.swap(index);
+        size_t mask = index.size() - 1;
+        for (auto &e : old_index) {
+            if (e.item) {
+                size_t i = e.hash & mask;
+                while (index[i].item) i = (i + 1) & mask;
+                index[i] = e;
+            }
+        }
+    }
+    size_t mask = index.size() - 1;
+    size_t i = h & mask;
+    while (index[i].item) i = (i + 1) & mask;
+    index[i] = IndexEntry{h, item};
+    n_index++;
+}
+
+// Removes the entry at position `i`, moving back the entries after it in the
+// same probe sequence, so that no tombstones are needed
+void SymbolTable::index_erase(size_t i) {
+    size_t mask = index.size() - 1;
+    size_t j = i;
+    while (true) {
+        j = (j + 1) & mask;
+        if (!index[j].item) {
+            break;
+        }
+        // The entry `j` can stay if its home position is cyclically in (i, j]
+        size_t k = index[j].hash & mask;
+        if (i <= j ? (i < k && k <= j) : (i < k || k <= j)) {
+            continue;
+        }
+        index[i] = index[j];
+        i = j;
+    }
+    index[i].item = nullptr;
+    n_index--;
+}
+
+void SymbolTable::erase_symbol(std::string_view name) {
+    int64_t i = index_find(name, hash(name));
+    LCOMPILERS_ASSERT(i >= 0)
+    if (i >= 0) {
+        index_erase(i);
+        scope.erase(std::string(name));
+    }
+}
+
+void SymbolTable::add_or_overwrite_symbol(const std::string &name,
+        ASR::symbol_t* symbol) {
+    size_t h = hash(name);
+    int64_t i = index_find(name, h);
+    if (i >= 0) {
+        index[i].item->second = symbol;
+    } else {
+        auto it = scope.emplace(name, symbol).first;
+        index_insert(&*it, h);
+    }
+}
+
 void SymbolTable::mark_all_variables_external(Allocator &al) {
     for (auto &a : scope) {
         switch (a.second->type) {
@@ -58,33 +128,25 @@ void SymbolTable::mark_all_variables_external(Allocator &al) {
     }
 }
 
-ASR::symbol_t *SymbolTable::find_scoped_symbol(const std::string &name,
+ASR::symbol_t *SymbolTable::find_scoped_symbol(std::string_view name,
         size_t n_scope_names, char **m_scope_names) {
     const SymbolTable *s = this;
     for(size_t i=0; i < n_scope_names; i++) {
-        std::string scope_name = m_scope_names[i];
-        if (s->scope.find(scope_name) != scope.end()) {
-            ASR::symbol_t *sym = s->scope.at(scope_name);
-            s = ASRUtils::symbol_symtab(sym);
-            if (s == nullptr) {
-                // The m_scope_names[i] found in the appropriate symbol table,
-                // but points to a symbol that itself does not have a symbol
-                // table
-                return nullptr;
-            }
-        } else {
+        ASR::symbol_t *sym = s->get_symbol(m_scope_names[i]);
+        if (sym == nullptr) {
             // The m_scope_names[i] not found in the appropriate symbol table
             return nullptr;
         }
+        s = ASRUtils::symbol_symtab(sym);
+        if (s == nullptr) {
+            // The m_scope_names[i] found in the appropriate symbol table,
+            // but points to a symbol that itself does not have a symbol
+            // table
+            return nullptr;
+        }
     }
-    if (s->scope.find(name) != scope.end()) {
-        ASR::symbol_t *sym = s->scope.at(name);
-        LCOMPILERS_ASSERT(sym)
-        return sym;
-    } else {
-        // The `name` not found in the appropriate symbol table
-        return nullptr;
-    }
+    // nullptr if the `name` not found in the appropriate symbol table
+    return s->get_symbol(name);
 }
 
 std::string SymbolTable::get_unique_name(const std::string &name, bool use_unique_id) {
@@ -93,7 +155,7 @@ std::string SymbolTable::get_unique_name(const std::string &name, bool use_uniqu
         unique_name += "_" + lcompilers_unique_ID;
     }
     int counter = 1;
-    while (scope.find(unique_name) != scope.end()) {
+    while (get_symbol(unique_name) != nullptr) {
         unique_name = name + std::to_string(counter);
         counter++;
     }
@@ -2,6 +2,9 @@
 #define LFORTRAN_SEMANTICS_ASR_SCOPES_H
 
 #include <map>
+#include <vector>
+#include <string_view>
+#include <functional>
 
 #include <libasr/alloc.h>
 #include <libasr/containers.h>
@@ -16,8 +19,41 @@ namespace ASR {
 
 struct SymbolTable {
     private:
+    // Sorted by name, so that the iteration order (used by serialization
+    // and the backends) is deterministic
     std::map<std::string, ASR::symbol_t*> scope;
 
+    // Hash table (open addressing, linear probing) over the items of
+    // `scope` that is used for the lookups. Empty or a power of two in size.
+    struct IndexEntry {
+        size_t hash;
+        std::pair<const std::string, ASR::symbol_t*> *item;
+    };
+    std::vector<IndexEntry> index;
+    size_t n_index = 0;
+
+    static size_t hash(std::string_view name) {
+        return std::hash<std::string_view>()(name);
+    }
+
+    // Returns the position of `name` in `index`, or -1 if not found
+    int64_t index_find(std::string_view name, size_t h) const {
+        if (index.empty()) {
+            return -1;
+        }
+        size_t mask = index.size() - 1;
+        for (size_t i = h & mask; index[i].item; i = (i + 1) & mask) {
+            if (index[i].hash == h && index[i].item->first == name) {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    void index_insert(std::pair<const std::string, ASR::symbol_t*> *item,
+        size_t h);
+    void index_erase(size_t i);
+
     public:
     SymbolTable *parent;
     // The ASR node (either symbol_t or TranslationUnit_t) that contains this
@@ -28,6 +64,9 @@ struct SymbolTable {
     unsigned int counter;
 
     SymbolTable(SymbolTable *parent);
+    // `index` points into `scope`
+    SymbolTable(const SymbolTable&) = delete;
+    SymbolTable& operator=(const SymbolTable&) = delete;
 
     // Determines a stable hash based on the content of the symbol table
     uint32_t get_hash_uint32(); // Returns the hash as an integer
@@ -37,16 +76,17 @@ struct SymbolTable {
     static void reset_global_counter(); // Resets the internal global counter
 
     // Resolves the symbol `name` recursively in current and parent scopes.
-    // Returns `nullptr` if symbol not found.
-    ASR::symbol_t* resolve_symbol(const std::string &name) {
-        if (scope.find(name) == scope.end()) {
-            if (parent) {
-                return parent->resolve_symbol(name);
-            } else {
-                return nullptr;
+    // Returns `nullptr` if symbol not found. The lookups take a string_view,
+    // so that looking up an ASR name (`char*`) does not create a string.
+    ASR::symbol_t* resolve_symbol(std::string_view name) {
+        size_t h = hash(name);
+        for (SymbolTable *s = this; s != nullptr; s = s->parent) {
+            int64_t i = s->index_find(name, h);
+            if (i >= 0) {
+                return s->index[i].item->second;
             }
         }
-        return scope[name];
+        return nullptr;
     }
 
     const std::map<std::string, ASR::symbol_t*>& get_scope() const {
@@ -55,44 +95,37 @@ struct SymbolTable {
 
     // Obtains the symbol `name` from the current symbol table
     // Returns `nullptr` if symbol not found.
-    ASR::symbol_t* get_symbol(const std::string &name) const {
-        //auto it = scope.find(to_lower(name));
-        auto it = scope.find(name);
-        if (it == scope.end()) {
+    ASR::symbol_t* get_symbol(std::string_view name) const {
+        int64_t i = index_find(name, hash(name));
+        if (i < 0) {
             return nullptr;
         } else {
-            return it->second;
+            return index[i].item->second;
         }
     }
 
-    void erase_symbol(const std::string &name) {
-        //auto it = scope.find(to_lower(name));
-        LCOMPILERS_ASSERT(scope.find(name) != scope.end())
-        scope.erase(name);
-    }
+    void erase_symbol(std::string_view name);
 
     // Add a new symbol that did not exist before
     void add_symbol(const std::string &name, ASR::symbol_t* symbol) {
-        LCOMPILERS_ASSERT(scope.find(name) == scope.end())
-        scope[name] = symbol;
+        LCOMPILERS_ASSERT(get_symbol(name) == nullptr)
+        add_or_overwrite_symbol(name, symbol);
     }
 
     // Overwrite an existing symbol
     void overwrite_symbol(const std::string &name, ASR::symbol_t* symbol) {
-        LCOMPILERS_ASSERT(scope.find(name) != scope.end())
-        scope[name] = symbol;
+        LCOMPILERS_ASSERT(get_symbol(name) != nullptr)
+        add_or_overwrite_symbol(name, symbol);
     }
 
     // Use as the last resort, prefer to always either add a new symbol
     // or overwrite an existing one, not both
-    void add_or_overwrite_symbol(const std::string &name, ASR::symbol_t* symbol) {
-        scope[name] = symbol;
-    }
+    void add_or_overwrite_symbol(const std::string &name, ASR::symbol_t* symbol);
 
     // Marks all variables as external
     void mark_all_variables_external(Allocator &al);
 
-    ASR::symbol_t *find_scoped_symbol(const std::string &name,
+    ASR::symbol_t *find_scoped_symbol(std::string_view name,
         size_t n_scope_names, char **m_scope_names);
 
     std::string get_unique_name(const std::string &name, bool use_unique_id=true);
@@ -288,42 +288,102 @@ ASR::Module_t* extract_module(const ASR::TranslationUnit_t &m) {
     throw LCompilersException("ICE: Module not found");
 }
 
+// Loads more symbols of the module `m` that was loaded only partially from
+// its modfile: the `symbols` (and what they need) or all the remaining ones
+// if `symbols` is nullptr. Returns the number of loaded symbols.
+static size_t load_module_symbols(Allocator &al, ASR::Module_t &m,
+        const std::vector<std::string> *symbols) {
+    std::vector<ASR::symbol_t*> loaded = load_modfile_symbols(al, m,
+        symbols);
+    if (m.m_intrinsic) {
+        for (auto &sym : loaded) {
+            set_intrinsic(sym);
+        }
+    }
+    return loaded.size();
+}
+
+// The ExternalSymbols that are not resolved yet and point to the modules
+// that were loaded only partially
+class PartiallyLoadedSymbolsVisitor :
+    public ASR::BaseWalkVisitor<PartiallyLoadedSymbolsVisitor>
+{
+public:
+    SymbolTable *global_symtab;
+    std::map<ASR::Module_t*, std::vector<std::string>> symbols;
+
+    PartiallyLoadedSymbolsVisitor(SymbolTable *symtab)
+        : global_symtab{symtab} {}
+
+    void visit_ExternalSymbol(const ASR::ExternalSymbol_t &x) {
+        if (x.m_external != nullptr) {
+            return;
+        }
+        std::string module_name = x.m_module_name;
+        if (startswith(module_name, "lfortran_intrinsic_iso")) {
+            module_name = module_name.substr(19);
+        }
+        ASR::symbol_t *m = global_symtab->get_symbol(module_name);
+        if (m && ASR::is_a<ASR::Module_t>(*m) && is_module_partially_loaded(
+                *ASR::down_cast<ASR::Module_t>(m))) {
+            symbols[ASR::down_cast<ASR::Module_t>(m)].push_back(
+                x.n_scope_names > 0 ? x.m_scope_names[0] : x.m_original_name);
+        }
+    }
+};
+
+/*
+    Loads the module `module_name` into `symtab` from its modfile (if it is
+    not there yet) together with all the modules it depends on.
+
+    If `symbols` is given, only these symbols of the module (and the symbols
+    of the module that they need) are loaded if the modfile allows it, the
+    rest is loaded later when needed. Otherwise the whole module is loaded.
+*/
 ASR::Module_t* load_module(Allocator &al, SymbolTable *symtab,
                             const std::string &module_name,
                             const Location &loc, bool intrinsic,
                             LCompilers::PassOptions& pass_options,
                             bool run_verify,
-                            const std::function<void (const std::string &, const Location &)> err) {
+                            const std::function<void (const std::string &, const Location &)> err,
+                            const std::vector<std::string> *symbols) {
     LCOMPILERS_ASSERT(symtab);
+    ASR::Module_t *mod2 = nullptr;
     if (symtab->get_symbol(module_name) != nullptr) {
         ASR::symbol_t *m = symtab->get_symbol(module_name);
         if (ASR::is_a<ASR::Module_t>(*m)) {
-            return ASR::down_cast<ASR::Module_t>(m);
+            mod2 = ASR::down_cast<ASR::Module_t>(m);
+            if (!is_module_partially_loaded(*mod2)) {
+                return mod2;
+            }
+            load_module_symbols(al, *mod2, symbols);
         } else {
             err("The symbol '" + module_name + "' is not a module", loc);
         }
     }
-    LCOMPILERS_ASSERT(symtab->parent == nullptr);
-    ASR::TranslationUnit_t *mod1 = find_and_load_module(al, module_name,
-            *symtab, intrinsic, pass_options);
-    if (mod1 == nullptr && !intrinsic) {
-        // Module not found as a regular module. Try intrinsic module
-        if (module_name == "iso_c_binding"
-            ||module_name == "iso_fortran_env"
-            ||module_name == "ieee_arithmetic") {
-            mod1 = find_and_load_module(al, "lfortran_intrinsic_" + module_name,
-                *symtab, true, pass_options);
+    if (mod2 == nullptr) {
+        LCOMPILERS_ASSERT(symtab->parent == nullptr);
+        ASR::TranslationUnit_t *mod1 = find_and_load_module(al, module_name,
+                *symtab, intrinsic, pass_options, symbols);
+        if (mod1 == nullptr && !intrinsic) {
+            // Module not found as a regular module. Try intrinsic module
+            if (module_name == "iso_c_binding"
+                ||module_name == "iso_fortran_env"
+                ||module_name == "ieee_arithmetic") {
+                mod1 = find_and_load_module(al, "lfortran_intrinsic_" + module_name,
+                    *symtab, true, pass_options, symbols);
+            }
         }
+        if (mod1 == nullptr) {
+            err("Module '" + module_name + "' not declared in the current source and the modfile was not found",
+                loc);
+        }
+        mod2 = extract_module(*mod1);
+        symtab->add_symbol(module_name, (ASR::symbol_t*)mod2);
+        mod2->m_symtab->parent = symtab;
+        mod2->m_loaded_from_mod = true;
+        LCOMPILERS_ASSERT(symtab->resolve_symbol(module_name));
     }
-    if (mod1 == nullptr) {
-        err("Module '" + module_name + "' not declared in the current source and the modfile was not found",
-            loc);
-    }
-    ASR::Module_t *mod2 = extract_module(*mod1);
-    symtab->add_symbol(module_name, (ASR::symbol_t*)mod2);
-    mod2->m_symtab->parent = symtab;
-    mod2->m_loaded_from_mod = true;
-    LCOMPILERS_ASSERT(symtab->resolve_symbol(module_name));
 
     // Create a temporary TranslationUnit just for fixing the symbols
     ASR::asr_t *orig_asr_owner = symtab->asr_owner;
@@ -380,6 +440,20 @@ ASR::Module_t* load_module(Allocator &al, SymbolTable *symtab,
         }
     }
 
+    // Load the symbols of partially loaded modules that the loaded symbols
+    // need
+    while (true) {
+        PartiallyLoadedSymbolsVisitor v(symtab);
+        v.visit_TranslationUnit(*tu);
+        size_t n_loaded = 0;
+        for (auto &item : v.symbols) {
+            n_loaded += load_module_symbols(al, *item.first, &item.second);
+        }
+        if (n_loaded == 0) {
+            break;
+        }
+    }
+
     // Fix all external symbols
     fix_external_symbols(*tu, *symtab);
     PassUtils::UpdateDependenciesVisitor v(al);
@@ -436,9 +510,8 @@ void set_intrinsic(ASR::TranslationUnit_t* trans_unit) {
     }
 }
 
-ASR::TranslationUnit_t* find_and_load_module(Allocator &al, const std::string &msym,
-                                                SymbolTable &symtab, bool intrinsic,
-                                                LCompilers::PassOptions& pass_options) {
+std::shared_ptr<const MappedFile> find_modfile(const std::string &msym,
+        const LCompilers::PassOptions& pass_options) {
     std::filesystem::path runtime_library_dir { pass_options.runtime_library_dir };
     std::filesystem::path filename {msym + ".mod"};
     std::vector<std::filesystem::path> mod_files_dirs;
@@ -450,19 +523,39 @@ ASR::TranslationUnit_t* find_and_load_module(Allocator &al, const std::string &m
                           pass_options.include_dirs.end());
 
     for (auto path : mod_files_dirs) {
-        std::string modfile;
         std::filesystem::path full_path = path / filename;
-        if (read_file(full_path.string(), modfile)) {
-            ASR::TranslationUnit_t *asr = load_modfile(al, modfile, false, symtab);
-            if (intrinsic) {
-                set_intrinsic(asr);
-            }
-            return asr;
+        std::shared_ptr<const MappedFile> modfile = map_file(
+            full_path.string());
+        if (modfile) {
+            return modfile;
         }
     }
     return nullptr;
 }
 
+ASR::TranslationUnit_t* find_and_load_module(Allocator &al, const std::string &msym,
+                                                SymbolTable &symtab, bool intrinsic,
+                                                LCompilers::PassOptions& pass_options,
+                                                const std::vector<std::string> *symbols) {
+    std::shared_ptr<const MappedFile> modfile = find_modfile(msym,
+        pass_options);
+    if (modfile) {
+        std::shared_ptr<const Modfile> parsed = get_modfile(modfile);
+        ASR::TranslationUnit_t *asr = nullptr;
+        if (symbols) {
+            asr = load_modfile_lazy(al, parsed, *symbols);
+        }
+        if (asr == nullptr) {
+            asr = load_modfile(al, *parsed, false, symtab);
+        }
+        if (intrinsic) {
+            set_intrinsic(asr);
+        }
+        return asr;
+    }
+    return nullptr;
+}
+
 ASR::asr_t* getStructInstanceMember_t(Allocator& al, const Location& loc,
                             ASR::asr_t* v_var, ASR::symbol_t *v,
                             ASR::symbol_t* member, SymbolTable* current_scope) {
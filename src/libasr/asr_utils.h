@@ -1979,11 +1979,21 @@ ASR::Module_t* load_module(Allocator &al, SymbolTable *symtab,
                             const Location &loc, bool intrinsic,
                             LCompilers::PassOptions& pass_options,
                             bool run_verify,
-                            const std::function<void (const std::string &, const Location &)> err);
+                            const std::function<void (const std::string &, const Location &)> err,
+                            const std::vector<std::string> *symbols=nullptr);
 
+// Maps the modfile of module `msym` from the first directory of the modfile
+// search path that has it (see map_file()). Returns nullptr if it was not
+// found.
+std::shared_ptr<const MappedFile> find_modfile(const std::string &msym,
+    const LCompilers::PassOptions& pass_options);
+
+// If `symbols` is given, only these symbols (and the symbols of the module
+// that they need) are loaded if the modfile allows it
 ASR::TranslationUnit_t* find_and_load_module(Allocator &al, const std::string &msym,
                                                 SymbolTable &symtab, bool intrinsic,
-                                                LCompilers::PassOptions& pass_options);
+                                                LCompilers::PassOptions& pass_options,
+                                                const std::vector<std::string> *symbols=nullptr);
 
 void set_intrinsic(ASR::TranslationUnit_t* trans_unit);
 
@@ -3788,7 +3798,7 @@ class ReplaceArgVisitor: public ASR::BaseExprReplacer<ReplaceArgVisitor> {
             if (ASR::is_a<ASR::Module_t>(*sym)) {
                 m = ASR::down_cast<ASR::Module_t>(sym);
                 char *modname = m->m_name;
-                ASR::symbol_t *maybe_f = current_scope->resolve_symbol(std::string(f->m_name));
+                ASR::symbol_t *maybe_f = current_scope->resolve_symbol(f->m_name);
                 ASR::symbol_t* maybe_f_actual = nullptr;
                 std::string maybe_modname = "";
                 if( maybe_f && ASR::is_a<ASR::ExternalSymbol_t>(*maybe_f) ) {
@@ -4923,6 +4933,21 @@ static inline bool is_allocatable(ASR::ttype_t* type) {
     return ASR::is_a<ASR::Allocatable_t>(*type);
 }
 
+// Arrays whose elements are known to be contiguous in memory, so that they
+// can be passed to the runtime as a pointer to the first element. Sections,
+// pointers and assumed-shape arrays may be strided.
+static inline bool is_contiguous_array(ASR::ttype_t* type) {
+    if (!ASRUtils::is_array(type) || ASRUtils::is_pointer(type)) {
+        return false;
+    }
+    if (ASRUtils::is_allocatable(type)) {
+        return true;
+    }
+    ASR::array_physical_typeType physical_type = ASRUtils::extract_physical_type(type);
+    return physical_type == ASR::array_physical_typeType::FixedSizeArray ||
+        physical_type == ASR::array_physical_typeType::PointerToDataArray;
+}
+
 static inline void import_struct_t(Allocator& al,
     const Location& loc, ASR::ttype_t*& var_type,
     ASR::intentType intent, SymbolTable* current_scope) {
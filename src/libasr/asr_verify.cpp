@@ -394,9 +394,9 @@ public:
         SymbolTable *symtab = x.m_parent_symtab;
         require(symtab != nullptr,
             "ClassProcedure::m_parent_symtab cannot be nullptr");
-        require(symtab->get_symbol(std::string(x.m_name)) != nullptr,
+        require(symtab->get_symbol(x.m_name) != nullptr,
             "ClassProcedure '" + std::string(x.m_name) + "' not found in parent_symtab symbol table");
-        symbol_t *symtab_sym = symtab->get_symbol(std::string(x.m_name));
+        symbol_t *symtab_sym = symtab->get_symbol(x.m_name);
         const symbol_t *current_sym = &x.base;
         require(symtab_sym == current_sym,
             "ClassProcedure's parent symbol table does not point to it");
@@ -647,9 +647,9 @@ public:
         SymbolTable *symtab = x.m_parent_symtab;
         require(symtab != nullptr,
             "Variable::m_parent_symtab cannot be nullptr");
-        require(symtab->get_symbol(std::string(x.m_name)) != nullptr,
+        require(symtab->get_symbol(x.m_name) != nullptr,
             "Variable '" + std::string(x.m_name) + "' not found in parent_symtab symbol table");
-        symbol_t *symtab_sym = symtab->get_symbol(std::string(x.m_name));
+        symbol_t *symtab_sym = symtab->get_symbol(x.m_name);
         const symbol_t *current_sym = &x.base;
         require(symtab_sym == current_sym,
             "Variable's parent symbol table does not point to it");
@@ -765,13 +765,13 @@ public:
             if( m != nullptr && ((ASR::symbol_t*) m == ASRUtils::get_asr_owner(x.m_external)) ) {
                 s = m->m_symtab->find_scoped_symbol(x.m_original_name, x.n_scope_names, x.m_scope_names);
             } else if( sm ) {
-                s = sm->m_symtab->resolve_symbol(std::string(x.m_original_name));
+                s = sm->m_symtab->resolve_symbol(x.m_original_name);
             } else if( em ) {
-                s = em->m_symtab->resolve_symbol(std::string(x.m_original_name));
+                s = em->m_symtab->resolve_symbol(x.m_original_name);
             } else if( fm ) {
-                s = fm->m_symtab->resolve_symbol(std::string(x.m_original_name));
+                s = fm->m_symtab->resolve_symbol(x.m_original_name);
             } else if( um ) {
-                s = um->m_symtab->resolve_symbol(std::string(x.m_original_name));
+                s = um->m_symtab->resolve_symbol(x.m_original_name);
             }
             require(s != nullptr,
                 "ExternalSymbol::m_original_name ('"
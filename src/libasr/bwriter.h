@@ -3,6 +3,8 @@
 
 #include <sstream>
 #include <iomanip>
+#include <string_view>
+#include <cstring>
 
 #include <libasr/asr_utils.h>
 #include <libasr/exception.h>
@@ -170,13 +172,14 @@ public:
 
 };
 
+// The readers do not copy the input, it must outlive them
 class BinaryReader
 {
 private:
-    std::string s;
+    std::string_view s;
     size_t pos;
 public:
-    BinaryReader(const std::string &s) : s{s}, pos{0} {}
+    BinaryReader(std::string_view s) : s{s}, pos{0} {}
 
     uint8_t read_int8() {
         if (pos+1 > s.size()) {
@@ -214,16 +217,21 @@ public:
         return n;
     }
 
-    std::string read_string() {
+    // Returns a view into the input, without copying the string
+    std::string_view read_string_view() {
         size_t n = read_int64();
         if (pos+n > s.size()) {
             throw LCompilersException("read_string: String is too short for deserialization.");
         }
-        std::string r = std::string(&s[pos], n);
+        std::string_view r = s.substr(pos, n);
         pos += n;
         return r;
     }
 
+    std::string read_string() {
+        return std::string(read_string_view());
+    }
+
     double read_float64() {
         uint64_t x = read_int64();
         uint64_t *ip = &x;
@@ -232,17 +240,18 @@ public:
         return *dp;
     }
 
-    void* read_void(int64_t n_data) {
-        void *p = new char[n_data];
-
-        for (int64_t i = 0; i < n_data; i++) {
-            uint8_t x = read_int8();
-            uint8_t *ip = &x;
-            void *p_i = (void*)((uintptr_t)p + i);
-            uint8_t *p_i_8 = (uint8_t*)p_i;
-            *p_i_8 = *ip;
+    // Reads `n_data` bytes into `p`
+    void read_void(void *p, int64_t n_data) {
+        if (pos+n_data > s.size()) {
+            throw LCompilersException("read_void: String is too short for deserialization.");
         }
+        std::memcpy(p, &s[pos], n_data);
+        pos += n_data;
+    }
 
+    void* read_void(int64_t n_data) {
+        void *p = new char[n_data];
+        read_void(p, n_data);
         return p;
     }
 };
@@ -309,10 +318,10 @@ public:
 class TextReader
 {
 private:
-    std::string s;
+    std::string_view s;
     size_t pos;
 public:
-    TextReader(const std::string &s) : s{s}, pos{0} {}
+    TextReader(std::string_view s) : s{s}, pos{0} {}
 
     uint8_t read_int8() {
         uint64_t n = read_int64();
@@ -343,6 +352,9 @@ public:
 
     uint64_t read_int64() {
         std::string tmp;
+        if (pos >= s.size()) {
+            throw LCompilersException("read_int64: String is too short for deserialization.");
+        }
         while (s[pos] != ' ') {
             tmp += s[pos];
             if (! (s[pos] >= '0' && s[pos] <= '9')) {
@@ -360,6 +372,9 @@ public:
 
     double read_float64() {
         std::string tmp;
+        if (pos >= s.size()) {
+            throw LCompilersException("read_float64: String is too short for deserialization.");
+        }
         while (s[pos] != ' ') {
             tmp += s[pos];
             pos++;
@@ -372,23 +387,26 @@ public:
         return n;
     }
 
-    std::string read_string() {
+    std::string_view read_string_view() {
         size_t n = read_int64();
         if (pos+n > s.size()) {
             throw LCompilersException("read_string: String is too short for deserialization.");
         }
-        std::string r = std::string(&s[pos], n);
+        std::string_view r = s.substr(pos, n);
         pos += n;
-        if (s[pos] != ' ') {
+        if (pos >= s.size() || s[pos] != ' ') {
             throw LCompilersException("read_string: Space expected.");
         }
         pos ++;
         return r;
     }
 
-    void* read_void(int64_t n_data) {
-        void *p = new char[n_data];
+    std::string read_string() {
+        return std::string(read_string_view());
+    }
 
+    // Reads `n_data` bytes into `p`
+    void read_void(void *p, int64_t n_data) {
         for (int64_t i = 0; i < n_data; i++) {
             uint8_t x = read_int8();
             uint8_t *ip = &x;
@@ -396,7 +414,11 @@ public:
             uint8_t *p_i_8 = (uint8_t*)p_i;
             *p_i_8 = *ip;
         }
+    }
 
+    void* read_void(int64_t n_data) {
+        void *p = new char[n_data];
+        read_void(p, n_data);
         return p;
     }
 };
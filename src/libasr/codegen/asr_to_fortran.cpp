@@ -965,6 +965,18 @@ public:
             visit_expr(*x.m_form);
             r += src;
         }
+        if (x.m_access) {
+            r += ", ";
+            r += "access=";
+            visit_expr(*x.m_access);
+            r += src;
+        }
+        if (x.m_asynchronous) {
+            r += ", ";
+            r += "asynchronous=";
+            visit_expr(*x.m_asynchronous);
+            r += src;
+        }
         r += ")";
         handle_line_truncation(r, 2);
         r += "\n";
@@ -1004,7 +1016,7 @@ public:
             r += "fmt=";
             visit_expr(*x.m_fmt);
             r += src;
-        } else {
+        } else if (x.m_is_formatted) {
             r += ", *";
         }
         if (x.m_iomsg) {
@@ -1025,6 +1037,9 @@ public:
             visit_expr(*x.m_id);
             r += src;
         }
+        if (x.m_is_asynchronous) {
+            r += ", asynchronous=\"yes\"";
+        }
         r += ") ";
         for (size_t i = 0; i < x.n_values; i++) {
             visit_expr(*x.m_values[i]);
@@ -1042,6 +1057,28 @@ public:
 
     // void visit_FileInquire(const ASR::FileInquire_t &x) {}
 
+    void visit_FileWait(const ASR::FileWait_t &x) {
+        std::string r = indent;
+        r += "wait";
+        r += "(";
+        visit_expr(*x.m_unit);
+        r += src;
+        if (x.m_id) {
+            r += ", id=";
+            visit_expr(*x.m_id);
+            r += src;
+        }
+        if (x.m_iostat) {
+            r += ", iostat=";
+            visit_expr(*x.m_iostat);
+            r += src;
+        }
+        r += ")";
+        handle_line_truncation(r, 2);
+        r += "\n";
+        src = r;
+    }
+
     void visit_FileWrite(const ASR::FileWrite_t &x) {
         std::string r = indent;
         r += "write";
@@ -1057,6 +1094,17 @@ public:
                 src = "\"(" + src.substr(1, src.size()-2) + ")\"";
             }
             r += src;
+        } else if (!x.m_is_formatted) {
+            visit_expr(*x.m_unit);
+            r += src;
+            if (x.m_id) {
+                r += ", id=";
+                visit_expr(*x.m_id);
+                r += src;
+            }
+            if (x.m_is_asynchronous) {
+                r += ", asynchronous=\"yes\"";
+            }
         } else {
             r += "*";
         }
@@ -1248,6 +1296,7 @@ public:
         out = "call ";
         switch ( x.m_intrinsic_id ) {
             SET_INTRINSIC_SUBROUTINE_NAME(RandomNumber, "random_number");
+            SET_INTRINSIC_SUBROUTINE_NAME(RandomSeed, "random_seed");
             default : {
                 throw LCompilersException("IntrinsicImpureSubroutine: `"
                     + ASRUtils::get_intrinsic_name(x.m_intrinsic_id)
@@ -1255,10 +1304,21 @@ public:
             }
         }
         out += "(";
-        for (size_t i = 0; i < x.n_args; i ++) {
-            visit_expr(*x.m_args[i]);
-            out += src;
-            if (i < x.n_args-1) out += ", ";
+        if (x.m_intrinsic_id == static_cast<int64_t>(ASRUtils::IntrinsicImpureSubroutines::RandomSeed)) {
+            // The arguments are optional and only the present ones are stored
+            std::vector<std::string> kwarg_names = {"size", "put", "get"};
+            size_t i_arg = 0;
+            for (size_t i = 0; i < kwarg_names.size(); i++) {
+                if (!(x.m_overload_id & (1 << i))) continue;
+                visit_expr(*x.m_args[i_arg++]);
+                out += kwarg_names[i] + "=" + src;
+            }
+        } else {
+            for (size_t i = 0; i < x.n_args; i ++) {
+                visit_expr(*x.m_args[i]);
+                out += src;
+                if (i < x.n_args-1) out += ", ";
+            }
         }
         out += ")\n";
         src = out;
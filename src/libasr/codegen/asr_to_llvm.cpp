@@ -45,6 +45,7 @@
 #include <libasr/pass/pass_manager.h>
 #include <libasr/exception.h>
 #include <libasr/asr_utils.h>
+#include <libasr/fortran_format.h>
 #include <libasr/codegen/llvm_utils.h>
 #include <libasr/codegen/llvm_array_utils.h>
 #include <libasr/pass/intrinsic_function_registry.h>
@@ -204,6 +205,9 @@ public:
     std::vector<llvm::Value*> heap_arrays;
     std::map<llvm::Value*, llvm::Value*> strings_to_be_allocated; // (array, size)
     Vec<llvm::Value*> strings_to_be_deallocated;
+    // Set while generating a string operand that the enclosing string
+    // expression only reads; its temporary goes to the scratch arena
+    bool string_scratch_operand = false;
     struct to_be_allocated_array{ // struct to hold details for the initializing pointer_to_array_type later inside main function.
         llvm::Constant* pointer_to_array_type;
         llvm::Type* array_type;
@@ -590,8 +594,11 @@ public:
 
 
     llvm::Value* lfortran_strop(llvm::Value* left_arg, llvm::Value* right_arg,
-                                         std::string runtime_func_name)
+                                         std::string runtime_func_name, bool scratch=false)
     {
+        if (scratch) {
+            runtime_func_name += "_scratch";
+        }
         llvm::Function *fn = module->getFunction(runtime_func_name);
         if (!fn) {
             llvm::FunctionType *function_type = llvm::FunctionType::get(
@@ -613,10 +620,67 @@ public:
             nullptr);
         std::vector<llvm::Value*> args = {pleft_arg, pright_arg, presult};
         builder->CreateCall(fn, args);
-        strings_to_be_deallocated.push_back(al, CreateLoad(presult));
+        if (!scratch) {
+            strings_to_be_deallocated.push_back(al, CreateLoad(presult));
+        }
         return CreateLoad(presult);
     }
 
+    // String temporaries that are only read by the enclosing expression are
+    // allocated in the runtime's scratch arena. The outermost expression
+    // takes a mark before generating its operands and releases everything
+    // allocated after it once it has consumed them.
+    bool is_scratch_string_operand(ASR::expr_t* x) {
+        if (ASRUtils::expr_value(x) || ASRUtils::is_array(ASRUtils::expr_type(x))) {
+            return false;
+        }
+        return ASR::is_a<ASR::StringConcat_t>(*x) ||
+            ASR::is_a<ASR::StringSection_t>(*x) ||
+            ASR::is_a<ASR::StringItem_t>(*x);
+    }
+
+    llvm::Value* lfortran_string_scratch_mark() {
+        std::string runtime_func_name = "_lfortran_string_scratch_mark";
+        llvm::Function *fn = module->getFunction(runtime_func_name);
+        if (!fn) {
+            llvm::FunctionType *function_type = llvm::FunctionType::get(
+                    llvm::Type::getInt64Ty(context), {}, false);
+            fn = llvm::Function::Create(function_type,
+                    llvm::Function::ExternalLinkage, runtime_func_name, *module);
+        }
+        return builder->CreateCall(fn, {});
+    }
+
+    void lfortran_string_scratch_release(llvm::Value* mark) {
+        std::string runtime_func_name = "_lfortran_string_scratch_release";
+        llvm::Function *fn = module->getFunction(runtime_func_name);
+        if (!fn) {
+            llvm::FunctionType *function_type = llvm::FunctionType::get(
+                    llvm::Type::getVoidTy(context), {
+                        llvm::Type::getInt64Ty(context)
+                    }, false);
+            fn = llvm::Function::Create(function_type,
+                    llvm::Function::ExternalLinkage, runtime_func_name, *module);
+        }
+        builder->CreateCall(fn, {mark});
+    }
+
+    // Returns the scratch mark to release after `left` and `right` have been
+    // consumed, or nullptr if there is nothing to release
+    llvm::Value* string_scratch_mark_for(ASR::expr_t* left, ASR::expr_t* right) {
+        if (!is_scratch_string_operand(left) &&
+                !(right && is_scratch_string_operand(right))) {
+            return nullptr;
+        }
+        return lfortran_string_scratch_mark();
+    }
+
+    void visit_string_operand(ASR::expr_t* x) {
+        string_scratch_operand = is_scratch_string_operand(x);
+        this->visit_expr_wrapper(x, true);
+        string_scratch_operand = false;
+    }
+
     llvm::Value* lfortran_str_cmp(llvm::Value* left_arg, llvm::Value* right_arg,
                                          std::string runtime_func_name)
     {
@@ -727,9 +791,10 @@ public:
         return builder->CreateCall(fn, {str});
     }
 
-    llvm::Value* lfortran_str_item(llvm::Value* str, llvm::Value* idx1)
+    llvm::Value* lfortran_str_item(llvm::Value* str, llvm::Value* idx1, bool scratch=false)
     {
-        std::string runtime_func_name = "_lfortran_str_item";
+        std::string runtime_func_name = scratch ? "_lfortran_str_item_scratch"
+            : "_lfortran_str_item";
         llvm::Function *fn = module->getFunction(runtime_func_name);
         if (!fn) {
             llvm::FunctionType *function_type = llvm::FunctionType::get(
@@ -758,9 +823,11 @@ public:
     }
 
     llvm::Value* lfortran_str_slice(llvm::Value* str, llvm::Value* idx1, llvm::Value* idx2,
-                    llvm::Value* step, llvm::Value* left_present, llvm::Value* right_present)
+                    llvm::Value* step, llvm::Value* left_present, llvm::Value* right_present,
+                    bool scratch=false)
     {
-        std::string runtime_func_name = "_lfortran_str_slice";
+        std::string runtime_func_name = scratch ? "_lfortran_str_slice_scratch"
+            : "_lfortran_str_slice";
         llvm::Function *fn = module->getFunction(runtime_func_name);
         if (!fn) {
             llvm::FunctionType *function_type = llvm::FunctionType::get(
@@ -4384,6 +4451,20 @@ public:
 
     void handle_array_section_association_to_pointer(const ASR::Associate_t& x) {
         ASR::ArraySection_t* array_section = ASR::down_cast<ASR::ArraySection_t>(x.m_value);
+        llvm::Value* target = create_array_section_descriptor(*array_section);
+        int64_t ptr_loads_copy = ptr_loads;
+        ptr_loads = 0;
+        visit_expr(*x.m_target);
+        llvm::Value* target_desc = tmp;
+        ptr_loads = ptr_loads_copy;
+        builder->CreateStore(target, target_desc);
+    }
+
+    // Returns a new descriptor of `array_section`, which points into the
+    // data of the sectioned array
+    llvm::Value* create_array_section_descriptor(
+            const ASR::ArraySection_t& section) {
+        const ASR::ArraySection_t* array_section = &section;
         ASR::ttype_t* value_array_type = ASRUtils::expr_type(array_section->m_v);
 
         int64_t ptr_loads_copy = ptr_loads;
@@ -4395,9 +4476,6 @@ public:
                 ASR::array_physical_typeType::FixedSizeArray ) {
             value_desc = LLVM::CreateLoad(*builder, value_desc);
         }
-        ptr_loads = 0;
-        visit_expr(*x.m_target);
-        llvm::Value* target_desc = tmp;
         ptr_loads = ptr_loads_copy;
 
         llvm::BasicBlock &entry_block = builder->GetInsertBlock()->getParent()->getEntryBlock();
@@ -4465,7 +4543,7 @@ public:
                 lbs.p, ubs.p, ds.p, non_sliced_indices.p,
                 array_section->n_args, target_rank);
         }
-        builder->CreateStore(target, target_desc);
+        return target;
     }
 
     void visit_Associate(const ASR::Associate_t& x) {
@@ -5717,11 +5795,12 @@ public:
             this->visit_expr_wrapper(x.m_value, true);
             return;
         }
+        llvm::Value *scratch_mark = string_scratch_mark_for(x.m_left, x.m_right);
         int64_t ptr_loads_copy = ptr_loads;
         ptr_loads = 1;
-        this->visit_expr_wrapper(x.m_left, true);
+        visit_string_operand(x.m_left);
         llvm::Value *left = tmp;
-        this->visit_expr_wrapper(x.m_right, true);
+        visit_string_operand(x.m_right);
         llvm::Value *right = tmp;
         ptr_loads = ptr_loads_copy;
         bool is_single_char = (ASR::is_a<ASR::StringItem_t>(*x.m_left) &&
@@ -5729,6 +5808,9 @@ public:
         if( is_single_char ) {
             left = LLVM::CreateLoad(*builder, left);
             right = LLVM::CreateLoad(*builder, right);
+            if (scratch_mark) {
+                lfortran_string_scratch_release(scratch_mark);
+            }
         }
         std::string fn;
         switch (x.m_op) {
@@ -5786,6 +5868,9 @@ public:
             }
         }
         tmp = lfortran_str_cmp(left, right, fn);
+        if (scratch_mark) {
+            lfortran_string_scratch_release(scratch_mark);
+        }
     }
 
     void visit_LogicalCompare(const ASR::LogicalCompare_t &x) {
@@ -6057,21 +6142,30 @@ public:
     }
 
     void visit_StringConcat(const ASR::StringConcat_t &x) {
+        bool scratch = string_scratch_operand;
+        string_scratch_operand = false;
         if (x.m_value) {
             this->visit_expr_wrapper(x.m_value, true);
             return;
         }
 
+        // The operands of a chain of concatenations are scratch temporaries,
+        // only the final result is allocated with malloc
+        llvm::Value *scratch_mark = scratch ? nullptr
+            : string_scratch_mark_for(x.m_left, x.m_right);
         int ptr_loads_copy = ptr_loads;
         ptr_loads = 2 - LLVM::is_llvm_pointer(*ASRUtils::expr_type(x.m_left));
-        this->visit_expr_wrapper(x.m_left, true);
+        visit_string_operand(x.m_left);
         llvm::Value *left_val = tmp;
 
         ptr_loads = 2 - LLVM::is_llvm_pointer(*ASRUtils::expr_type(x.m_right));
-        this->visit_expr_wrapper(x.m_right, true);
+        visit_string_operand(x.m_right);
         ptr_loads = ptr_loads_copy;
         llvm::Value *right_val = tmp;
-        tmp = lfortran_strop(left_val, right_val, "_lfortran_strcat");
+        tmp = lfortran_strop(left_val, right_val, "_lfortran_strcat", scratch);
+        if (scratch_mark) {
+            lfortran_string_scratch_release(scratch_mark);
+        }
     }
 
     void visit_StringLen(const ASR::StringLen_t &x) {
@@ -6079,9 +6173,10 @@ public:
             this->visit_expr_wrapper(x.m_value, true);
             return;
         }
+        llvm::Value *scratch_mark = string_scratch_mark_for(x.m_arg, nullptr);
         int ptr_loads_copy = ptr_loads;
         ptr_loads = 2 - LLVM::is_llvm_pointer(*ASRUtils::expr_type(x.m_arg));
-        this->visit_expr_wrapper(x.m_arg, true);
+        visit_string_operand(x.m_arg);
         ptr_loads = ptr_loads_copy;
         llvm::AllocaInst *parg = builder->CreateAlloca(character_type, nullptr);
         builder->CreateStore(tmp, parg);
@@ -6089,6 +6184,9 @@ public:
         tmp = builder->CreateSExtOrTrunc(
             lfortran_str_len(parg, ASRUtils::is_array(arg_type)),
             llvm_utils->get_type_from_ttype_t_util(x.m_type, module.get()));
+        if (scratch_mark) {
+            lfortran_string_scratch_release(scratch_mark);
+        }
     }
 
     void visit_StringOrd(const ASR::StringOrd_t &x) {
@@ -6112,6 +6210,8 @@ public:
     }
 
     void visit_StringItem(const ASR::StringItem_t& x) {
+        bool scratch = string_scratch_operand;
+        string_scratch_operand = false;
         if (x.m_value) {
             this->visit_expr_wrapper(x.m_value, true);
             return;
@@ -6129,12 +6229,16 @@ public:
             std::vector<llvm::Value*> idx_vec = {idx};
             tmp = CreateGEP(str, idx_vec);
         } else {
-            tmp = lfortran_str_item(str, idx);
-            strings_to_be_deallocated.push_back(al, tmp);
+            tmp = lfortran_str_item(str, idx, scratch);
+            if (!scratch) {
+                strings_to_be_deallocated.push_back(al, tmp);
+            }
         }
     }
 
     void visit_StringSection(const ASR::StringSection_t& x) {
+        bool scratch = string_scratch_operand;
+        string_scratch_operand = false;
         if (x.m_value) {
             this->visit_expr_wrapper(x.m_value, true);
             return;
@@ -6173,7 +6277,8 @@ public:
             step = llvm::ConstantInt::get(context,
                 llvm::APInt(32, 1));
         }
-        tmp = lfortran_str_slice(str, left, right, step, left_present, right_present);
+        tmp = lfortran_str_slice(str, left, right, step, left_present, right_present,
+            scratch);
     }
 
     void visit_RealCopySign(const ASR::RealCopySign_t& x) {
@@ -7447,7 +7552,13 @@ public:
                 std::string runtime_func_name;
                 llvm::Type *type_arg;
                 int a_kind = ASRUtils::extract_kind_from_ttype_t(type);
-                if (a_kind == 4) {
+                if (a_kind == 1) {
+                    runtime_func_name = "_lfortran_read_int8";
+                    type_arg = llvm::Type::getInt8Ty(context);
+                } else if (a_kind == 2) {
+                    runtime_func_name = "_lfortran_read_int16";
+                    type_arg = llvm::Type::getInt16Ty(context);
+                } else if (a_kind == 4) {
                     runtime_func_name = "_lfortran_read_int32";
                     type_arg = llvm::Type::getInt32Ty(context);
                 } else if (a_kind == 8) {
@@ -7506,6 +7617,22 @@ public:
                 }
                 break;
             }
+            case (ASR::ttypeType::Complex): {
+                int a_kind = ASRUtils::extract_kind_from_ttype_t(type);
+                std::string runtime_func_name = a_kind == 4 ?
+                    "_lfortran_read_complex_float" : "_lfortran_read_complex_double";
+                fn = module->getFunction(runtime_func_name);
+                if (!fn) {
+                    llvm::FunctionType *function_type = llvm::FunctionType::get(
+                            llvm::Type::getVoidTy(context), {
+                                llvm_utils->getComplexType(a_kind, true),
+                                llvm::Type::getInt32Ty(context)
+                            }, false);
+                    fn = llvm::Function::Create(function_type,
+                            llvm::Function::ExternalLinkage, runtime_func_name, *module);
+                }
+                break;
+            }
             case (ASR::ttypeType::Array): {
                 type = ASRUtils::type_get_past_array(type);
                 int a_kind = ASRUtils::extract_kind_from_ttype_t(type);
@@ -7515,11 +7642,17 @@ public:
                     if (a_kind == 1) {
                         runtime_func_name = "_lfortran_read_array_int8";
                         type_arg = llvm::Type::getInt8Ty(context);
+                    } else if (a_kind == 2) {
+                        runtime_func_name = "_lfortran_read_array_int16";
+                        type_arg = llvm::Type::getInt16Ty(context);
                     } else if (a_kind == 4) {
                         runtime_func_name = "_lfortran_read_array_int32";
                         type_arg = llvm::Type::getInt32Ty(context);
+                    } else if (a_kind == 8) {
+                        runtime_func_name = "_lfortran_read_array_int64";
+                        type_arg = llvm::Type::getInt64Ty(context);
                     } else {
-                        throw CodeGenError("Integer arrays of kind 1 or 4 only supported for now. Found kind: "
+                        throw CodeGenError("Integer arrays of kind 1, 2, 4 or 8 only supported for now. Found kind: "
                                             + std::to_string(a_kind));
                     }
                 } else if (ASR::is_a<ASR::Real_t>(*type)) {
@@ -7533,6 +7666,10 @@ public:
                         throw CodeGenError("Real arrays of kind 4 or 8 only supported for now. Found kind: "
                                             + std::to_string(a_kind));
                     }
+                } else if (ASR::is_a<ASR::Complex_t>(*type)) {
+                    runtime_func_name = a_kind == 4 ? "_lfortran_read_array_complex_float"
+                        : "_lfortran_read_array_complex_double";
+                    type_arg = llvm_utils->getComplexType(a_kind);
                 } else if (ASR::is_a<ASR::Character_t>(*type)) {
                     if (ASR::down_cast<ASR::Character_t>(type)->m_len != 1) {
                         throw CodeGenError("Only `character(len=1)` array "
@@ -7564,11 +7701,266 @@ public:
         return fn;
     }
 
+    // Whether `v` can be transferred by `_lfortran_unformatted_write` and
+    // `_lfortran_unformatted_read`: scalars of intrinsic type and whole
+    // arrays or array sections of numbers or logicals, which the runtime
+    // walks through their descriptors
+    bool is_unformatted_item(ASR::expr_t* v) {
+        ASR::ttype_t* type = ASRUtils::expr_type(v);
+        ASR::ttype_t* el_type = ASRUtils::type_get_past_array(
+            ASRUtils::type_get_past_allocatable(
+                ASRUtils::type_get_past_pointer(type)));
+        bool is_number = ASRUtils::is_integer(*el_type) ||
+            ASRUtils::is_unsigned_integer(*el_type) ||
+            ASRUtils::is_real(*el_type) || ASRUtils::is_complex(*el_type) ||
+            ASRUtils::is_logical(*el_type);
+        if (!ASRUtils::is_array(type)) {
+            // Deferred length strings may not be allocated
+            return is_number || (ASRUtils::is_character(*el_type) &&
+                !ASRUtils::is_allocatable(type) &&
+                !ASR::is_a<ASR::Pointer_t>(*type));
+        }
+        if (ASR::is_a<ASR::ArraySection_t>(*v)) {
+            // Sectioned like in `create_array_section_descriptor`
+            ASR::ArraySection_t* section = ASR::down_cast<ASR::ArraySection_t>(v);
+            if (section->m_value) {
+                return false;
+            }
+            for (size_t i = 0; i < section->n_args; i++) {
+                ASR::array_index_t &arg = section->m_args[i];
+                if (arg.m_right == nullptr ||
+                        (arg.m_step && arg.m_left == nullptr)) {
+                    return false;
+                }
+            }
+            v = section->m_v;
+            type = ASRUtils::expr_type(v);
+        }
+        if (!is_number || !ASR::is_a<ASR::Var_t>(*v)) {
+            return false;
+        }
+        switch (ASRUtils::extract_physical_type(type)) {
+            case ASR::array_physical_typeType::DescriptorArray: {
+                return true;
+            }
+            case ASR::array_physical_typeType::FixedSizeArray:
+            case ASR::array_physical_typeType::PointerToDataArray: {
+                // The descriptor is built from the dimensions, which are
+                // not known for assumed size arrays
+                ASR::dimension_t* m_dims = nullptr;
+                size_t n_dims = ASRUtils::extract_dimensions_from_ttype(type, m_dims);
+                for (size_t i = 0; i < n_dims; i++) {
+                    if (m_dims[i].m_start == nullptr || m_dims[i].m_length == nullptr) {
+                        return false;
+                    }
+                }
+                return true;
+            }
+            default: {
+                return false;
+            }
+        }
+    }
+
+    // Bytes that an element of type `type`, stored in `size` bytes, takes in
+    // an unformatted record: logicals are stored in one byte, but written
+    // with the size of their kind, like gfortran does
+    uint64_t unformatted_record_size(ASR::ttype_t* type, uint64_t size) {
+        ASR::ttype_t* el_type = ASRUtils::type_get_past_array(
+            ASRUtils::type_get_past_allocatable(
+                ASRUtils::type_get_past_pointer(type)));
+        if (ASRUtils::is_logical(*el_type)) {
+            return ASRUtils::extract_kind_from_ttype_t(el_type);
+        }
+        return size;
+    }
+
+    // Declared length of the character scalar `v` as an i64, or -1 for an
+    // assumed length, for which the runtime takes the length of the string
+    llvm::Value* unformatted_string_length(ASR::expr_t* v) {
+        llvm::Type* i64 = llvm::Type::getInt64Ty(context);
+        ASR::Character_t* t = ASR::down_cast<ASR::Character_t>(
+            ASRUtils::type_get_past_pointer(ASRUtils::expr_type(v)));
+        if (t->m_len >= 0) {
+            return llvm::ConstantInt::get(i64, t->m_len);
+        }
+        if (t->m_len_expr) {
+            this->visit_expr_wrapper(t->m_len_expr, true);
+            return builder->CreateSExtOrTrunc(tmp, i64);
+        }
+        return llvm::ConstantInt::get(i64, -1);
+    }
+
+    /*
+    Transfers the I/O list `m_values` as one record of an unformatted unit
+    with a single call to `_lfortran_unformatted_write` or
+    `_lfortran_unformatted_read`. Every item is passed as its rank, element
+    size, record element size and data pointer, arrays also with the offset
+    and dimension descriptors, so that the runtime copies whole arrays at
+    once instead of one element per call. Character scalars pass their
+    length as the record element size.
+
+    An asynchronous transfer calls `_lfortran_unformatted_write_async` or
+    `_lfortran_unformatted_read_async` instead, which also store the
+    identifier of the pending transfer in `m_id`, if present.
+    */
+    void unformatted_transfer(ASR::expr_t* m_unit, ASR::expr_t* m_iostat,
+            ASR::expr_t* m_id, ASR::expr_t** m_values, size_t n_values,
+            bool read, bool asynchronous) {
+        llvm::Type* i32 = llvm::Type::getInt32Ty(context);
+        llvm::Type* i64 = llvm::Type::getInt64Ty(context);
+        llvm::Type* i8_ptr = llvm::Type::getInt8PtrTy(context);
+        llvm::DataLayout data_layout(module.get());
+        std::vector<llvm::Value*> args;
+        int64_t ptr_loads_copy = ptr_loads;
+        ptr_loads = 1;
+        this->visit_expr_wrapper(m_unit, true);
+        ptr_loads = ptr_loads_copy;
+        args.push_back(tmp);
+        if (m_iostat) {
+            ptr_loads = 0;
+            this->visit_expr_wrapper(m_iostat, false);
+            ptr_loads = ptr_loads_copy;
+            args.push_back(tmp);
+        } else {
+            args.push_back(llvm::Constant::getNullValue(i32->getPointerTo()));
+        }
+        llvm::Value *id = nullptr, *id_i32 = nullptr;
+        if (asynchronous) {
+            if (m_id) {
+                ptr_loads = 0;
+                this->visit_expr_wrapper(m_id, false);
+                ptr_loads = ptr_loads_copy;
+                id = tmp;
+                id_i32 = id;
+                if (id->getType()->getPointerElementType() != i32) {
+                    id_i32 = builder->CreateAlloca(i32, nullptr);
+                }
+                args.push_back(id_i32);
+            } else {
+                args.push_back(llvm::Constant::getNullValue(i32->getPointerTo()));
+            }
+        }
+        args.push_back(llvm::ConstantInt::get(i32, n_values));
+        for (size_t i = 0; i < n_values; i++) {
+            ASR::expr_t* v = m_values[i];
+            ASR::ttype_t* type = ASRUtils::expr_type(v);
+            if (ASRUtils::is_array(type)) {
+                llvm::Value* descriptor = get_io_array_descriptor(v);
+                llvm::Value* data = LLVM::CreateLoad(*builder,
+                    arr_descr->get_pointer_to_data(descriptor));
+                uint64_t size = data_layout.getTypeAllocSize(
+                    data->getType()->getPointerElementType());
+                args.push_back(llvm::ConstantInt::get(i32,
+                    ASRUtils::extract_n_dims_from_ttype(type)));
+                args.push_back(llvm::ConstantInt::get(i64, size));
+                args.push_back(llvm::ConstantInt::get(i64,
+                    unformatted_record_size(type, size)));
+                args.push_back(builder->CreateBitCast(data, i8_ptr));
+                args.push_back(arr_descr->get_offset(descriptor));
+                args.push_back(arr_descr->get_pointer_to_dimension_descriptor_array(
+                    descriptor));
+                continue;
+            }
+            bool is_character = ASRUtils::is_character(*type);
+            llvm::Value* data;
+            if (read) {
+                ptr_loads = 0;
+                this->visit_expr(*v);
+                ptr_loads = ptr_loads_copy;
+                data = tmp;
+                if (is_character || LLVM::is_llvm_pointer(*type)) {
+                    data = LLVM::CreateLoad(*builder, data);
+                }
+            } else {
+                ptr_loads = 2;
+                if (ASR::is_a<ASR::Var_t>(*v)) {
+                    ASR::Variable_t* var = ASRUtils::EXPR2VAR(v);
+                    if (LLVM::is_llvm_pointer(*var->m_type)) {
+                        ptr_loads = 1;
+                    }
+                    ptr_loads -= var->m_intent == ASRUtils::intent_in;
+                }
+                this->visit_expr_wrapper(v, true);
+                ptr_loads = ptr_loads_copy;
+                load_non_array_non_character_pointers(v, type, tmp);
+                data = tmp;
+                if (!is_character) {
+                    data = builder->CreateAlloca(tmp->getType(), nullptr);
+                    builder->CreateStore(tmp, data);
+                }
+            }
+            uint64_t size = is_character ? 0 : data_layout.getTypeAllocSize(
+                data->getType()->getPointerElementType());
+            args.push_back(llvm::ConstantInt::get(i32, 0));
+            args.push_back(llvm::ConstantInt::get(i64, size));
+            args.push_back(is_character ? unformatted_string_length(v)
+                : llvm::ConstantInt::get(i64, unformatted_record_size(type, size)));
+            args.push_back(builder->CreateBitCast(data, i8_ptr));
+        }
+        std::string runtime_func_name = read ? "_lfortran_unformatted_read"
+            : "_lfortran_unformatted_write";
+        std::vector<llvm::Type*> fixed_args = {i32, i32->getPointerTo(), i32};
+        if (asynchronous) {
+            runtime_func_name += "_async";
+            fixed_args.insert(fixed_args.begin() + 2, i32->getPointerTo());
+        }
+        llvm::Function *fn = module->getFunction(runtime_func_name);
+        if (!fn) {
+            llvm::FunctionType *function_type = llvm::FunctionType::get(
+                    llvm::Type::getVoidTy(context), fixed_args, true);
+            fn = llvm::Function::Create(function_type,
+                    llvm::Function::ExternalLinkage, runtime_func_name, *module);
+        }
+        tmp = builder->CreateCall(fn, args);
+        if (id != id_i32) {
+            builder->CreateStore(builder->CreateSExtOrTrunc(
+                LLVM::CreateLoad(*builder, id_i32),
+                id->getType()->getPointerElementType()), id);
+        }
+    }
+
+    // Whether the unformatted transfer `x` can be done by
+    // `unformatted_transfer`, otherwise it is done item by item
+    template <typename T>
+    bool is_bulk_unformatted_transfer(const T &x) {
+        if (x.m_is_formatted || x.m_unit == nullptr ||
+                !ASRUtils::is_integer(*ASRUtils::expr_type(x.m_unit))) {
+            return false;
+        }
+        for (size_t i = 0; i < x.n_values; i++) {
+            if (!is_unformatted_item(x.m_values[i])) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Data transfers that are not done asynchronously have completed when
+    // the statement ends, which `_lfortran_wait` reports for the id 0
+    void store_synchronous_transfer_id(ASR::expr_t* m_id) {
+        if (m_id == nullptr) {
+            return;
+        }
+        int64_t ptr_loads_copy = ptr_loads;
+        ptr_loads = 0;
+        this->visit_expr_wrapper(m_id, false);
+        ptr_loads = ptr_loads_copy;
+        builder->CreateStore(llvm::ConstantInt::get(
+            tmp->getType()->getPointerElementType(), 0), tmp);
+    }
+
     void visit_FileRead(const ASR::FileRead_t &x) {
         if( x.m_overloaded ) {
             this->visit_stmt(*x.m_overloaded);
             return ;
         }
+        if (is_bulk_unformatted_transfer(x)) {
+            unformatted_transfer(x.m_unit, x.m_iostat, x.m_id, x.m_values,
+                x.n_values, true, x.m_is_asynchronous);
+            return;
+        }
+        store_synchronous_transfer_id(x.m_id);
 
         llvm::Value *unit_val, *iostat, *read_size;
         bool is_string = false;
@@ -7707,7 +8099,8 @@ public:
 
     void visit_FileOpen(const ASR::FileOpen_t &x) {
         llvm::Value *unit_val = nullptr, *f_name = nullptr;
-        llvm::Value *status = nullptr, *form = nullptr;
+        llvm::Value *status = nullptr, *form = nullptr, *access = nullptr;
+        llvm::Value *asynchronous = nullptr;
         this->visit_expr_wrapper(x.m_newunit, true);
         unit_val = tmp;
         int ptr_copy = ptr_loads;
@@ -7732,6 +8125,20 @@ public:
         } else {
             form = llvm::Constant::getNullValue(character_type);
         }
+        if (x.m_access) {
+            ptr_loads = 1;
+            this->visit_expr_wrapper(x.m_access);
+            access = tmp;
+        } else {
+            access = llvm::Constant::getNullValue(character_type);
+        }
+        if (x.m_asynchronous) {
+            ptr_loads = 1;
+            this->visit_expr_wrapper(x.m_asynchronous);
+            asynchronous = tmp;
+        } else {
+            asynchronous = llvm::Constant::getNullValue(character_type);
+        }
         ptr_loads = ptr_copy;
         std::string runtime_func_name = "_lfortran_open";
         llvm::Function *fn = module->getFunction(runtime_func_name);
@@ -7739,12 +8146,14 @@ public:
             llvm::FunctionType *function_type = llvm::FunctionType::get(
                     llvm::Type::getInt64Ty(context), {
                         llvm::Type::getInt32Ty(context),
-                        character_type, character_type, character_type
+                        character_type, character_type, character_type,
+                        character_type, character_type
                     }, false);
             fn = llvm::Function::Create(function_type,
                     llvm::Function::ExternalLinkage, runtime_func_name, *module);
         }
-        tmp = builder->CreateCall(fn, {unit_val, f_name, status, form});
+        tmp = builder->CreateCall(fn, {unit_val, f_name, status, form, access,
+            asynchronous});
     }
 
     void visit_FileInquire(const ASR::FileInquire_t &x) {
@@ -7818,6 +8227,40 @@ public:
         builder->CreateCall(fn, {unit_val});
     }
 
+    void visit_FileWait(const ASR::FileWait_t& x) {
+        llvm::Type* i32 = llvm::Type::getInt32Ty(context);
+        std::string runtime_func_name = "_lfortran_wait";
+        llvm::Function *fn = module->getFunction(runtime_func_name);
+        if (!fn) {
+            llvm::FunctionType *function_type = llvm::FunctionType::get(
+                    llvm::Type::getVoidTy(context), {
+                        i32, i32, i32->getPointerTo()
+                    }, false);
+            fn = llvm::Function::Create(function_type,
+                    llvm::Function::ExternalLinkage, runtime_func_name, *module);
+        }
+        this->visit_expr_wrapper(x.m_unit, true);
+        llvm::Value *unit_val = tmp;
+        llvm::Value *id = nullptr, *iostat = nullptr;
+        if (x.m_id) {
+            this->visit_expr_wrapper(x.m_id, true);
+            id = builder->CreateSExtOrTrunc(tmp, i32);
+        } else {
+            // Waits for all pending transfers of the unit
+            id = llvm::ConstantInt::get(i32, -1);
+        }
+        if (x.m_iostat) {
+            int ptr_copy = ptr_loads;
+            ptr_loads = 0;
+            this->visit_expr_wrapper(x.m_iostat, false);
+            ptr_loads = ptr_copy;
+            iostat = tmp;
+        } else {
+            iostat = llvm::Constant::getNullValue(i32->getPointerTo());
+        }
+        builder->CreateCall(fn, {unit_val, id, iostat});
+    }
+
     void visit_FileRewind(const ASR::FileRewind_t &x) {
         std::string runtime_func_name = "_lfortran_rewind";
         llvm::Function *fn = module->getFunction(runtime_func_name);
@@ -7879,6 +8322,12 @@ public:
             handle_print(x);
             return;
         }
+        if (is_bulk_unformatted_transfer(x)) {
+            unformatted_transfer(x.m_unit, x.m_iostat, x.m_id, x.m_values,
+                x.n_values, false, x.m_is_asynchronous);
+            return;
+        }
+        store_synchronous_transfer_id(x.m_id);
         std::vector<llvm::Value *> args;
         std::vector<llvm::Type *> args_type;
         std::vector<std::string> fmt;
@@ -9899,11 +10348,183 @@ public:
         }
     }
 
+    // Must match `enum _lfortran_format_type` in lfortran_intrinsics.h
+    enum FormatItemType {
+        FormatInt8 = 0, FormatInt16 = 1, FormatInt32 = 2, FormatInt64 = 3,
+        FormatReal32 = 4, FormatReal64 = 5, FormatComplex32 = 6,
+        FormatComplex64 = 7, FormatLogical = 8, FormatCharacter = 9
+    };
+
+    // Returns the descriptor of the whole array or array section `arg`,
+    // building one for arrays that are not stored with a descriptor
+    llvm::Value* get_io_array_descriptor(ASR::expr_t* arg) {
+        if (ASR::is_a<ASR::ArraySection_t>(*arg)) {
+            return create_array_section_descriptor(
+                *ASR::down_cast<ASR::ArraySection_t>(arg));
+        }
+        ASR::ttype_t* arg_type = ASRUtils::expr_type(arg);
+        ASR::array_physical_typeType physical_type =
+            ASRUtils::extract_physical_type(arg_type);
+        int64_t ptr_loads_copy = ptr_loads;
+        ptr_loads = 2 - LLVM::is_llvm_pointer(*arg_type);
+        visit_expr_wrapper(arg, false);
+        ptr_loads = ptr_loads_copy;
+        if (physical_type != ASR::array_physical_typeType::DescriptorArray) {
+            ASR::ttype_t* descriptor_type = ASRUtils::duplicate_type(al,
+                ASRUtils::type_get_past_allocatable(
+                    ASRUtils::type_get_past_pointer(arg_type)), nullptr,
+                ASR::array_physical_typeType::DescriptorArray, true);
+            visit_ArrayPhysicalCastUtil(tmp, arg, descriptor_type, arg_type,
+                physical_type, ASR::array_physical_typeType::DescriptorArray);
+        }
+        llvm::Value* descriptor = tmp;
+        if (descriptor->getType()->getNumContainedTypes() > 0 &&
+            descriptor->getType()->getContainedType(0)->isPointerTy()) {
+            descriptor = LLVM::CreateLoad(*builder, descriptor);
+        }
+        return descriptor;
+    }
+
+    /*
+    Formats the arguments of `x` with a single call to
+    `_lcompilers_string_format_fortran_array`, or to
+    `_lcompilers_string_format_fortran_compiled` if `compiled_format` is not
+    empty. Every argument is passed as its type and rank followed by either
+    the scalar value or the data pointer, offset and dimension descriptors
+    of the array.
+    */
+    void string_format_fortran_items(const ASR::StringFormat_t& x,
+            const std::vector<uint8_t> &compiled_format) {
+        std::vector<llvm::Value *> args;
+        if (compiled_format.empty()) {
+            visit_expr(*x.m_fmt);
+            args.push_back(tmp);
+        } else {
+            // The bytecode contains zeros, the string is passed with its size
+            args.push_back(builder->CreateGlobalStringPtr(llvm::StringRef(
+                reinterpret_cast<const char*>(compiled_format.data()),
+                compiled_format.size())));
+        }
+        args.push_back(llvm::ConstantInt::get(llvm::Type::getInt32Ty(context),
+            x.n_args));
+        llvm::Type* i32 = llvm::Type::getInt32Ty(context);
+        for (size_t i=0; i<x.n_args; i++) {
+            ASR::expr_t* arg = x.m_args[i];
+            ASR::ttype_t* arg_type = ASRUtils::expr_type(arg);
+            ASR::ttype_t* el_type = ASRUtils::type_get_past_array(
+                ASRUtils::type_get_past_allocatable(
+                    ASRUtils::type_get_past_pointer(arg_type)));
+            int kind = ASRUtils::extract_kind_from_ttype_t(el_type);
+            if (!ASRUtils::is_array(arg_type)) {
+                std::vector<std::string> fmt;
+                std::vector<llvm::Value *> values;
+                compute_fmt_specifier_and_arg(fmt, values, arg, x.base.base.loc);
+                int type;
+                if (ASRUtils::is_character(*el_type)) {
+                    type = FormatCharacter;
+                } else if (ASRUtils::is_logical(*el_type)) {
+                    // Passed as "True" or "False", like for
+                    // _lcompilers_string_format_fortran
+                    type = FormatLogical;
+                } else if (ASRUtils::is_complex(*el_type)) {
+                    type = FormatComplex64;
+                } else if (ASRUtils::is_real(*el_type)) {
+                    type = FormatReal64;
+                } else {
+                    type = FormatInt64;
+                    if (ASRUtils::is_unsigned_integer(*el_type)) {
+                        values[0] = builder->CreateZExt(values[0],
+                            llvm::Type::getInt64Ty(context));
+                    } else {
+                        values[0] = builder->CreateSExt(values[0],
+                            llvm::Type::getInt64Ty(context));
+                    }
+                }
+                args.push_back(llvm::ConstantInt::get(i32, type));
+                args.push_back(llvm::ConstantInt::get(i32, 0));
+                args.insert(args.end(), values.begin(), values.end());
+                continue;
+            }
+
+            int type;
+            if (ASRUtils::is_integer(*el_type)) {
+                switch (kind) {
+                    case 1: type = FormatInt8; break;
+                    case 2: type = FormatInt16; break;
+                    case 4: type = FormatInt32; break;
+                    default: type = FormatInt64; break;
+                }
+            } else if (ASRUtils::is_real(*el_type)) {
+                type = kind == 4 ? FormatReal32 : FormatReal64;
+            } else if (ASRUtils::is_complex(*el_type)) {
+                type = kind == 4 ? FormatComplex32 : FormatComplex64;
+            } else if (ASRUtils::is_logical(*el_type)) {
+                type = FormatLogical;
+            } else {
+                throw CodeGenError("Formatted output of arrays of `" +
+                    ASRUtils::type_to_str(el_type) + "` type is not supported.",
+                    arg->base.loc);
+            }
+
+            llvm::Value* descriptor = get_io_array_descriptor(arg);
+            llvm::Value* data = LLVM::CreateLoad(*builder,
+                arr_descr->get_pointer_to_data(descriptor));
+            args.push_back(llvm::ConstantInt::get(i32, type));
+            args.push_back(llvm::ConstantInt::get(i32,
+                ASRUtils::extract_n_dims_from_ttype(arg_type)));
+            args.push_back(builder->CreateBitCast(data,
+                llvm::Type::getInt8PtrTy(context)));
+            args.push_back(arr_descr->get_offset(descriptor));
+            args.push_back(arr_descr->get_pointer_to_dimension_descriptor_array(
+                descriptor));
+        }
+        if (compiled_format.empty()) {
+            tmp = string_format_fortran_array(context, *module, *builder, args);
+        } else {
+            tmp = string_format_fortran_compiled(context, *module, *builder, args);
+        }
+    }
+
+    // Whether `x` can be formatted by `string_format_fortran_items`
+    bool has_format_item_types(const ASR::StringFormat_t& x) {
+        for (size_t i=0; i<x.n_args; i++) {
+            ASR::ttype_t* type = ASRUtils::type_get_past_array(
+                ASRUtils::type_get_past_allocatable(
+                    ASRUtils::type_get_past_pointer(
+                        ASRUtils::expr_type(x.m_args[i]))));
+            if (!ASRUtils::is_integer(*type) &&
+                    !ASRUtils::is_unsigned_integer(*type) &&
+                    !ASRUtils::is_real(*type) && !ASRUtils::is_complex(*type) &&
+                    !ASRUtils::is_logical(*type) &&
+                    !ASRUtils::is_character(*type)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
     void visit_StringFormat(const ASR::StringFormat_t& x) {
-        // TODO: Handle some things at compile time if possible:
-        //ASR::expr_t* fmt_value = ASRUtils::expr_value(x.m_fmt);
-        // if (fmt_value) ...
         if (x.m_kind == ASR::string_format_kindType::FormatFortran) {
+            // Constant formats are parsed here, once, and only interpreted
+            // at runtime
+            ASR::expr_t* fmt_value = ASRUtils::expr_value(x.m_fmt);
+            if (fmt_value == nullptr) fmt_value = x.m_fmt;
+            std::vector<uint8_t> compiled_format;
+            if (ASR::is_a<ASR::StringConstant_t>(*fmt_value) &&
+                    has_format_item_types(x) &&
+                    compile_fortran_format(
+                        ASR::down_cast<ASR::StringConstant_t>(fmt_value)->m_s,
+                        compiled_format)) {
+                string_format_fortran_items(x, compiled_format);
+                return;
+            }
+            for (size_t i=0; i<x.n_args; i++) {
+                if (ASRUtils::is_array(ASRUtils::expr_type(x.m_args[i]))) {
+                    // Left in place by the print_arr pass
+                    string_format_fortran_items(x, compiled_format);
+                    return;
+                }
+            }
             std::vector<llvm::Value *> args;
             visit_expr(*x.m_fmt);
             args.push_back(tmp);
@@ -9963,6 +10584,7 @@ Result<std::unique_ptr<LLVMModule>> asr_to_llvm(ASR::TranslationUnit_t &asr,
     co.po.run_fun = run_fn;
     co.po.always_run = false;
     co.po.skip_optimization_func_instantiation = skip_optimization_func_instantiation;
+    co.po.formatted_array_io = true;
     pass_manager.rtlib = co.rtlib;
     pass_manager.apply_passes(al, &asr, co.po, diagnostics);
 
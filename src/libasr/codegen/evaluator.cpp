@@ -1,5 +1,6 @@
 #include <iostream>
 #include <fstream>
+#include <thread>
 
 #include <llvm/IR/LLVMContext.h>
 #include <llvm/ADT/STLExtras.h>
@@ -48,13 +49,17 @@
 #include <llvm/ADT/StringRef.h>
 #include <llvm/Target/TargetOptions.h>
 #include <llvm/Support/Host.h>
+#include <llvm/Transforms/Utils/SplitModule.h>
+#include <llvm/Bitcode/BitcodeReader.h>
+#include <llvm/Bitcode/BitcodeWriter.h>
 #if LLVM_VERSION_MAJOR >= 14
 #    include <llvm/MC/TargetRegistry.h>
 #else
 #    include <llvm/Support/TargetRegistry.h>
 #endif
 #if LLVM_VERSION_MAJOR >= 17
-    // TODO: removed from LLVM 17
+#    include <llvm/Passes/PassBuilder.h>
+#    include <llvm/Passes/OptimizationLevel.h>
 #else
 #    include <llvm/Transforms/IPO/PassManagerBuilder.h>
 #endif
@@ -141,6 +146,22 @@ float _lfortran_stan(float x);
 
 }
 
+// A TargetMachine must not be shared by threads, each thread that compiles
+// a module in parallel creates its own
+static llvm::TargetMachine* create_target_machine(
+        const std::string &target_triple) {
+    std::string Error;
+    const llvm::Target *target = llvm::TargetRegistry::lookupTarget(target_triple, Error);
+    if (!target) {
+        throw LCompilersException(Error);
+    }
+    std::string CPU = "generic";
+    std::string features = "";
+    llvm::TargetOptions opt;
+    RM_OPTIONAL_TYPE<llvm::Reloc::Model> RM = llvm::Reloc::Model::PIC_;
+    return target->createTargetMachine(target_triple, CPU, features, opt, RM);
+}
+
 LLVMEvaluator::LLVMEvaluator(const std::string &t)
 {
     llvm::InitializeNativeTarget();
@@ -176,16 +197,7 @@ LLVMEvaluator::LLVMEvaluator(const std::string &t)
     else
         target_triple = LLVMGetDefaultTargetTriple();
 
-    std::string Error;
-    const llvm::Target *target = llvm::TargetRegistry::lookupTarget(target_triple, Error);
-    if (!target) {
-        throw LCompilersException(Error);
-    }
-    std::string CPU = "generic";
-    std::string features = "";
-    llvm::TargetOptions opt;
-    RM_OPTIONAL_TYPE<llvm::Reloc::Model> RM = llvm::Reloc::Model::PIC_;
-    TM = target->createTargetMachine(target_triple, CPU, features, opt, RM);
+    TM = create_target_machine(target_triple);
 
     // For some reason the JIT requires a different TargetMachine
     jit = cantFail(llvm::orc::KaleidoscopeJIT::Create());
@@ -300,10 +312,8 @@ void LLVMEvaluator::save_asm_file(llvm::Module &m, const std::string &filename)
     write_file(filename, get_asm(m));
 }
 
-void LLVMEvaluator::save_object_file(llvm::Module &m, const std::string &filename) {
-    m.setTargetTriple(target_triple);
-    m.setDataLayout(TM->createDataLayout());
-
+static void emit_object_file(llvm::TargetMachine *TM, llvm::Module &m,
+        const std::string &filename) {
     llvm::legacy::PassManager pass;
     llvm::CodeGenFileType ft = llvm::CGFT_ObjectFile;
     std::error_code EC;
@@ -318,38 +328,88 @@ void LLVMEvaluator::save_object_file(llvm::Module &m, const std::string &filenam
     dest.flush();
 }
 
+void LLVMEvaluator::save_object_file(llvm::Module &m, const std::string &filename) {
+    m.setTargetTriple(target_triple);
+    m.setDataLayout(TM->createDataLayout());
+    emit_object_file(TM, m, filename);
+}
+
 void LLVMEvaluator::create_empty_object_file(const std::string &filename) {
     std::string source;
     std::unique_ptr<llvm::Module> module = parse_module(source);
     save_object_file(*module, filename);
 }
 
-void LLVMEvaluator::opt(llvm::Module &m) {
-    m.setTargetTriple(target_triple);
-    m.setDataLayout(TM->createDataLayout());
+static void optimize_module(llvm::TargetMachine *TM, llvm::Module &m,
+        int opt_level, int size_level) {
+    // Loop vectorization is enabled from -O2 on (and for -Os), the SLP
+    // vectorizer only for -O2 and -O3, the same as Clang does.
+    bool loop_vectorize = opt_level >= 2 && size_level < 2;
+    bool slp_vectorize = opt_level >= 2 && size_level == 0;
+    bool unroll_loops = opt_level >= 2;
 
+#if LLVM_VERSION_MAJOR >= 17
+    llvm::PipelineTuningOptions PTO;
+    PTO.LoopUnrolling = unroll_loops;
+    PTO.LoopInterleaving = loop_vectorize;
+    PTO.LoopVectorization = loop_vectorize;
+    PTO.SLPVectorization = slp_vectorize;
+
+    llvm::LoopAnalysisManager LAM;
+    llvm::FunctionAnalysisManager FAM;
+    llvm::CGSCCAnalysisManager CGAM;
+    llvm::ModuleAnalysisManager MAM;
+
+    // The PassBuilder registers the TargetIRAnalysis of `TM`, so that the
+    // cost model of the vectorizers is the one of the actual target
+    llvm::PassBuilder PB(TM, PTO);
+    PB.registerModuleAnalyses(MAM);
+    PB.registerCGSCCAnalyses(CGAM);
+    PB.registerFunctionAnalyses(FAM);
+    PB.registerLoopAnalyses(LAM);
+    PB.crossRegisterProxies(LAM, FAM, CGAM, MAM);
+
+    llvm::ModulePassManager MPM;
+    if (opt_level == 0 && size_level == 0) {
+        MPM = PB.buildO0DefaultPipeline(llvm::OptimizationLevel::O0);
+    } else {
+        llvm::OptimizationLevel level;
+        if (size_level == 1) {
+            level = llvm::OptimizationLevel::Os;
+        } else if (size_level >= 2) {
+            level = llvm::OptimizationLevel::Oz;
+        } else if (opt_level == 1) {
+            level = llvm::OptimizationLevel::O1;
+        } else if (opt_level == 2) {
+            level = llvm::OptimizationLevel::O2;
+        } else {
+            level = llvm::OptimizationLevel::O3;
+        }
+        MPM = PB.buildPerModuleDefaultPipeline(level);
+    }
+    MPM.addPass(llvm::VerifierPass());
+    MPM.run(m, MAM);
+#else
     llvm::legacy::PassManager mpm;
     mpm.add(new llvm::TargetLibraryInfoWrapperPass(TM->getTargetTriple()));
     mpm.add(llvm::createTargetTransformInfoWrapperPass(TM->getTargetIRAnalysis()));
     llvm::legacy::FunctionPassManager fpm(&m);
     fpm.add(llvm::createTargetTransformInfoWrapperPass(TM->getTargetIRAnalysis()));
 
-    int optLevel = 3;
-    int sizeLevel = 0;
-#if LLVM_VERSION_MAJOR >= 17
-    // TODO: https://llvm.org/docs/NewPassManager.html
-#else
     llvm::PassManagerBuilder builder;
-    builder.OptLevel = optLevel;
-    builder.SizeLevel = sizeLevel;
-    builder.Inliner = llvm::createFunctionInliningPass(optLevel, sizeLevel,
-        false);
-    builder.DisableUnrollLoops = false;
-    builder.LoopVectorize = true;
-    builder.SLPVectorize = true;
+    builder.OptLevel = opt_level;
+    builder.SizeLevel = size_level;
+    if (opt_level > 0 || size_level > 0) {
+        builder.Inliner = llvm::createFunctionInliningPass(opt_level,
+            size_level, false);
+    } else {
+        builder.Inliner = llvm::createAlwaysInlinerLegacyPass();
+    }
+    builder.DisableUnrollLoops = !unroll_loops;
+    builder.LoopVectorize = loop_vectorize;
+    builder.SLPVectorize = slp_vectorize;
     builder.populateFunctionPassManager(fpm);
     builder.populateModulePassManager(mpm);
-#endif
 
     fpm.doInitialization();
     for (llvm::Function &func : m) {
@@ -359,6 +419,69 @@ void LLVMEvaluator::opt(llvm::Module &m) {
 
     mpm.add(llvm::createVerifierPass());
     mpm.run(m);
+#endif
+}
+
+void LLVMEvaluator::opt(llvm::Module &m, int opt_level, int size_level) {
+    m.setTargetTriple(target_triple);
+    m.setDataLayout(TM->createDataLayout());
+    optimize_module(TM, m, opt_level, size_level);
+}
+
+std::vector<std::string> LLVMEvaluator::save_object_files_parallel(
+        llvm::Module &m, const std::string &filename, size_t n_parts,
+        int opt_level, int size_level) {
+    m.setTargetTriple(target_triple);
+    m.setDataLayout(TM->createDataLayout());
+
+    // The parts are moved to their own LLVMContext (an LLVMContext can only
+    // be used by one thread) through bitcode. The local symbols are kept in
+    // the part that uses them, so that they stay local in the object files.
+    std::vector<llvm::SmallVector<char, 0>> parts;
+    llvm::SplitModule(m, n_parts, [&](std::unique_ptr<llvm::Module> part) {
+        parts.emplace_back();
+        llvm::raw_svector_ostream os(parts.back());
+        llvm::WriteBitcodeToFile(*part, os);
+    }, true);
+
+    std::vector<std::string> filenames;
+    for (size_t i = 0; i < parts.size(); i++) {
+        filenames.push_back(filename + "." + std::to_string(i) + ".o");
+    }
+    std::vector<std::exception_ptr> errors(parts.size());
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < parts.size(); i++) {
+        threads.emplace_back([&, i]() {
+            try {
+                llvm::LLVMContext part_context;
+                llvm::Expected<std::unique_ptr<llvm::Module>> part
+                    = llvm::parseBitcodeFile(llvm::MemoryBufferRef(
+                        llvm::StringRef(parts[i].data(), parts[i].size()),
+                        filenames[i]), part_context);
+                if (!part) {
+                    llvm::consumeError(part.takeError());
+                    throw LCompilersException("save_object_files_parallel(): "
+                        "failed to read a part of the module");
+                }
+                std::unique_ptr<llvm::TargetMachine> part_TM(
+                    create_target_machine(target_triple));
+                if (opt_level > 0 || size_level > 0) {
+                    optimize_module(part_TM.get(), **part, opt_level,
+                        size_level);
+                }
+                emit_object_file(part_TM.get(), **part, filenames[i]);
+            } catch (...) {
+                errors[i] = std::current_exception();
+            }
+        });
+    }
+    for (auto &t : threads) {
+        t.join();
+    }
+    for (auto &e : errors) {
+        if (e) std::rethrow_exception(e);
+    }
+    return filenames;
 }
 
 std::string LLVMEvaluator::module_to_string(llvm::Module &m) {
@@ -4,6 +4,7 @@
 #include <complex>
 #include <iostream>
 #include <memory>
+#include <vector>
 
 #include <libasr/alloc.h>
 #include <libasr/asr_scopes.h>
@@ -56,7 +57,16 @@ public:
     void save_asm_file(llvm::Module &m, const std::string &filename);
     void save_object_file(llvm::Module &m, const std::string &filename);
     void create_empty_object_file(const std::string &filename);
-    void opt(llvm::Module &m);
+    // Runs the LLVM optimization pipeline; `opt_level` is 0-3 (-O0 ... -O3),
+    // `size_level` is 1 for -Os and 2 for -Oz
+    void opt(llvm::Module &m, int opt_level = 3, int size_level = 0);
+    // Splits `m` into (up to) `n_parts` modules, which are optimized (unless
+    // both levels are 0) and compiled in parallel to the object files
+    // `filename.<i>.o`. Returns the names of the object files. `m` is left
+    // unoptimized. Procedures are not inlined across the parts.
+    std::vector<std::string> save_object_files_parallel(llvm::Module &m,
+        const std::string &filename, size_t n_parts, int opt_level,
+        int size_level);
     static std::string module_to_string(llvm::Module &m);
     static void print_version_message();
     llvm::LLVMContext &get_context();
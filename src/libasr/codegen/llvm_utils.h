@@ -96,6 +96,36 @@ namespace LCompilers {
         return builder.CreateCall(fn_printf, args);
     }
 
+    static inline llvm::Value* string_format_fortran_array(llvm::LLVMContext &context, llvm::Module &module,
+        llvm::IRBuilder<> &builder, const std::vector<llvm::Value*> &args)
+    {
+        llvm::Function *fn = module.getFunction("_lcompilers_string_format_fortran_array");
+        if (!fn) {
+            llvm::FunctionType *function_type = llvm::FunctionType::get(
+                    llvm::Type::getInt8PtrTy(context),
+                    {llvm::Type::getInt8PtrTy(context),
+                    llvm::Type::getInt32Ty(context)}, true);
+            fn = llvm::Function::Create(function_type,
+                    llvm::Function::ExternalLinkage, "_lcompilers_string_format_fortran_array", &module);
+        }
+        return builder.CreateCall(fn, args);
+    }
+
+    static inline llvm::Value* string_format_fortran_compiled(llvm::LLVMContext &context, llvm::Module &module,
+        llvm::IRBuilder<> &builder, const std::vector<llvm::Value*> &args)
+    {
+        llvm::Function *fn = module.getFunction("_lcompilers_string_format_fortran_compiled");
+        if (!fn) {
+            llvm::FunctionType *function_type = llvm::FunctionType::get(
+                    llvm::Type::getInt8PtrTy(context),
+                    {llvm::Type::getInt8PtrTy(context),
+                    llvm::Type::getInt32Ty(context)}, true);
+            fn = llvm::Function::Create(function_type,
+                    llvm::Function::ExternalLinkage, "_lcompilers_string_format_fortran_compiled", &module);
+        }
+        return builder.CreateCall(fn, args);
+    }
+
     static inline llvm::Value* lfortran_str_copy(llvm::Value* dest, llvm::Value *src, bool is_allocatable,
         llvm::Module &module, llvm::IRBuilder<> &builder, llvm::LLVMContext &context) {
         std::string runtime_func_name = "_lfortran_strcpy";
@@ -0,0 +1,295 @@
+#include <cctype>
+
+#include <libasr/fortran_format.h>
+
+namespace LCompilers {
+
+namespace {
+
+class FormatCompiler {
+    std::string s;
+    size_t pos = 0;
+    std::vector<uint8_t> &code;
+    int repeat_depth = 0;
+
+public:
+    FormatCompiler(const std::string &s, std::vector<uint8_t> &code)
+        : s{s}, code{code} {}
+
+    bool compile() {
+        if (s.size() >= 2 && s.front() == '(' && s.back() == ')') {
+            s = s.substr(1, s.size() - 2);
+        }
+        // Format reversion continues at the last top level group, or at the
+        // start of the format if it has no groups
+        size_t last_group = std::string::npos;
+        while (pos < s.size()) {
+            if (!compile_item(&last_group)) return false;
+        }
+        emit(FormatOp::End);
+        if (last_group != std::string::npos) {
+            code.insert(code.begin() + last_group,
+                static_cast<uint8_t>(FormatOp::Reversion));
+        }
+        return true;
+    }
+
+private:
+    char peek() {
+        return pos < s.size() ? std::tolower(static_cast<unsigned char>(s[pos])) : '\0';
+    }
+
+    void emit(FormatOp op) {
+        code.push_back(static_cast<uint8_t>(op));
+    }
+
+    void emit_operand(uint32_t n) {
+        // Unsigned LEB128
+        do {
+            uint8_t byte = n & 0x7f;
+            n >>= 7;
+            if (n != 0) byte |= 0x80;
+            code.push_back(byte);
+        } while (n != 0);
+    }
+
+    bool parse_number(uint32_t &n) {
+        if (!std::isdigit(peek())) return false;
+        uint64_t value = 0;
+        while (std::isdigit(peek())) {
+            value = value * 10 + (s[pos++] - '0');
+            if (value > UINT32_MAX / 2) return false;
+        }
+        n = value;
+        return true;
+    }
+
+    // Compiles one item of a format list; `last_group` is set to where a
+    // group starts when compiling the top level list, nullptr otherwise
+    bool compile_item(size_t *last_group) {
+        char c = peek();
+        if (c == ',') {
+            pos++;
+            return true;
+        }
+        if (c == '/') {
+            pos++;
+            emit(FormatOp::Newline);
+            return true;
+        }
+        if (c == '\'' || c == '"') {
+            return compile_literal();
+        }
+        if (c == '*') {
+            pos++;
+            if (peek() != '(') return false;
+            emit(FormatOp::Unlimited);
+            if (last_group) *last_group = code.size();
+            return compile_group(1);
+        }
+        if (c == '(') {
+            if (last_group) *last_group = code.size();
+            return compile_group(1);
+        }
+        if (c == '-' || std::isdigit(c)) {
+            bool negative = c == '-';
+            if (negative) pos++;
+            uint32_t n;
+            if (!parse_number(n)) return false;
+            c = peek();
+            if (c == 'p') {
+                pos++;
+                emit(FormatOp::Scale);
+                emit_operand(negative);
+                emit_operand(n);
+                return true;
+            }
+            if (negative || n == 0) return false;
+            if (c == '(') {
+                if (last_group) *last_group = code.size();
+                return compile_group(n);
+            }
+            if (c == 'x') {
+                pos++;
+                emit(FormatOp::Space);
+                emit_operand(n);
+                return true;
+            }
+            if (c == '/') {
+                pos++;
+                for (uint32_t i = 0; i < n; i++) emit(FormatOp::Newline);
+                return true;
+            }
+            if (n == 1) return compile_descriptor();
+            if (repeat_depth == max_format_repeat_depth) return false;
+            emit(FormatOp::Repeat);
+            emit_operand(n);
+            if (!compile_descriptor()) return false;
+            emit(FormatOp::RepeatEnd);
+            return true;
+        }
+        if (c == 'x') {
+            pos++;
+            emit(FormatOp::Space);
+            emit_operand(1);
+            return true;
+        }
+        if (c == 't') {
+            pos++;
+            // TL and TR are not supported
+            uint32_t n;
+            if (!parse_number(n)) return false;
+            emit(FormatOp::Tab);
+            emit_operand(n);
+            return true;
+        }
+        return compile_descriptor();
+    }
+
+    bool compile_group(uint32_t repeat) {
+        pos++; // '('
+        if (repeat > 1) {
+            if (repeat_depth == max_format_repeat_depth) return false;
+            repeat_depth++;
+            emit(FormatOp::Repeat);
+            emit_operand(repeat);
+        }
+        while (peek() != ')') {
+            if (pos >= s.size()) return false;
+            if (!compile_item(nullptr)) return false;
+        }
+        pos++; // ')'
+        if (repeat > 1) {
+            repeat_depth--;
+            emit(FormatOp::RepeatEnd);
+        }
+        return true;
+    }
+
+    bool compile_literal() {
+        char quote = s[pos++];
+        std::string literal;
+        while (true) {
+            if (pos >= s.size()) return false;
+            if (s[pos] == quote) {
+                if (pos + 1 < s.size() && s[pos + 1] == quote) {
+                    literal += quote;
+                    pos += 2;
+                    continue;
+                }
+                pos++;
+                break;
+            }
+            literal += s[pos++];
+        }
+        emit(FormatOp::Literal);
+        emit_operand(literal.size());
+        code.insert(code.end(), literal.begin(), literal.end());
+        return true;
+    }
+
+    // Data edit descriptors: A[w], I[w[.m]], F[w.d], E/ES/D[w.d[Ee]],
+    // EN[w.d], L[w]
+    bool compile_descriptor() {
+        char c = peek();
+        pos++;
+        uint32_t w = 0, d = 0, e = 2;
+        switch (c) {
+            case 'a': {
+                parse_number(w);
+                emit(FormatOp::A);
+                emit_operand(w);
+                return true;
+            }
+            case 'i': {
+                parse_number(w);
+                uint32_t m = 0;
+                if (peek() == '.') {
+                    pos++;
+                    parse_number(m);
+                    m++;
+                }
+                emit(FormatOp::I);
+                emit_operand(w);
+                emit_operand(m);
+                return true;
+            }
+            case 'f': {
+                parse_number(w);
+                if (peek() == '.') {
+                    pos++;
+                    parse_number(d);
+                } else {
+                    // The runtime treats F without .d like F0.0
+                    w = 0;
+                }
+                emit(FormatOp::F);
+                emit_operand(w);
+                emit_operand(d);
+                return true;
+            }
+            case 'l': {
+                parse_number(w);
+                emit(FormatOp::L);
+                emit_operand(w);
+                return true;
+            }
+            case 'd':
+            case 'e': {
+                FormatOp op = c == 'd' ? FormatOp::D : FormatOp::E;
+                if (c == 'e' && peek() == 'n') {
+                    op = FormatOp::EN;
+                    pos++;
+                } else if (c == 'e' && peek() == 's') {
+                    op = FormatOp::ES;
+                    pos++;
+                }
+                parse_number(w);
+                if (peek() != '.') return false;
+                pos++;
+                parse_number(d);
+                if (peek() == 'e') {
+                    pos++;
+                    if (!parse_number(e)) return false;
+                }
+                emit(op);
+                emit_operand(w);
+                emit_operand(d);
+                if (op != FormatOp::EN) emit_operand(e);
+                return true;
+            }
+            default: {
+                return false;
+            }
+        }
+    }
+};
+
+} // namespace
+
+bool compile_fortran_format(const std::string &fmt, std::vector<uint8_t> &code)
+{
+    // Blanks are not significant outside of character string edit
+    // descriptors
+    std::string cleaned;
+    char quote = '\0';
+    for (char c : fmt) {
+        if (quote != '\0') {
+            if (c == quote) quote = '\0';
+        } else if (c == '\'' || c == '"') {
+            quote = c;
+        } else if (std::isspace(static_cast<unsigned char>(c))) {
+            continue;
+        }
+        cleaned += c;
+    }
+    code.clear();
+    FormatCompiler compiler(cleaned, code);
+    if (!compiler.compile()) {
+        code.clear();
+        return false;
+    }
+    return true;
+}
+
+} // namespace LCompilers
@@ -0,0 +1,45 @@
+#ifndef LIBASR_FORTRAN_FORMAT_H
+#define LIBASR_FORTRAN_FORMAT_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace LCompilers {
+
+// Opcodes of compiled formats. Must match `enum _lfortran_format_op` in
+// runtime/lfortran_intrinsics.h, which also describes the encoding.
+enum class FormatOp : uint8_t {
+    End = 0,
+    Literal = 1,
+    Newline = 2,
+    Space = 3,
+    Tab = 4,
+    Scale = 5,
+    Unlimited = 6,
+    Reversion = 7,
+    Repeat = 8,
+    RepeatEnd = 9,
+    A = 10,
+    I = 11,
+    F = 12,
+    E = 13,
+    ES = 14,
+    EN = 15,
+    D = 16,
+    L = 17
+};
+
+// Maximum nesting of repeated groups in a compiled format
+const int max_format_repeat_depth = 16;
+
+// Compiles the Fortran format specification `fmt` (e.g. "(3f8.3, a)") into
+// the bytecode interpreted by `_lcompilers_string_format_fortran_compiled`.
+// Returns false for formats using edit descriptors the compiled formatter
+// does not implement, or that are invalid; these are left to the runtime
+// format parser, which also reports the errors.
+bool compile_fortran_format(const std::string &fmt, std::vector<uint8_t> &code);
+
+} // namespace LCompilers
+
+#endif // LIBASR_FORTRAN_FORMAT_H
@@ -1,4 +1,7 @@
 #include <string>
+#include <set>
+#include <algorithm>
+#include <mutex>
 
 #include <libasr/config.h>
 #include <libasr/asr_utils.h>
@@ -6,12 +9,193 @@
 #include <libasr/modfile.h>
 #include <libasr/serialization.h>
 #include <libasr/bwriter.h>
+#include <libasr/pickle.h>
+#include <libasr/string_utils.h>
 
 namespace LCompilers {
 
 const std::string lfortran_modfile_type_string = "LCompilers Modfile";
 
-inline void save_asr(const ASR::TranslationUnit_t &m, std::string& asr_string) {
+/*
+    Collects the ids of the symbol tables of `sym` and of all symbol tables
+    nested in it into `symtab_ids`, and the names of the symbols of the
+    module `module_name` that the ExternalSymbols nested in it point to
+    into `deps` (the caller filters out the names that are not symbols of
+    the module).
+*/
+static void collect_nested_symbols(const ASR::symbol_t *sym,
+        const std::string &module_name, std::vector<uint64_t> &symtab_ids,
+        std::set<std::string> &deps) {
+    if (ASR::is_a<ASR::ExternalSymbol_t>(*sym)) {
+        ASR::ExternalSymbol_t *e = ASR::down_cast<ASR::ExternalSymbol_t>(sym);
+        if (module_name == e->m_module_name) {
+            deps.insert(e->n_scope_names > 0 ? e->m_scope_names[0]
+                : e->m_original_name);
+        } else {
+            // Members of derived types use the name of the type as the
+            // module name
+            deps.insert(e->m_module_name);
+        }
+        return;
+    }
+    SymbolTable *symtab = nullptr;
+    if (ASR::is_a<ASR::Class_t>(*sym)) {
+        symtab = ASR::down_cast<ASR::Class_t>(sym)->m_symtab;
+    } else if (!ASR::is_a<ASR::CustomOperator_t>(*sym)) {
+        symtab = ASRUtils::symbol_symtab(sym);
+    }
+    if (symtab) {
+        symtab_ids.push_back(symtab->counter);
+        for (auto &a : symtab->get_scope()) {
+            collect_nested_symbols(a.second, module_name, symtab_ids, deps);
+        }
+    }
+}
+
+static void collect_symbol_dependencies(const ASR::symbol_t *sym,
+        std::set<std::string> &deps) {
+    char **m_dependencies = nullptr;
+    size_t n_dependencies = 0;
+    switch (sym->type) {
+        case ASR::symbolType::Function: {
+            ASR::Function_t *x = ASR::down_cast<ASR::Function_t>(sym);
+            m_dependencies = x->m_dependencies;
+            n_dependencies = x->n_dependencies;
+            break;
+        }
+        case ASR::symbolType::Struct: {
+            ASR::Struct_t *x = ASR::down_cast<ASR::Struct_t>(sym);
+            m_dependencies = x->m_dependencies;
+            n_dependencies = x->n_dependencies;
+            break;
+        }
+        case ASR::symbolType::Enum: {
+            ASR::Enum_t *x = ASR::down_cast<ASR::Enum_t>(sym);
+            m_dependencies = x->m_dependencies;
+            n_dependencies = x->n_dependencies;
+            break;
+        }
+        case ASR::symbolType::UnionType: {
+            ASR::UnionType_t *x = ASR::down_cast<ASR::UnionType_t>(sym);
+            m_dependencies = x->m_dependencies;
+            n_dependencies = x->n_dependencies;
+            break;
+        }
+        case ASR::symbolType::Variable: {
+            ASR::Variable_t *x = ASR::down_cast<ASR::Variable_t>(sym);
+            m_dependencies = x->m_dependencies;
+            n_dependencies = x->n_dependencies;
+            break;
+        }
+        default: {
+            break;
+        }
+    }
+    for (size_t i = 0; i < n_dependencies; i++) {
+        deps.insert(m_dependencies[i]);
+    }
+}
+
+/*
+    Returns the symbol index of the module `m`. For each symbol of the
+    module it contains the position of the symbol in the serialized ASR
+    `asr_binary` and the names of the other symbols of the module that the
+    symbol needs, so that the symbols can be loaded individually (see
+    load_modfile_lazy()). The symbols are listed in the order in which they
+    are serialized.
+
+    Returns an empty string if the symbols could not be located in
+    `asr_binary`, in which case the module can only be loaded as a whole.
+*/
+std::string get_symbol_index(const ASR::TranslationUnit_t &tu,
+        const ASR::Module_t &m, const std::string &asr_binary) {
+    std::vector<std::pair<std::string, ASR::symbol_t*>> symbols;
+    for (auto &a : m.m_symtab->get_scope()) {
+        if (!ASR::is_a<ASR::Function_t>(*a.second)) {
+            symbols.push_back(a);
+        }
+    }
+    for (auto &a : m.m_symtab->get_scope()) {
+        if (ASR::is_a<ASR::Function_t>(*a.second)) {
+            symbols.push_back(a);
+        }
+    }
+
+    // The symbol of the module that owns each of the nested symbol tables
+    std::map<uint64_t, std::string> symtab_owner;
+    std::vector<std::set<std::string>> deps(symbols.size());
+    for (size_t i = 0; i < symbols.size(); i++) {
+        std::vector<uint64_t> symtab_ids;
+        collect_nested_symbols(symbols[i].second, m.m_name, symtab_ids,
+            deps[i]);
+        collect_symbol_dependencies(symbols[i].second, deps[i]);
+        for (auto &id : symtab_ids) {
+            symtab_owner[id] = symbols[i].first;
+        }
+    }
+
+#ifdef WITH_LFORTRAN_BINARY_MODFILES
+    BinaryWriter b;
+#else
+    TextWriter b;
+#endif
+    b.write_string(m.m_name);
+    b.write_int64(tu.m_symtab->counter);
+    b.write_int64(m.m_symtab->counter);
+    b.write_int64(m.n_dependencies);
+    for (size_t i = 0; i < m.n_dependencies; i++) {
+        b.write_string(m.m_dependencies[i]);
+    }
+    b.write_int8(m.m_intrinsic);
+    b.write_int64(symbols.size());
+    // The symbols are serialized one after another (each preceded by its
+    // name) into the symbol table of the module
+    size_t pos = std::string::npos;
+    for (size_t i = 0; i < symbols.size(); i++) {
+        const std::string &name = symbols[i].first;
+        std::vector<std::pair<uint64_t, std::string>> symbol_refs;
+        std::string sym_binary = serialize_symbol(*symbols[i].second,
+            symbol_refs);
+        std::string item_binary = serialize_string(name) + sym_binary;
+        if (pos == std::string::npos) {
+            pos = asr_binary.find(item_binary);
+            if (pos == std::string::npos) {
+                return "";
+            }
+        } else if (asr_binary.compare(pos, item_binary.size(),
+                item_binary) != 0) {
+            return "";
+        }
+        pos += item_binary.size() - sym_binary.size();
+
+        for (auto &ref : symbol_refs) {
+            if (ref.first == m.m_symtab->counter) {
+                deps[i].insert(ref.second);
+            } else if (symtab_owner.find(ref.first) != symtab_owner.end()) {
+                deps[i].insert(symtab_owner[ref.first]);
+            }
+        }
+        std::vector<std::string> symbol_deps;
+        for (auto &dep : deps[i]) {
+            if (dep != name && m.m_symtab->get_symbol(dep) != nullptr) {
+                symbol_deps.push_back(dep);
+            }
+        }
+
+        b.write_string(name);
+        b.write_int64(pos);
+        b.write_int64(sym_binary.size());
+        b.write_int64(symbol_deps.size());
+        for (auto &dep : symbol_deps) {
+            b.write_string(dep);
+        }
+        pos += sym_binary.size();
+    }
+    return b.get_str();
+}
+
+inline void save_asr(const ASR::TranslationUnit_t &m, std::string& asr_string,
+        const PassOptions *pass_options, bool symbol_index) {
     #ifdef WITH_LFORTRAN_BINARY_MODFILES
     BinaryWriter b;
 #else
@@ -21,6 +205,37 @@ inline void save_asr(const ASR::TranslationUnit_t &m, std::string& asr_string) {
     b.write_string(lfortran_modfile_type_string);
     b.write_string(LFORTRAN_VERSION);
 
+    std::string asr_binary = serialize(m);
+
+    // Hashes of the module, empty if not computed. Kept in the header, so
+    // that they can be read without deserializing the ASR:
+    // * Interface hash (see get_module_interface_hash())
+    // * Module hash: hash of the full ASR and of the module hashes of all
+    //   the modules it depends on
+    std::string interface_hash, module_hash;
+    if (pass_options) {
+        LCOMPILERS_ASSERT(m.m_symtab->get_scope().size() == 1);
+        ASR::symbol_t *sym = m.m_symtab->get_scope().begin()->second;
+        LCOMPILERS_ASSERT(ASR::is_a<ASR::Module_t>(*sym));
+        ASR::Module_t *mod = ASR::down_cast<ASR::Module_t>(sym);
+        interface_hash = get_module_interface_hash(*mod, *pass_options);
+        uint64_t h = string_hash(asr_binary);
+        for (size_t i = 0; i < mod->n_dependencies; i++) {
+            std::shared_ptr<const MappedFile> modfile
+                = ASRUtils::find_modfile(mod->m_dependencies[i],
+                    *pass_options);
+            if (modfile) {
+                std::string dep_interface_hash, dep_module_hash;
+                load_modfile_hashes(modfile->view(), dep_interface_hash,
+                    dep_module_hash);
+                h = string_hash(dep_module_hash, h);
+            }
+        }
+        module_hash = hash_to_hex(h);
+    }
+    b.write_string(interface_hash);
+    b.write_string(module_hash);
+
     // AST section: Original module source code:
     // Currently empty.
     // Note: in the future we can save here:
@@ -33,8 +248,17 @@ inline void save_asr(const ASR::TranslationUnit_t &m, std::string& asr_string) {
     // Export ASR:
     // Currently empty.
 
+    // Symbol index (see get_symbol_index()), empty if not available:
+    std::string index_binary;
+    if (symbol_index) {
+        ASR::symbol_t *sym = m.m_symtab->get_scope().begin()->second;
+        index_binary = get_symbol_index(m,
+            *ASR::down_cast<ASR::Module_t>(sym), asr_binary);
+    }
+    b.write_string(index_binary);
+
     // Full ASR:
-    b.write_string(serialize(m));
+    b.write_string(asr_binary);
 
     asr_string = b.get_str();
 }
@@ -51,7 +275,8 @@ inline void save_asr(const ASR::TranslationUnit_t &m, std::string& asr_string) {
 
     Comments below show some possible future improvements to the mod format.
 */
-std::string save_modfile(const ASR::TranslationUnit_t &m) {
+std::string save_modfile(const ASR::TranslationUnit_t &m,
+        const PassOptions *pass_options) {
     LCOMPILERS_ASSERT(m.m_symtab->get_scope().size()== 1);
     for (auto &a : m.m_symtab->get_scope()) {
         LCOMPILERS_ASSERT(ASR::is_a<ASR::Module_t>(*a.second));
@@ -59,22 +284,81 @@ std::string save_modfile(const ASR::TranslationUnit_t &m) {
     }
 
     std::string asr_string;
-    save_asr(m, asr_string);
+    save_asr(m, asr_string, pass_options, true);
     return asr_string;
 }
 
 std::string save_pycfile(const ASR::TranslationUnit_t &m) {
     std::string asr_string;
-    save_asr(m, asr_string);
+    save_asr(m, asr_string, nullptr, false);
     return asr_string;
 }
 
-inline void load_serialised_asr(const std::string &s, std::string& asr_binary) {
+// Pickle of `x` that does not depend on the IDs of the symbol tables, which
+// change when symbol tables are added anywhere before `x` (even in another
+// file compiled before by the same process)
+static std::string interface_pickle(ASR::asr_t &x) {
+    return pickle(x, false, false, false, false);
+}
+
+/*
+    Returns a hash of the interface of the module `m`, that is of everything
+    that a program unit using the module can depend on: all the symbols of
+    the module except for the bodies (and local variables) of its procedures.
+    Of the procedures, the signature, the access and the dummy arguments and
+    result (names, types, intents, ...) are hashed. Procedures that can be
+    inlined into the caller (`m_inline`) are hashed including their bodies.
+    The interface hashes of the modules that `m` depends on are mixed in, so
+    that a change of an interface propagates through re-exported symbols.
+*/
+std::string get_module_interface_hash(const ASR::Module_t &m,
+        const PassOptions &pass_options) {
+    uint64_t h = string_hash(m.m_name);
+    for (auto &item : m.m_symtab->get_scope()) {
+        h = string_hash(item.first, h);
+        ASR::symbol_t *sym = item.second;
+        if (ASR::is_a<ASR::Function_t>(*sym)
+                && !ASRUtils::get_FunctionType(sym)->m_inline) {
+            ASR::Function_t *f = ASR::down_cast<ASR::Function_t>(sym);
+            h = string_hash(interface_pickle(f->m_function_signature->base), h);
+            h = string_hash(std::to_string(f->m_access), h);
+            for (size_t i = 0; i < f->n_args; i++) {
+                h = string_hash(interface_pickle(f->m_args[i]->base), h);
+                if (ASR::is_a<ASR::Var_t>(*f->m_args[i])) {
+                    h = string_hash(interface_pickle(ASR::down_cast<ASR::Var_t>(
+                        f->m_args[i])->m_v->base), h);
+                }
+            }
+            if (f->m_return_var) {
+                h = string_hash(interface_pickle(f->m_return_var->base), h);
+                if (ASR::is_a<ASR::Var_t>(*f->m_return_var)) {
+                    h = string_hash(interface_pickle(ASR::down_cast<ASR::Var_t>(
+                        f->m_return_var)->m_v->base), h);
+                }
+            }
+        } else {
+            h = string_hash(interface_pickle(sym->base), h);
+        }
+    }
+    for (size_t i = 0; i < m.n_dependencies; i++) {
+        std::string dep = m.m_dependencies[i];
+        h = string_hash(dep, h);
+        std::shared_ptr<const MappedFile> modfile
+            = ASRUtils::find_modfile(dep, pass_options);
+        if (modfile) {
+            h = string_hash(get_modfile(modfile)->interface_hash, h);
+        }
+    }
+    return hash_to_hex(h);
+}
+
+inline void load_serialised_header(
 #ifdef WITH_LFORTRAN_BINARY_MODFILES
-    BinaryReader b(s);
+        BinaryReader &b,
 #else
-    TextReader b(s);
+        TextReader &b,
 #endif
+        std::string &interface_hash, std::string &module_hash) {
     std::string file_type = b.read_string();
     if (file_type != lfortran_modfile_type_string) {
         throw LCompilersException("LCompilers Modfile format not recognized");
@@ -83,21 +367,295 @@ inline void load_serialised_asr(const std::string &s, std::string& asr_binary) {
     if (version != LFORTRAN_VERSION) {
         throw LCompilersException("Incompatible format: LFortran Modfile was generated using version '" + version + "', but current LFortran version is '" + LFORTRAN_VERSION + "'");
     }
-    asr_binary = b.read_string();
+    interface_hash = b.read_string();
+    module_hash = b.read_string();
+}
+
+// The ASR is returned as a view into `s`
+inline void load_serialised_asr(std::string_view s,
+        std::string_view &asr_binary) {
+#ifdef WITH_LFORTRAN_BINARY_MODFILES
+    BinaryReader b(s);
+#else
+    TextReader b(s);
+#endif
+    std::string interface_hash, module_hash;
+    load_serialised_header(b, interface_hash, module_hash);
+    // The symbol index
+    b.read_string_view();
+    asr_binary = b.read_string_view();
+}
+
+void load_modfile_hashes(std::string_view s, std::string &interface_hash,
+        std::string &module_hash) {
+#ifdef WITH_LFORTRAN_BINARY_MODFILES
+    BinaryReader b(s);
+#else
+    TextReader b(s);
+#endif
+    load_serialised_header(b, interface_hash, module_hash);
 }
 
-ASR::TranslationUnit_t* load_modfile(Allocator &al, const std::string &s,
+ASR::TranslationUnit_t* load_modfile(Allocator &al, std::string_view s,
         bool load_symtab_id, SymbolTable &symtab) {
-    std::string asr_binary;
+    std::string_view asr_binary;
     load_serialised_asr(s, asr_binary);
     ASR::asr_t *asr = deserialize_asr(al, asr_binary, load_symtab_id, symtab);
     ASR::TranslationUnit_t *tu = ASR::down_cast2<ASR::TranslationUnit_t>(asr);
     return tu;
 }
 
-ASR::TranslationUnit_t* load_pycfile(Allocator &al, const std::string &s,
+ASR::TranslationUnit_t* load_modfile(Allocator &al, const Modfile &modfile,
+        bool load_symtab_id, SymbolTable &symtab) {
+    ASR::asr_t *asr = deserialize_asr(al, modfile.asr_binary, load_symtab_id,
+        symtab);
+    ASR::TranslationUnit_t *tu = ASR::down_cast2<ASR::TranslationUnit_t>(asr);
+    return tu;
+}
+
+struct ModfileSymbol {
+    std::string name;
+    // Position of the serialized symbol in the full ASR
+    size_t offset, size;
+    // The other symbols of the module that the symbol needs
+    std::vector<std::string> dependencies;
+};
+
+struct ModfileSymbolIndex {
+    std::string module_name;
+    uint64_t tu_symtab_id, module_symtab_id;
+    std::vector<std::string> module_dependencies;
+    bool intrinsic;
+    std::vector<ModfileSymbol> symbols;
+    std::map<std::string, size_t> symbol_idx;
+};
+
+static bool load_symbol_index(std::string_view s,
+        ModfileSymbolIndex &index) {
+    if (s.empty()) {
+        return false;
+    }
+#ifdef WITH_LFORTRAN_BINARY_MODFILES
+    BinaryReader b(s);
+#else
+    TextReader b(s);
+#endif
+    index.module_name = b.read_string();
+    index.tu_symtab_id = b.read_int64();
+    index.module_symtab_id = b.read_int64();
+    size_t n = b.read_int64();
+    for (size_t i = 0; i < n; i++) {
+        index.module_dependencies.push_back(b.read_string());
+    }
+    index.intrinsic = b.read_int8();
+    n = b.read_int64();
+    index.symbols.resize(n);
+    for (size_t i = 0; i < n; i++) {
+        ModfileSymbol &sym = index.symbols[i];
+        sym.name = b.read_string();
+        sym.offset = b.read_int64();
+        sym.size = b.read_int64();
+        size_t n_deps = b.read_int64();
+        for (size_t j = 0; j < n_deps; j++) {
+            sym.dependencies.push_back(b.read_string());
+        }
+        index.symbol_idx[sym.name] = i;
+    }
+    return true;
+}
+
+// Splits the modfile `s` into its sections, `modfile` must keep `s` alive
+static void load_modfile_sections(Modfile &modfile, std::string_view s) {
+#ifdef WITH_LFORTRAN_BINARY_MODFILES
+    BinaryReader b(s);
+#else
+    TextReader b(s);
+#endif
+    load_serialised_header(b, modfile.interface_hash, modfile.module_hash);
+    std::string_view index_binary = b.read_string_view();
+    modfile.asr_binary = b.read_string_view();
+    std::shared_ptr<ModfileSymbolIndex> index
+        = std::make_shared<ModfileSymbolIndex>();
+    if (load_symbol_index(index_binary, *index)) {
+        modfile.index = index;
+    }
+}
+
+std::shared_ptr<const Modfile> parse_modfile(std::string s) {
+    std::shared_ptr<Modfile> modfile = std::make_shared<Modfile>();
+    modfile->text = std::move(s);
+    load_modfile_sections(*modfile, modfile->text);
+    return modfile;
+}
+
+std::shared_ptr<const Modfile> get_modfile(
+        const std::shared_ptr<const MappedFile> &file) {
+    static std::mutex modfiles_mutex;
+    // Indexed by the mapping, which changes when the file is replaced
+    static std::map<const MappedFile*, std::shared_ptr<const Modfile>> modfiles;
+
+    {
+        std::lock_guard<std::mutex> lock(modfiles_mutex);
+        auto it = modfiles.find(file.get());
+        if (it != modfiles.end()) {
+            return it->second;
+        }
+    }
+    // Parse without holding the lock, other threads may parse other modfiles
+    std::shared_ptr<Modfile> modfile = std::make_shared<Modfile>();
+    modfile->file = file;
+    load_modfile_sections(*modfile, file->view());
+
+    std::lock_guard<std::mutex> lock(modfiles_mutex);
+    for (auto it = modfiles.begin(); it != modfiles.end(); ) {
+        if (it->second->file.use_count() == 1) {
+            // The file was replaced on disk and nobody else uses the old one
+            it = modfiles.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    return modfiles.emplace(file.get(), modfile).first->second;
+}
+
+// A module loaded by load_modfile_lazy() that does not have all of its
+// symbols loaded yet
+struct LazyModule {
+    SymbolTable *symtab;
+    // The remaining symbols are loaded from the same modfile even if the
+    // file is replaced on disk in the meantime
+    std::shared_ptr<const Modfile> modfile;
+    std::vector<bool> loaded;
+    std::map<uint64_t, SymbolTable*> id_symtab_map;
+};
+
+// Indexed by the counter of the symbol table of the module, which (unlike
+// the address of the module) is never reused for another module
+thread_local std::map<uint64_t, LazyModule> lazy_modules;
+
+static LazyModule* get_lazy_module(const ASR::Module_t &m) {
+    auto it = lazy_modules.find(m.m_symtab->counter);
+    if (it == lazy_modules.end() || it->second.symtab != m.m_symtab) {
+        return nullptr;
+    }
+    return &it->second;
+}
+
+/*
+    Loads the `symbols` of the module `m` (all the remaining ones if
+    `symbols` is nullptr) together with all the symbols of the module that
+    they need. The symbols are loaded in the order in which they were
+    serialized, so that they are deserialized exactly as when loading the
+    whole module.
+*/
+static std::vector<ASR::symbol_t*> load_lazy_module_symbols(Allocator &al,
+        ASR::Module_t &m, LazyModule &lm,
+        const std::vector<std::string> *symbols) {
+    const ModfileSymbolIndex &index = *lm.modfile->index;
+    std::string_view asr_binary = lm.modfile->asr_binary;
+    std::vector<bool> needed(index.symbols.size(), symbols == nullptr);
+    if (symbols) {
+        std::vector<size_t> stack;
+        for (auto &name : *symbols) {
+            auto it = index.symbol_idx.find(name);
+            if (it != index.symbol_idx.end()) {
+                stack.push_back(it->second);
+            }
+        }
+        while (!stack.empty()) {
+            size_t i = stack.back();
+            stack.pop_back();
+            if (needed[i] || lm.loaded[i]) {
+                continue;
+            }
+            needed[i] = true;
+            for (auto &dep : index.symbols[i].dependencies) {
+                auto it = index.symbol_idx.find(dep);
+                if (it != index.symbol_idx.end()) {
+                    stack.push_back(it->second);
+                }
+            }
+        }
+    }
+
+    std::vector<ASR::symbol_t*> loaded;
+    for (size_t i = 0; i < index.symbols.size(); i++) {
+        if (!needed[i] || lm.loaded[i]) {
+            continue;
+        }
+        const ModfileSymbol &sym = index.symbols[i];
+        if (sym.offset + sym.size > asr_binary.size()) {
+            throw LCompilersException("The symbol index of the modfile of the module '"
+                + index.module_name + "' is corrupted");
+        }
+        loaded.push_back(deserialize_symbol(al,
+            asr_binary.substr(sym.offset, sym.size), *m.m_symtab, sym.name,
+            lm.id_symtab_map));
+        lm.loaded[i] = true;
+    }
+
+    if (std::find(lm.loaded.begin(), lm.loaded.end(), false)
+            == lm.loaded.end()) {
+        // All symbols are loaded now
+        lazy_modules.erase(m.m_symtab->counter);
+    }
+    return loaded;
+}
+
+ASR::TranslationUnit_t* load_modfile_lazy(Allocator &al,
+        const std::shared_ptr<const Modfile> &modfile,
+        const std::vector<std::string> &symbols) {
+    if (!modfile->index) {
+        return nullptr;
+    }
+    const ModfileSymbolIndex &index = *modfile->index;
+
+    Location loc;
+    loc.first = 0;
+    loc.last = 0;
+    SymbolTable *tu_symtab = al.make_new<SymbolTable>(nullptr);
+    SymbolTable *module_symtab = al.make_new<SymbolTable>(tu_symtab);
+    Vec<char*> deps;
+    deps.reserve(al, index.module_dependencies.size());
+    for (auto &dep : index.module_dependencies) {
+        deps.push_back(al, s2c(al, dep));
+    }
+    ASR::symbol_t *m = ASR::down_cast<ASR::symbol_t>(ASR::make_Module_t(al,
+        loc, module_symtab, s2c(al, index.module_name), deps.p, deps.size(),
+        false, index.intrinsic));
+    module_symtab->asr_owner = (ASR::asr_t*)m;
+    tu_symtab->add_symbol(index.module_name, m);
+    ASR::TranslationUnit_t *tu = ASR::down_cast2<ASR::TranslationUnit_t>(
+        ASR::make_TranslationUnit_t(al, loc, tu_symtab, nullptr, 0));
+    tu_symtab->asr_owner = (ASR::asr_t*)tu;
+
+    LazyModule &lm = lazy_modules[module_symtab->counter];
+    lm.symtab = module_symtab;
+    lm.modfile = modfile;
+    lm.loaded = std::vector<bool>(index.symbols.size(), false);
+    lm.id_symtab_map[index.tu_symtab_id] = tu_symtab;
+    lm.id_symtab_map[index.module_symtab_id] = module_symtab;
+    load_lazy_module_symbols(al, *ASR::down_cast<ASR::Module_t>(m), lm,
+        &symbols);
+    return tu;
+}
+
+bool is_module_partially_loaded(const ASR::Module_t &m) {
+    return get_lazy_module(m) != nullptr;
+}
+
+std::vector<ASR::symbol_t*> load_modfile_symbols(Allocator &al,
+        ASR::Module_t &m, const std::vector<std::string> *symbols) {
+    LazyModule *lm = get_lazy_module(m);
+    if (!lm) {
+        return {};
+    }
+    return load_lazy_module_symbols(al, m, *lm, symbols);
+}
+
+ASR::TranslationUnit_t* load_pycfile(Allocator &al, std::string_view s,
         bool load_symtab_id) {
-    std::string asr_binary;
+    std::string_view asr_binary;
     load_serialised_asr(s, asr_binary);
     ASR::asr_t *asr = deserialize_asr(al, asr_binary, load_symtab_id);
 
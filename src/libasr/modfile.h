@@ -2,21 +2,77 @@
 #define LFORTRAN_MODFILE_H
 
 #include <libasr/asr.h>
+#include <libasr/utils.h>
 
 namespace LCompilers {
 
-    // Save a module to a modfile
-    std::string save_modfile(const ASR::TranslationUnit_t &m);
+    // Save a module to a modfile. If `pass_options` are given (they are used
+    // to find the modfiles of the dependencies), the interface and module
+    // hashes are computed and stored in the header of the modfile.
+    std::string save_modfile(const ASR::TranslationUnit_t &m,
+        const PassOptions *pass_options=nullptr);
 
     std::string save_pycfile(const ASR::TranslationUnit_t &m);
 
+    struct ModfileSymbolIndex;
+
+    // A modfile split into its sections. The sections are views into `file`
+    // (or into `text` for a modfile that is not read from a file).
+    struct Modfile {
+        std::shared_ptr<const MappedFile> file;
+        std::string text;
+        std::string interface_hash, module_hash;
+        std::string_view asr_binary;
+        // nullptr if the modfile does not have a symbol index
+        std::shared_ptr<const ModfileSymbolIndex> index;
+    };
+
+    // Returns the parsed modfile `file`. Each modfile is parsed once per
+    // process and shared by all the translation units, threads and REPL
+    // cells until the file is replaced on disk. The ASR is deserialized
+    // from it into the Allocator of each user, which then owns its copy.
+    std::shared_ptr<const Modfile> get_modfile(
+        const std::shared_ptr<const MappedFile> &file);
+
+    // Parses a modfile held in memory (not cached)
+    std::shared_ptr<const Modfile> parse_modfile(std::string s);
+
     // Load a module from a modfile
-    ASR::TranslationUnit_t* load_modfile(Allocator &al, const std::string &s,
+    ASR::TranslationUnit_t* load_modfile(Allocator &al, std::string_view s,
+        bool load_symtab_id, SymbolTable &symtab);
+    ASR::TranslationUnit_t* load_modfile(Allocator &al, const Modfile &modfile,
         bool load_symtab_id, SymbolTable &symtab);
 
-    ASR::TranslationUnit_t* load_pycfile(Allocator &al, const std::string &s,
+    // Load only the `symbols` of the module from a modfile, together with the
+    // symbols of the module that they need. Returns nullptr if the modfile
+    // does not have a symbol index, then the whole module must be loaded.
+    ASR::TranslationUnit_t* load_modfile_lazy(Allocator &al,
+        const std::shared_ptr<const Modfile> &modfile,
+        const std::vector<std::string> &symbols);
+
+    // True if the module was loaded by load_modfile_lazy() and some of its
+    // symbols are not loaded yet
+    bool is_module_partially_loaded(const ASR::Module_t &m);
+
+    // Load more symbols of a module loaded by load_modfile_lazy() from the
+    // same modfile: the `symbols` (and what they need) or all the remaining
+    // ones if `symbols` is nullptr. Returns the newly loaded symbols.
+    std::vector<ASR::symbol_t*> load_modfile_symbols(Allocator &al,
+        ASR::Module_t &m, const std::vector<std::string> *symbols);
+
+    ASR::TranslationUnit_t* load_pycfile(Allocator &al, std::string_view s,
         bool load_symtab_id);
 
+    // Hash of everything in the module that its users can depend on; does
+    // not change when only the bodies of its procedures change
+    std::string get_module_interface_hash(const ASR::Module_t &m,
+        const PassOptions &pass_options);
+
+    // Reads the interface and module hashes from the header of a modfile
+    // (empty if they were not computed)
+    void load_modfile_hashes(std::string_view s, std::string &interface_hash,
+        std::string &module_hash);
+
 } // namespace LCompilers
 
 #endif // LFORTRAN_MODFILE_H
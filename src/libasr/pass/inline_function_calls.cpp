@@ -67,7 +67,7 @@ public:
         if( arg2value.find(sym_name) != arg2value.end() ) {                     \
             LCOMPILERS_ASSERT(ASR::is_a<symbol_t>(*sym))                        \
             symbol_t *x_var = ASR::down_cast<symbol_t>(arg2value[sym_name]);    \
-            if( current_scope->get_symbol(std::string(x_var->m_name))) {        \
+            if( current_scope->get_symbol(x_var->m_name)) {        \
                 m_v = arg2value[sym_name];                                      \
             }                                                                   \
         }
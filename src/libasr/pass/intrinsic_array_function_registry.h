@@ -934,6 +934,114 @@ static inline ASR::expr_t* instantiate_ArrIntrinsic(Allocator &al,
     return builder.Call(new_symbol, new_args, return_type, nullptr);
 }
 
+/*
+    Reductions of a whole contiguous real array are done by the SIMD kernels
+    of the runtime, e.g.
+
+    s = sum(x)
+        To
+    s = _lcompilers_Sum_kernel(x)
+
+    where
+
+    real(8) function _lcompilers_Sum_kernel(array) result(result)
+        real(8) :: array(n)
+        result = _lfortran_sum_r8(size(array, kind=8), array)
+    end function
+
+    With `fast` the kernels for SUM and NORM2 are allowed to reassociate.
+    Returns nullptr if the reduction is not done by a runtime kernel.
+*/
+static inline ASR::expr_t* instantiate_reduction_kernel(Allocator &al,
+        const Location &loc, SymbolTable *scope, Vec<ASR::ttype_t*>& arg_types,
+        ASR::ttype_t *return_type, Vec<ASR::call_arg_t>& new_args,
+        int64_t intrinsic_id, bool fast) {
+    if (arg_types.size() != 1 || !ASRUtils::is_contiguous_array(arg_types[0]) ||
+            !ASRUtils::is_real(*arg_types[0]) || ASRUtils::is_array(return_type)) {
+        return nullptr;
+    }
+    int kind = ASRUtils::extract_kind_from_ttype_t(arg_types[0]);
+    if (kind != 4 && kind != 8) {
+        return nullptr;
+    }
+    std::string kernel;
+    switch (static_cast<IntrinsicArrayFunctions>(intrinsic_id)) {
+        case IntrinsicArrayFunctions::Sum: {
+            kernel = fast ? "sum_fast" : "sum";
+            break;
+        }
+        case IntrinsicArrayFunctions::Product: {
+            kernel = "product";
+            break;
+        }
+        case IntrinsicArrayFunctions::MaxVal: {
+            kernel = "maxval";
+            break;
+        }
+        case IntrinsicArrayFunctions::MinVal: {
+            kernel = "minval";
+            break;
+        }
+        case IntrinsicArrayFunctions::Norm2: {
+            kernel = fast ? "norm2_fast" : "norm2";
+            break;
+        }
+        default: {
+            return nullptr;
+        }
+    }
+    std::string c_func_name = "_lfortran_" + kernel + "_r" + std::to_string(kind);
+    ASR::ttype_t* element_type = ASRUtils::type_get_past_array(
+        ASRUtils::type_get_past_allocatable(arg_types[0]));
+
+    declare_basic_variables("_lcompilers_" + get_array_intrinsic_name(intrinsic_id) + "_kernel");
+    fill_func_arg("array", arg_types[0]);
+    ASR::expr_t *result = declare("result", return_type, ReturnVar);
+
+    SymbolTable *fn_symtab_1 = al.make_new<SymbolTable>(fn_symtab);
+    Vec<ASR::expr_t*> args_1; args_1.reserve(al, 2);
+    args_1.push_back(al, b.Variable(fn_symtab_1, "n", int64,
+        ASR::intentType::In, ASR::abiType::BindC, true));
+    ASR::dimension_t dim = b.set_dim(b.i32(1), nullptr);
+    ASR::ttype_t* data_type = ASRUtils::make_Array_t_util(al, loc,
+        element_type, &dim, 1, ASR::abiType::BindC, true);
+    args_1.push_back(al, b.Variable(fn_symtab_1, "v", data_type,
+        ASR::intentType::In, ASR::abiType::BindC, false));
+    ASR::expr_t *return_var_1 = b.Variable(fn_symtab_1, c_func_name,
+        element_type, ASRUtils::intent_return_var, ASR::abiType::BindC, false);
+    SetChar dep_1; dep_1.reserve(al, 1);
+    Vec<ASR::stmt_t*> body_1; body_1.reserve(al, 1);
+    ASR::symbol_t *s = make_ASR_Function_t(c_func_name, fn_symtab_1, dep_1,
+        args_1, body_1, return_var_1, ASR::abiType::BindC,
+        ASR::deftypeType::Interface, s2c(al, c_func_name));
+    fn_symtab->add_symbol(c_func_name, s);
+    dep.push_back(al, s2c(al, c_func_name));
+
+    ASR::expr_t* data = args[0];
+    ASR::array_physical_typeType physical_type =
+        ASRUtils::extract_physical_type(arg_types[0]);
+    if (physical_type != ASR::array_physical_typeType::PointerToDataArray) {
+        data = ASRUtils::EXPR(ASRUtils::make_ArrayPhysicalCast_t_util(al, loc,
+            args[0], physical_type, ASR::array_physical_typeType::PointerToDataArray,
+            ASRUtils::duplicate_type(al, ASRUtils::type_get_past_allocatable(arg_types[0]),
+                nullptr, ASR::array_physical_typeType::PointerToDataArray, true),
+            nullptr));
+    }
+    Vec<ASR::call_arg_t> call_args; call_args.reserve(al, 2);
+    ASR::call_arg_t call_arg;
+    call_arg.loc = loc;
+    call_arg.m_value = b.ArraySize(args[0], nullptr, int64);
+    call_args.push_back(al, call_arg);
+    call_arg.m_value = data;
+    call_args.push_back(al, call_arg);
+    body.push_back(al, b.Assignment(result, b.Call(s, call_args, element_type)));
+
+    ASR::symbol_t *new_symbol = make_ASR_Function_t(fn_name, fn_symtab, dep, args,
+        body, result, ASR::abiType::Source, ASR::deftypeType::Implementation, nullptr);
+    scope->add_symbol(fn_name, new_symbol);
+    return b.Call(new_symbol, new_args, return_type, nullptr);
+}
+
 static inline void verify_MaxMinLoc_args(const ASR::IntrinsicArrayFunction_t& x,
         diag::Diagnostics& diagnostics) {
     std::string intrinsic_name = get_array_intrinsic_name(
@@ -32,12 +32,15 @@ class ReplaceIntrinsicFunctions: public ASR::BaseExprReplacer<ReplaceIntrinsicFu
     Allocator& al;
     SymbolTable* global_scope;
     std::map<ASR::symbol_t*, ASRUtils::IntrinsicArrayFunctions>& func2intrinsicid;
+    bool fast;
 
     public:
 
     ReplaceIntrinsicFunctions(Allocator& al_, SymbolTable* global_scope_,
-    std::map<ASR::symbol_t*, ASRUtils::IntrinsicArrayFunctions>& func2intrinsicid_) :
-        al(al_), global_scope(global_scope_), func2intrinsicid(func2intrinsicid_) {}
+    std::map<ASR::symbol_t*, ASRUtils::IntrinsicArrayFunctions>& func2intrinsicid_,
+    bool fast_) :
+        al(al_), global_scope(global_scope_), func2intrinsicid(func2intrinsicid_),
+        fast(fast_) {}
 
 
     void replace_IntrinsicElementalFunction(ASR::IntrinsicElementalFunction_t* x) {
@@ -113,7 +116,14 @@ class ReplaceIntrinsicFunctions: public ASR::BaseExprReplacer<ReplaceIntrinsicFu
         for( size_t i = 0; i < x->n_args; i++ ) {
             arg_types.push_back(al, ASRUtils::expr_type(x->m_args[i]));
         }
-        ASR::expr_t* current_expr_ = instantiate_function(al, x->base.base.loc,
+        ASR::expr_t* current_expr_ = ASRUtils::ArrIntrinsic::instantiate_reduction_kernel(
+            al, x->base.base.loc, global_scope, arg_types, x->m_type, new_args,
+            x->m_arr_intrinsic_id, fast);
+        if( current_expr_ ) {
+            *current_expr = current_expr_;
+            return ;
+        }
+        current_expr_ = instantiate_function(al, x->base.base.loc,
             global_scope, arg_types, x->m_type, new_args, x->m_overload_id);
         ASR::expr_t* func_call = current_expr_;
         *current_expr = current_expr_;
@@ -139,8 +149,9 @@ class ReplaceIntrinsicFunctionsVisitor : public ASR::CallReplacerOnExpressionsVi
     public:
 
         ReplaceIntrinsicFunctionsVisitor(Allocator& al_, SymbolTable* global_scope_,
-            std::map<ASR::symbol_t*, ASRUtils::IntrinsicArrayFunctions>& func2intrinsicid_) :
-            replacer(al_, global_scope_, func2intrinsicid_) {}
+            std::map<ASR::symbol_t*, ASRUtils::IntrinsicArrayFunctions>& func2intrinsicid_,
+            bool fast_) :
+            replacer(al_, global_scope_, func2intrinsicid_, fast_) {}
 
         void call_replacer() {
             replacer.current_expr = current_expr;
@@ -427,9 +438,10 @@ class ReplaceFunctionCallReturningArrayVisitor : public ASR::CallReplacerOnExpre
 };
 
 void pass_replace_intrinsic_function(Allocator &al, ASR::TranslationUnit_t &unit,
-                             const LCompilers::PassOptions& /*pass_options*/) {
+                             const LCompilers::PassOptions& pass_options) {
     std::map<ASR::symbol_t*, ASRUtils::IntrinsicArrayFunctions> func2intrinsicid;
-    ReplaceIntrinsicFunctionsVisitor v(al, unit.m_symtab, func2intrinsicid);
+    ReplaceIntrinsicFunctionsVisitor v(al, unit.m_symtab, func2intrinsicid,
+        pass_options.fast);
     v.visit_TranslationUnit(unit);
     ReplaceFunctionCallReturningArrayVisitor u(al, func2intrinsicid);
     u.visit_TranslationUnit(unit);
@@ -20,6 +20,7 @@ the code size.
 
 enum class IntrinsicImpureSubroutines : int64_t {
     RandomNumber,
+    RandomSeed,
     // ...
 };
 
@@ -58,54 +59,100 @@ namespace RandomNumber {
     static inline ASR::stmt_t* instantiate_RandomNumber(Allocator &al, const Location &loc,
             SymbolTable *scope, Vec<ASR::ttype_t*>& arg_types,
             Vec<ASR::call_arg_t>& new_args, int64_t /*overload_id*/) {
-        std::string c_func_name;
-        int kind = ASRUtils::extract_kind_from_ttype_t(arg_types[0]);
-        if ( kind == 4 ) {
-            c_func_name = "_lfortran_sp_rand_num";
-        } else {
-            c_func_name = "_lfortran_dp_rand_num";
-        }
         std::string new_name = "_lcompilers_random_number_";
+        int kind = ASRUtils::extract_kind_from_ttype_t(arg_types[0]);
+        ASR::ttype_t* element_type = ASRUtils::type_get_past_array(
+            ASRUtils::type_get_past_allocatable(arg_types[0]));
 
         declare_basic_variables(new_name);
         fill_func_arg_sub("r", arg_types[0], InOut);
-        SymbolTable *fn_symtab_1 = al.make_new<SymbolTable>(fn_symtab);
-        Vec<ASR::expr_t*> args_1; args_1.reserve(al, 0);
-        ASR::expr_t *return_var_1 = b.Variable(fn_symtab_1, c_func_name,
-           ASRUtils::type_get_past_array(ASRUtils::type_get_past_allocatable(arg_types[0])),
-           ASRUtils::intent_return_var, ASR::abiType::BindC, false);
-        SetChar dep_1; dep_1.reserve(al, 1);
-        Vec<ASR::stmt_t*> body_1; body_1.reserve(al, 1);
-        ASR::symbol_t *s = make_ASR_Function_t(c_func_name, fn_symtab_1, dep_1, args_1,
-            body_1, return_var_1, ASR::abiType::BindC, ASR::deftypeType::Interface, s2c(al, c_func_name));
-        fn_symtab->add_symbol(c_func_name, s);
-        dep.push_back(al, s2c(al, c_func_name));
-
-        if (ASRUtils::is_array(ASRUtils::expr_type(args[0]))) {
+
+        // Arrays that are known to be contiguous are filled by a single call
+        // to the runtime, others element by element
+        if (ASRUtils::is_contiguous_array(arg_types[0])) {
             /*
                 real :: b(3)
                 call random_number(b)
                     To
                 real :: b(3)
-                do i=lbound(b,1),ubound(b,1)
-                    call random_number(b(i))
-                end do
+                call _lfortran_random_number_r4(size(b, kind=8), b)
             */
-            ASR::dimension_t* array_dims = nullptr;
-            int array_rank = extract_dimensions_from_ttype(arg_types[0], array_dims);
-            std::vector<ASR::expr_t*> do_loop_variables;
-            for (int i = 0; i < array_rank; i++) {
-                do_loop_variables.push_back(declare("i_" + std::to_string(i), int32, Local));
+            std::string c_func_name = kind == 4 ? "_lfortran_random_number_r4"
+                : "_lfortran_random_number_r8";
+            SymbolTable *fn_symtab_1 = al.make_new<SymbolTable>(fn_symtab);
+            Vec<ASR::expr_t*> args_1; args_1.reserve(al, 2);
+            args_1.push_back(al, b.Variable(fn_symtab_1, "n", int64,
+                ASR::intentType::In, ASR::abiType::BindC, true));
+            ASR::dimension_t dim = b.set_dim(b.i32(1), nullptr);
+            ASR::ttype_t* data_type = ASRUtils::make_Array_t_util(al, loc,
+                element_type, &dim, 1, ASR::abiType::BindC, true);
+            args_1.push_back(al, b.Variable(fn_symtab_1, "v", data_type,
+                ASR::intentType::InOut, ASR::abiType::BindC, false));
+            SetChar dep_1; dep_1.reserve(al, 1);
+            Vec<ASR::stmt_t*> body_1; body_1.reserve(al, 1);
+            ASR::symbol_t *s = make_Function_Without_ReturnVar_t(c_func_name,
+                fn_symtab_1, dep_1, args_1, body_1, ASR::abiType::BindC,
+                ASR::deftypeType::Interface, s2c(al, c_func_name));
+            fn_symtab->add_symbol(c_func_name, s);
+            dep.push_back(al, s2c(al, c_func_name));
+
+            ASR::expr_t* data = args[0];
+            ASR::array_physical_typeType physical_type =
+                ASRUtils::extract_physical_type(arg_types[0]);
+            if (physical_type != ASR::array_physical_typeType::PointerToDataArray) {
+                data = ASRUtils::EXPR(ASRUtils::make_ArrayPhysicalCast_t_util(al, loc,
+                    args[0], physical_type, ASR::array_physical_typeType::PointerToDataArray,
+                    ASRUtils::duplicate_type(al, ASRUtils::type_get_past_allocatable(arg_types[0]),
+                        nullptr, ASR::array_physical_typeType::PointerToDataArray, true),
+                    nullptr));
             }
-            ASR::stmt_t* func_call = b.CallIntrinsicSubroutine(scope, {ASRUtils::type_get_past_array(ASRUtils::type_get_past_allocatable(arg_types[0]))},
-                                    {b.ArrayItem_01(args[0], do_loop_variables)}, 0, RandomNumber::instantiate_RandomNumber);
-            fn_name = scope->get_unique_name(fn_name, false);
-            body.push_back(al, PassUtils::create_do_loop_helper_random_number(al, loc, do_loop_variables, s, args[0],
-                    ASRUtils::type_get_past_array(ASRUtils::type_get_past_allocatable(arg_types[0])),
-                    b.ArrayItem_01(args[0], do_loop_variables), func_call, 1));
+            Vec<ASR::call_arg_t> call_args; call_args.reserve(al, 2);
+            ASR::call_arg_t call_arg;
+            call_arg.loc = loc;
+            call_arg.m_value = b.ArraySize(args[0], nullptr, int64);
+            call_args.push_back(al, call_arg);
+            call_arg.m_value = data;
+            call_args.push_back(al, call_arg);
+            body.push_back(al, b.SubroutineCall(s, call_args));
         } else {
-            Vec<ASR::expr_t*> call_args; call_args.reserve(al, 0);
-            body.push_back(al, b.Assignment(args[0], b.Call(s, call_args, arg_types[0])));
+            std::string c_func_name = kind == 4 ? "_lfortran_sp_rand_num"
+                : "_lfortran_dp_rand_num";
+            SymbolTable *fn_symtab_1 = al.make_new<SymbolTable>(fn_symtab);
+            Vec<ASR::expr_t*> args_1; args_1.reserve(al, 0);
+            ASR::expr_t *return_var_1 = b.Variable(fn_symtab_1, c_func_name,
+               element_type, ASRUtils::intent_return_var, ASR::abiType::BindC, false);
+            SetChar dep_1; dep_1.reserve(al, 1);
+            Vec<ASR::stmt_t*> body_1; body_1.reserve(al, 1);
+            ASR::symbol_t *s = make_ASR_Function_t(c_func_name, fn_symtab_1, dep_1, args_1,
+                body_1, return_var_1, ASR::abiType::BindC, ASR::deftypeType::Interface, s2c(al, c_func_name));
+            fn_symtab->add_symbol(c_func_name, s);
+            dep.push_back(al, s2c(al, c_func_name));
+
+            if (ASRUtils::is_array(ASRUtils::expr_type(args[0]))) {
+                /*
+                    real, pointer :: b(:)
+                    call random_number(b)
+                        To
+                    real, pointer :: b(:)
+                    do i=lbound(b,1),ubound(b,1)
+                        call random_number(b(i))
+                    end do
+                */
+                ASR::dimension_t* array_dims = nullptr;
+                int array_rank = extract_dimensions_from_ttype(arg_types[0], array_dims);
+                std::vector<ASR::expr_t*> do_loop_variables;
+                for (int i = 0; i < array_rank; i++) {
+                    do_loop_variables.push_back(declare("i_" + std::to_string(i), int32, Local));
+                }
+                ASR::stmt_t* func_call = b.CallIntrinsicSubroutine(scope, {element_type},
+                                        {b.ArrayItem_01(args[0], do_loop_variables)}, 0, RandomNumber::instantiate_RandomNumber);
+                fn_name = scope->get_unique_name(fn_name, false);
+                body.push_back(al, PassUtils::create_do_loop_helper_random_number(al, loc, do_loop_variables, s, args[0],
+                        element_type, b.ArrayItem_01(args[0], do_loop_variables), func_call, 1));
+            } else {
+                Vec<ASR::expr_t*> call_args; call_args.reserve(al, 0);
+                body.push_back(al, b.Assignment(args[0], b.Call(s, call_args, arg_types[0])));
+            }
         }
         ASR::symbol_t *new_symbol = make_ASR_Function_t(fn_name, fn_symtab, dep, args,
             body, nullptr, ASR::abiType::Source, ASR::deftypeType::Implementation, nullptr);
@@ -115,6 +162,186 @@ namespace RandomNumber {
 
 } // namespace RandomNumber
 
+namespace RandomSeed {
+
+    // `size`, `put` and `get` are all optional, only the present ones are
+    // stored. Bit 0, 1 and 2 of the overload id tell which ones are present.
+    enum Arg { Size = 1, Put = 2, Get = 4 };
+
+    static inline void verify_args(const ASR::IntrinsicImpureSubroutine_t& x, diag::Diagnostics& diagnostics) {
+        ASRUtils::require_impl(x.m_overload_id >= 0 && x.m_overload_id < 8,
+            "Overload Id for random_seed expected to be in [0, 7], found " + std::to_string(x.m_overload_id),
+            x.base.base.loc, diagnostics);
+        size_t n_present = 0;
+        for (int64_t bit = Size; bit <= Get; bit <<= 1) {
+            if (x.m_overload_id & bit) n_present++;
+        }
+        ASRUtils::require_impl(x.n_args == n_present, "Unexpected number of args, random_seed expects "
+            + std::to_string(n_present) + " arguments, found " + std::to_string(x.n_args),
+            x.base.base.loc, diagnostics);
+    }
+
+    static inline ASR::asr_t* create_RandomSeed(Allocator& al, const Location& loc, Vec<ASR::expr_t*>& args, diag::Diagnostics& diag) {
+        Vec<ASR::expr_t*> m_args; m_args.reserve(al, 3);
+        int64_t overload_id = 0;
+        int n_present = 0;
+        for (size_t i = 0; i < args.size(); i++) {
+            if (args[i] == nullptr) continue;
+            ASR::ttype_t* type = ASRUtils::expr_type(args[i]);
+            if (!ASRUtils::is_integer(*ASRUtils::type_get_past_array(
+                    ASRUtils::type_get_past_allocatable(ASRUtils::type_get_past_pointer(type))))) {
+                append_error(diag, "Arguments of random_seed must be of integer type", args[i]->base.loc);
+                return nullptr;
+            }
+            if (i == 0 && ASRUtils::is_array(type)) {
+                append_error(diag, "The `size` argument of random_seed must be a scalar", args[i]->base.loc);
+                return nullptr;
+            }
+            if (i > 0 && ASRUtils::extract_n_dims_from_ttype(type) != 1) {
+                append_error(diag, "The `put` and `get` arguments of random_seed must be arrays of rank 1",
+                    args[i]->base.loc);
+                return nullptr;
+            }
+            overload_id |= (int64_t) 1 << i;
+            m_args.push_back(al, args[i]);
+            n_present++;
+        }
+        if (n_present > 1) {
+            append_error(diag, "At most one argument of random_seed may be present", loc);
+            return nullptr;
+        }
+        return ASR::make_IntrinsicImpureSubroutine_t(al, loc, static_cast<int64_t>(IntrinsicImpureSubroutines::RandomSeed), m_args.p, m_args.n, overload_id);
+    }
+
+    static inline ASR::stmt_t* instantiate_RandomSeed(Allocator &al, const Location &loc,
+            SymbolTable *scope, Vec<ASR::ttype_t*>& arg_types,
+            Vec<ASR::call_arg_t>& new_args, int64_t overload_id) {
+        /*
+            call random_seed(put=s)
+                To
+            integer(4) :: seed(8)
+            do i = 1, 8
+                if (i <= size(s)) then
+                    seed(i) = s(lbound(s, 1) + i - 1)
+                else
+                    seed(i) = 0
+                end if
+            end do
+            call _lfortran_random_seed_put(seed)
+
+            and `get` the other way round. Without arguments the generator
+            is seeded from the clock.
+        */
+        const int64_t seed_size = 8; // LFORTRAN_RANDOM_SEED_SIZE in the runtime
+        std::string new_name = "_lcompilers_random_seed_";
+        declare_basic_variables(new_name);
+        if (overload_id & Size) fill_func_arg_sub("size", arg_types[args.size()], Out);
+        if (overload_id & Put) fill_func_arg_sub("put", arg_types[args.size()], In);
+        if (overload_id & Get) fill_func_arg_sub("get", arg_types[args.size()], Out);
+
+        auto c_interface = [&](std::string c_func_name, ASR::ttype_t* return_type,
+                ASR::intentType seed_intent) {
+            SymbolTable *fn_symtab_1 = al.make_new<SymbolTable>(fn_symtab);
+            Vec<ASR::expr_t*> args_1; args_1.reserve(al, 1);
+            if (return_type == nullptr) {
+                ASR::dimension_t dim = b.set_dim(b.i32(1), b.i32(seed_size));
+                ASR::ttype_t* seed_type = ASRUtils::make_Array_t_util(al, loc, int32,
+                    &dim, 1, ASR::abiType::BindC, true);
+                args_1.push_back(al, b.Variable(fn_symtab_1, "seed", seed_type,
+                    seed_intent, ASR::abiType::BindC, false));
+            }
+            SetChar dep_1; dep_1.reserve(al, 1);
+            Vec<ASR::stmt_t*> body_1; body_1.reserve(al, 1);
+            ASR::symbol_t *s;
+            if (return_type) {
+                ASR::expr_t *return_var_1 = b.Variable(fn_symtab_1, c_func_name,
+                    return_type, ASRUtils::intent_return_var, ASR::abiType::BindC, false);
+                s = make_ASR_Function_t(c_func_name, fn_symtab_1, dep_1, args_1,
+                    body_1, return_var_1, ASR::abiType::BindC, ASR::deftypeType::Interface,
+                    s2c(al, c_func_name));
+            } else {
+                s = make_Function_Without_ReturnVar_t(c_func_name, fn_symtab_1, dep_1,
+                    args_1, body_1, ASR::abiType::BindC, ASR::deftypeType::Interface,
+                    s2c(al, c_func_name));
+            }
+            fn_symtab->add_symbol(c_func_name, s);
+            dep.push_back(al, s2c(al, c_func_name));
+            return s;
+        };
+        auto cast_to = [&](ASR::expr_t* x, ASR::ttype_t* type) {
+            if (ASRUtils::extract_kind_from_ttype_t(type) ==
+                    ASRUtils::extract_kind_from_ttype_t(ASRUtils::expr_type(x))) {
+                return x;
+            }
+            return b.i2i_t(x, ASRUtils::type_get_past_array(
+                ASRUtils::type_get_past_allocatable(ASRUtils::type_get_past_pointer(type))));
+        };
+        auto seed_call = [&](ASR::symbol_t* s, ASR::expr_t* seed) {
+            Vec<ASR::call_arg_t> call_args; call_args.reserve(al, 1);
+            ASR::call_arg_t call_arg;
+            call_arg.loc = loc;
+            call_arg.m_value = ASRUtils::EXPR(ASRUtils::make_ArrayPhysicalCast_t_util(al, loc,
+                seed, ASR::array_physical_typeType::FixedSizeArray,
+                ASR::array_physical_typeType::PointerToDataArray,
+                ASRUtils::duplicate_type(al, ASRUtils::expr_type(seed), nullptr,
+                    ASR::array_physical_typeType::PointerToDataArray, true), nullptr));
+            call_args.push_back(al, call_arg);
+            return b.SubroutineCall(s, call_args);
+        };
+
+        size_t i_arg = 0;
+        if (overload_id & Size) {
+            ASR::symbol_t* s = c_interface("_lfortran_random_seed_size", int32, ASR::intentType::In);
+            Vec<ASR::expr_t*> call_args; call_args.reserve(al, 0);
+            body.push_back(al, b.Assignment(args[i_arg],
+                cast_to(b.Call(s, call_args, int32), arg_types[i_arg])));
+            i_arg++;
+        }
+        if (overload_id & (Put | Get)) {
+            ASR::expr_t* seed = declare("seed", b.Array({seed_size}, int32), Local);
+            ASR::expr_t* i = declare("i", int32, Local);
+            ASR::expr_t* user_seed = args[i_arg];
+            ASR::expr_t* user_item = b.ArrayItem_01(user_seed, {b.Add(b.Sub(
+                b.ArrayLBound(user_seed, 1), b.i32(1)), i)});
+            ASR::expr_t* seed_item = b.ArrayItem_01(seed, {i});
+            ASR::expr_t* in_bounds = b.LtE(i, b.ArraySize(user_seed, nullptr, int32));
+            if (overload_id & Put) {
+                ASR::symbol_t* s = c_interface("_lfortran_random_seed_put", nullptr, ASR::intentType::In);
+                body.push_back(al, b.DoLoop(i, b.i32(1), b.i32(seed_size), {
+                    b.If(in_bounds, {b.Assignment(seed_item, cast_to(user_item, int32))},
+                        {b.Assignment(seed_item, b.i32(0))})
+                }));
+                body.push_back(al, seed_call(s, seed));
+            } else {
+                ASR::symbol_t* s = c_interface("_lfortran_random_seed_get", nullptr, ASR::intentType::Out);
+                body.push_back(al, seed_call(s, seed));
+                body.push_back(al, b.DoLoop(i, b.i32(1), b.i32(seed_size), {
+                    b.If(in_bounds, {b.Assignment(user_item, cast_to(seed_item, arg_types[i_arg]))}, {})
+                }));
+            }
+        }
+        if (overload_id == 0) {
+            std::string c_func_name = "_lfortran_init_random_clock";
+            SymbolTable *fn_symtab_1 = al.make_new<SymbolTable>(fn_symtab);
+            Vec<ASR::expr_t*> args_1; args_1.reserve(al, 0);
+            SetChar dep_1; dep_1.reserve(al, 1);
+            Vec<ASR::stmt_t*> body_1; body_1.reserve(al, 1);
+            ASR::symbol_t *s = make_Function_Without_ReturnVar_t(c_func_name,
+                fn_symtab_1, dep_1, args_1, body_1, ASR::abiType::BindC,
+                ASR::deftypeType::Interface, s2c(al, c_func_name));
+            fn_symtab->add_symbol(c_func_name, s);
+            dep.push_back(al, s2c(al, c_func_name));
+            Vec<ASR::call_arg_t> call_args; call_args.reserve(al, 0);
+            body.push_back(al, b.SubroutineCall(s, call_args));
+        }
+        ASR::symbol_t *new_symbol = make_ASR_Function_t(fn_name, fn_symtab, dep, args,
+            body, nullptr, ASR::abiType::Source, ASR::deftypeType::Implementation, nullptr);
+        scope->add_symbol(fn_name, new_symbol);
+        return b.SubroutineCall(new_symbol, new_args);
+    }
+
+} // namespace RandomSeed
+
 } // namespace LCompilers::ASRUtils
 
 #endif // LIBASR_PASS_INTRINSIC_SUBROUTINES_H
@@ -74,7 +74,7 @@ class ReplaceArrayVariable: public ASR::BaseExprReplacer<ReplaceArrayVariable> {
                 ASRUtils::symbol_parent_symtab(x->m_v)->counter == current_scope->counter) {
                 // TODO: Ideally we shall not need any check for the symbol parent symtab
                 // This is a bug where somehow it changes symbol present in lcompilers_function or say not of the current_scope
-                ASR::symbol_t* sym = current_scope->get_symbol(std::string(ASRUtils::symbol_name(x->m_v)));
+                ASR::symbol_t* sym = current_scope->get_symbol(ASRUtils::symbol_name(x->m_v));
                 LCOMPILERS_ASSERT(sym != nullptr);
                 *current_expr = b.Var(sym);
             }
@@ -86,7 +86,7 @@ class ReplaceArrayVariable: public ASR::BaseExprReplacer<ReplaceArrayVariable> {
                 ASR::Var_t* var = ASR::down_cast<ASR::Var_t>(x->m_arg);
                 if (std::find(array_variables.begin(), array_variables.end(), ASRUtils::symbol_name(var->m_v)) != array_variables.end() &&
                     ASRUtils::symbol_parent_symtab(var->m_v)->counter == current_scope->counter) {
-                    ASR::symbol_t* sym = current_scope->get_symbol(std::string(ASRUtils::symbol_name(var->m_v)));
+                    ASR::symbol_t* sym = current_scope->get_symbol(ASRUtils::symbol_name(var->m_v));
                     LCOMPILERS_ASSERT(sym != nullptr);
                     *current_expr = b.Var(sym);
                 }
@@ -2,6 +2,7 @@
 #define LCOMPILERS_PASS_MANAGER_H
 
 #include <libasr/asr.h>
+#include <libasr/asr_utils.h>
 #include <libasr/string_utils.h>
 #include <libasr/alloc.h>
 
@@ -63,12 +64,116 @@
 #include <vector>
 #include <algorithm>
 #include <fstream>
+#include <chrono>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
 
 namespace LCompilers {
 
     typedef void (*pass_function)(Allocator&, ASR::TranslationUnit_t&,
                                   const LCompilers::PassOptions&);
 
+    // Counts the statements, expressions and types of an ASR
+    class ASRNodeCounter : public ASR::BaseWalkVisitor<ASRNodeCounter> {
+        public:
+
+        size_t n = 0;
+
+        void visit_stmt(const ASR::stmt_t &b) {
+            n++;
+            ASR::BaseWalkVisitor<ASRNodeCounter>::visit_stmt(b);
+        }
+
+        void visit_expr(const ASR::expr_t &b) {
+            n++;
+            ASR::BaseWalkVisitor<ASRNodeCounter>::visit_expr(b);
+        }
+
+        void visit_ttype(const ASR::ttype_t &b) {
+            n++;
+            ASR::BaseWalkVisitor<ASRNodeCounter>::visit_ttype(b);
+        }
+    };
+
+    static inline size_t count_symbols(const SymbolTable &symtab) {
+        size_t n = symtab.get_scope().size();
+        for (auto &item : symtab.get_scope()) {
+            SymbolTable *s = nullptr;
+            if (ASR::is_a<ASR::Class_t>(*item.second)) {
+                s = ASR::down_cast<ASR::Class_t>(item.second)->m_symtab;
+            } else if (!ASR::is_a<ASR::CustomOperator_t>(*item.second)) {
+                s = ASRUtils::symbol_symtab(item.second);
+            }
+            if (s) {
+                n += count_symbols(*s);
+            }
+        }
+        return n;
+    }
+
+    // Number of symbols, statements, expressions and types in `asr`
+    static inline size_t count_asr_nodes(ASR::TranslationUnit_t &asr) {
+        ASRNodeCounter v;
+        v.visit_TranslationUnit(asr);
+        return v.n + count_symbols(*asr.m_symtab);
+    }
+
+    // Time and memory used by one pass, for `--time-report`
+    struct PassReport {
+        std::string name;
+        double time_ms;
+        size_t nodes_before, nodes_after;
+        // Growth of the Allocator during the pass
+        size_t arena_bytes, arena_chunks;
+    };
+
+    static inline void print_pass_reports(const std::vector<PassReport> &reports,
+            bool json) {
+        std::stringstream out;
+        double total = 0;
+        for (auto &r : reports) {
+            total += r.time_ms;
+        }
+        out << std::fixed << std::setprecision(3);
+        if (json) {
+            out << "{\"passes\": [";
+            for (size_t i = 0; i < reports.size(); i++) {
+                const PassReport &r = reports[i];
+                if (i > 0) out << ", ";
+                out << "{\"name\": \"" << r.name << "\", "
+                    << "\"time_ms\": " << r.time_ms << ", "
+                    << "\"nodes_before\": " << r.nodes_before << ", "
+                    << "\"nodes_after\": " << r.nodes_after << ", "
+                    << "\"arena_bytes\": " << r.arena_bytes << ", "
+                    << "\"arena_chunks\": " << r.arena_chunks << "}";
+            }
+            out << "], \"total_time_ms\": " << total << "}" << std::endl;
+        } else {
+            out << "ASR passes time report:" << std::endl;
+            out << std::left << std::setw(36) << "Pass" << std::right
+                << std::setw(12) << "Time (ms)"
+                << std::setw(14) << "Nodes before"
+                << std::setw(13) << "Nodes after"
+                << std::setw(13) << "Arena (KB)"
+                << std::setw(8) << "Chunks" << std::endl;
+            for (auto &r : reports) {
+                out << std::left << std::setw(36) << r.name << std::right
+                    << std::setw(12) << r.time_ms
+                    << std::setw(14) << r.nodes_before
+                    << std::setw(13) << r.nodes_after
+                    << std::setw(13) << r.arena_bytes / 1024.
+                    << std::setw(8) << r.arena_chunks << std::endl;
+            }
+            out << std::left << std::setw(36) << "Total" << std::right
+                << std::setw(12) << total << std::endl;
+        }
+        // Files compiled in parallel print their reports one at a time
+        static std::mutex print_mutex;
+        std::lock_guard<std::mutex> lock(print_mutex);
+        std::cout << out.str();
+    }
+
     class PassManager {
         private:
 
@@ -150,6 +255,7 @@ namespace LCompilers {
                         passes.push_back(_with_optimization_passes[i]);
                 }
             }
+            std::vector<PassReport> reports;
             for (size_t i = 0; i < passes.size(); i++) {
                 // TODO: rework the whole pass manager: construct the passes
                 // ahead of time (not at the last minute), and remove this much
@@ -166,7 +272,25 @@ namespace LCompilers {
                 if (pass_options.verbose) {
                     std::cerr << "ASR Pass starts: '" << passes[i] << "'\n";
                 }
+                PassReport report{};
+                if (pass_options.time_report) {
+                    report.name = passes[i];
+                    report.nodes_before = reports.empty()
+                        ? count_asr_nodes(*asr) : reports.back().nodes_after;
+                    report.arena_bytes = al.size_used();
+                    report.arena_chunks = al.num_chunks();
+                }
+                auto t1 = std::chrono::high_resolution_clock::now();
                 _passes_db[passes[i]](al, *asr, pass_options);
+                auto t2 = std::chrono::high_resolution_clock::now();
+                if (pass_options.time_report) {
+                    report.time_ms = std::chrono::duration<double,
+                        std::milli>(t2 - t1).count();
+                    report.nodes_after = count_asr_nodes(*asr);
+                    report.arena_bytes = al.size_used() - report.arena_bytes;
+                    report.arena_chunks = al.num_chunks() - report.arena_chunks;
+                    reports.push_back(report);
+                }
 #if defined(WITH_LFORTRAN_ASSERT)
                 if (!asr_verify(*asr, true, diagnostics)) {
                     std::cerr << diagnostics.render2();
@@ -178,6 +302,9 @@ namespace LCompilers {
                     std::cerr << "ASR Pass ends: '" << passes[i] << "'\n";
                 }
             }
+            if (pass_options.time_report) {
+                print_pass_reports(reports, pass_options.time_report_json);
+            }
         }
 
         void _parse_pass_arg(std::string& arg, std::vector<std::string>& passes) {
@@ -40,19 +40,106 @@ to:
         print *, b(i)
     end do
     print *, c, d
+
+When the backend formats whole arrays itself (`formatted_array_io`), a
+formatted print or write whose array items are all whole arrays of
+numbers or logicals is left as it is:
+
+    print "(3f8.3)", a, b
+
+is formatted by a single runtime call that walks `a` and `b` through
+their descriptors, instead of a loop formatting one element at a time.
+Unformatted writes of such arrays, and of sections of them, are kept as
+well, so that
+
+    write(10) a, b(1:n:2)
+
+transfers both arrays in one record with bulk copies.
 */
 
 class PrintArrVisitor : public PassUtils::PassVisitor<PrintArrVisitor>
 {
 private:
     std::string rl_path;
+    bool formatted_array_io;
 public:
-    PrintArrVisitor(Allocator &al, const std::string &rl_path_) : PassVisitor(al, nullptr),
-    rl_path(rl_path_) {
+    PrintArrVisitor(Allocator &al, const std::string &rl_path_,
+        bool formatted_array_io_) : PassVisitor(al, nullptr),
+    rl_path(rl_path_), formatted_array_io(formatted_array_io_) {
         pass_result.reserve(al, 1);
 
     }
 
+    bool is_whole_array_format_arg(ASR::expr_t* arr_expr) {
+        if( !ASR::is_a<ASR::Var_t>(*arr_expr) ) {
+            return false;
+        }
+        ASR::ttype_t* type = ASRUtils::expr_type(arr_expr);
+        ASR::ttype_t* el_type = ASRUtils::type_get_past_array(
+            ASRUtils::type_get_past_allocatable(ASRUtils::type_get_past_pointer(type)));
+        int kind = ASRUtils::extract_kind_from_ttype_t(el_type);
+        if( !((ASRUtils::is_integer(*el_type) && (kind == 1 || kind == 2 || kind == 4 || kind == 8)) ||
+              ((ASRUtils::is_real(*el_type) || ASRUtils::is_complex(*el_type)) && (kind == 4 || kind == 8)) ||
+              ASRUtils::is_logical(*el_type)) ) {
+            return false;
+        }
+        switch( ASRUtils::extract_physical_type(type) ) {
+            case ASR::array_physical_typeType::DescriptorArray: {
+                return true;
+            }
+            case ASR::array_physical_typeType::FixedSizeArray:
+            case ASR::array_physical_typeType::PointerToDataArray: {
+                // The backend builds a descriptor from the dimensions,
+                // which are not known for assumed size arrays
+                ASR::dimension_t* m_dims = nullptr;
+                size_t n_dims = ASRUtils::extract_dimensions_from_ttype(type, m_dims);
+                for( size_t i = 0; i < n_dims; i++ ) {
+                    if( m_dims[i].m_start == nullptr || m_dims[i].m_length == nullptr ) {
+                        return false;
+                    }
+                }
+                return true;
+            }
+            default: {
+                return false;
+            }
+        }
+    }
+
+    // Whether the backend transfers `arr_expr` in an unformatted write
+    // itself: a whole array like for `is_whole_array_format_arg`, or a
+    // section of one, which is passed as a descriptor
+    bool is_unformatted_array_arg(ASR::expr_t* arr_expr) {
+        if( ASR::is_a<ASR::ArraySection_t>(*arr_expr) ) {
+            ASR::ArraySection_t* section = ASR::down_cast<ASR::ArraySection_t>(arr_expr);
+            if( section->m_value ) {
+                return false;
+            }
+            for( size_t i = 0; i < section->n_args; i++ ) {
+                ASR::array_index_t &arg = section->m_args[i];
+                if( arg.m_right == nullptr ||
+                    (arg.m_step && arg.m_left == nullptr) ) {
+                    return false;
+                }
+            }
+            arr_expr = section->m_v;
+        }
+        return is_whole_array_format_arg(arr_expr);
+    }
+
+    bool format_whole_arrays(ASR::StringFormat_t* format) {
+        if( !formatted_array_io ) {
+            return false;
+        }
+        for( size_t i = 0; i < format->n_args; i++ ) {
+            if( PassUtils::is_array(format->m_args[i]) &&
+                !is_whole_array_format_arg(format->m_args[i]) ) {
+                return false;
+            }
+        }
+        return true;
+    }
+
     ASR::stmt_t* print_array_using_doloop(ASR::expr_t *arr_expr, ASR::StringFormat_t* format, const Location &loc) {
         int n_dims = PassUtils::get_rank(arr_expr);
         Vec<ASR::expr_t*> idx_vars;
@@ -148,7 +235,7 @@ public:
                 print_args.p, print_args.size(), nullptr, nullptr));
         } else if (_type == ASR::stmtType::FileWrite) {
             statement = ASRUtils::STMT(ASR::make_FileWrite_t(al, loc, 0, unit,
-                nullptr, nullptr, nullptr, print_args.p, print_args.size(), separator, end, overloaded));
+                nullptr, nullptr, nullptr, print_args.p, print_args.size(), separator, end, overloaded, true, false));
         }
         print_body.clear();
         return statement;
@@ -162,6 +249,9 @@ public:
             empty_print_endl = ASRUtils::STMT(ASR::make_Print_t(al, x.base.base.loc,
                 nullptr, 0, nullptr, nullptr));
             ASR::StringFormat_t* format = ASR::down_cast<ASR::StringFormat_t>(x.m_values[0]);
+            if (format_whole_arrays(format)) {
+                return;
+            }
             for (size_t i=0; i<format->n_args; i++) {
                 if (PassUtils::is_array(format->m_args[i])) {
                     if (ASRUtils::is_fixed_size_array(ASRUtils::expr_type(format->m_args[i]))) {
@@ -255,7 +345,8 @@ public:
         }
     }
 
-    ASR::stmt_t* write_array_using_doloop(ASR::expr_t *arr_expr, ASR::StringFormat_t* format, ASR::expr_t* unit, const Location &loc) {
+    ASR::stmt_t* write_array_using_doloop(ASR::expr_t *arr_expr, ASR::StringFormat_t* format, ASR::expr_t* unit,
+        bool is_formatted, const Location &loc) {
         int n_dims = PassUtils::get_rank(arr_expr);
         Vec<ASR::expr_t*> idx_vars;
         PassUtils::create_idx_vars(idx_vars, n_dims, loc, al, current_scope);
@@ -265,7 +356,7 @@ public:
         ASR::expr_t *empty_space = ASRUtils::EXPR(ASR::make_StringConstant_t(
             al, loc, s2c(al, ""), str_type_len));
         ASR::stmt_t* empty_file_write_endl = ASRUtils::STMT(ASR::make_FileWrite_t(al, loc,
-                0, unit, nullptr, nullptr, nullptr, nullptr, 0, nullptr, nullptr, nullptr));
+                0, unit, nullptr, nullptr, nullptr, nullptr, 0, nullptr, nullptr, nullptr, true, false));
         for( int i = n_dims - 1; i >= 0; i-- ) {
             ASR::do_loop_head_t head;
             head.m_v = idx_vars[i];
@@ -290,16 +381,18 @@ public:
                     format_args.push_back(al, string_format);
                     write_stmt = ASRUtils::STMT(ASR::make_FileWrite_t(
                         al, loc, i, unit, nullptr, nullptr, nullptr,
-                        format_args.p, format_args.size(), nullptr, empty_space, nullptr));
+                        format_args.p, format_args.size(), nullptr, empty_space, nullptr, true, false));
                 } else {
                     write_stmt = ASRUtils::STMT(ASR::make_FileWrite_t(
                         al, loc, i, unit, nullptr, nullptr, nullptr,
-                        print_args.p, print_args.size(), nullptr, nullptr, nullptr));
+                        print_args.p, print_args.size(), nullptr, nullptr, nullptr, is_formatted, false));
                 }
                 doloop_body.push_back(al, write_stmt);
             } else {
                 doloop_body.push_back(al, doloop);
-                doloop_body.push_back(al, empty_file_write_endl);
+                if (is_formatted) {
+                    doloop_body.push_back(al, empty_file_write_endl);
+                }
             }
             doloop = ASRUtils::STMT(ASR::make_DoLoop_t(al, loc, nullptr, head, doloop_body.p, doloop_body.size(), nullptr, 0));
         }
@@ -311,7 +404,8 @@ public:
         body.from_pointer_n_copy(al, write_body.data(), write_body.size());
         ASR::stmt_t* write_stmt = ASRUtils::STMT(ASR::make_FileWrite_t(
             al, x.base.base.loc, x.m_label, x.m_unit, x.m_iomsg,
-            x.m_iostat, x.m_id, body.p, body.size(), x.m_separator, x.m_end, x.m_overloaded));
+            x.m_iostat, x.m_id, body.p, body.size(), x.m_separator, x.m_end, x.m_overloaded, x.m_is_formatted,
+            x.m_is_asynchronous));
         pass_result.push_back(al, write_stmt);
         write_body.clear();
     }
@@ -321,12 +415,25 @@ public:
             // Skip for character write
             return;
         }
+        if (!x.m_is_formatted && formatted_array_io) {
+            bool whole_arrays = true;
+            for (size_t i = 0; i < x.n_values && whole_arrays; i++) {
+                whole_arrays = !PassUtils::is_array(x.m_values[i]) ||
+                    is_unformatted_array_arg(x.m_values[i]);
+            }
+            if (whole_arrays) {
+                return;
+            }
+        }
         std::vector<ASR::expr_t*> write_body;
         ASR::stmt_t* write_stmt;
         ASR::stmt_t* empty_file_write_endl = ASRUtils::STMT(ASR::make_FileWrite_t(al, x.base.base.loc,
-            x.m_label, x.m_unit, nullptr, nullptr, nullptr, nullptr, 0, nullptr, nullptr, nullptr));
+            x.m_label, x.m_unit, nullptr, nullptr, nullptr, nullptr, 0, nullptr, nullptr, nullptr, true, false));
         if(x.m_values && x.m_values[0] != nullptr && ASR::is_a<ASR::StringFormat_t>(*x.m_values[0])){
             ASR::StringFormat_t* format = ASR::down_cast<ASR::StringFormat_t>(x.m_values[0]);
+            if (format_whole_arrays(format)) {
+                return;
+            }
             for (size_t i=0; i<format->n_args; i++) {
                 if (PassUtils::is_array(format->m_args[i])) {
                     if (ASRUtils::is_fixed_size_array(ASRUtils::expr_type(format->m_args[i]))) {
@@ -338,7 +445,7 @@ public:
                                 x.m_end, x.m_overloaded);
                             pass_result.push_back(al, write_stmt);
                         }
-                        write_stmt = write_array_using_doloop(format->m_args[i], format, x.m_unit, x.base.base.loc);
+                        write_stmt = write_array_using_doloop(format->m_args[i], format, x.m_unit, true, x.base.base.loc);
                         pass_result.push_back(al, write_stmt);
                         pass_result.push_back(al, empty_file_write_endl);
                     }
@@ -361,11 +468,16 @@ public:
             if (PassUtils::is_array(x.m_values[i])) {
                 if (write_body.size() > 0) {
                     print_args_apart_from_arrays(write_body, x);
-                    pass_result.push_back(al, empty_file_write_endl);
+                    if (x.m_is_formatted) {
+                        pass_result.push_back(al, empty_file_write_endl);
+                    }
                 }
-                write_stmt = write_array_using_doloop(x.m_values[i], nullptr, x.m_unit, x.base.base.loc);
+                write_stmt = write_array_using_doloop(x.m_values[i], nullptr, x.m_unit,
+                    x.m_is_formatted, x.base.base.loc);
                 pass_result.push_back(al, write_stmt);
-                pass_result.push_back(al, empty_file_write_endl);
+                if (x.m_is_formatted) {
+                    pass_result.push_back(al, empty_file_write_endl);
+                }
             } else {
                 write_body.push_back(x.m_values[i]);
             }
@@ -380,7 +492,7 @@ public:
 void pass_replace_print_arr(Allocator &al, ASR::TranslationUnit_t &unit,
                             const LCompilers::PassOptions& pass_options) {
     std::string rl_path = pass_options.runtime_library_dir;
-    PrintArrVisitor v(al, rl_path);
+    PrintArrVisitor v(al, rl_path, pass_options.formatted_array_io);
     v.visit_TranslationUnit(unit);
 }
 
@@ -308,14 +308,20 @@ class SymbolRenameVisitor: public ASR::BaseWalkVisitor<SymbolRenameVisitor> {
 class UniqueSymbolVisitor: public ASR::BaseWalkVisitor<UniqueSymbolVisitor> {
     private:
 
-    Allocator& al;
+    // A renamed symbol is referenced from many places (dependencies,
+    // ExternalSymbols, ...), allocate each new name only once
+    StringInterner new_names;
+
+    char* new_name(ASR::symbol_t *sym) {
+        return new_names.intern(sym_to_new_name[sym]);
+    }
 
     public:
     std::unordered_map<ASR::symbol_t*, std::string>& sym_to_new_name;
     std::map<std::string, ASR::symbol_t*> current_scope;
 
     UniqueSymbolVisitor(Allocator& al_,
-    std::unordered_map<ASR::symbol_t*, std::string> &sn) : al(al_), sym_to_new_name(sn){}
+    std::unordered_map<ASR::symbol_t*, std::string> &sn) : new_names(al_), sym_to_new_name(sn){}
 
 
     void visit_TranslationUnit(const ASR::TranslationUnit_t &x) {
@@ -340,13 +346,13 @@ class UniqueSymbolVisitor: public ASR::BaseWalkVisitor<UniqueSymbolVisitor> {
         std::map<std::string, ASR::symbol_t*> current_scope_copy = current_scope;
         ASR::symbol_t *sym = ASR::down_cast<ASR::symbol_t>((ASR::asr_t*)&x);
         if (sym_to_new_name.find(sym) != sym_to_new_name.end()) {
-            xx.m_name = s2c(al, sym_to_new_name[sym]);
+            xx.m_name = new_name(sym);
         }
         for (size_t i=0; i<xx.n_dependencies; i++) {
             if (current_scope.find(xx.m_dependencies[i]) != current_scope.end()) {
                 sym = current_scope[xx.m_dependencies[i]];
                 if (sym_to_new_name.find(sym) != sym_to_new_name.end()) {
-                    xx.m_dependencies[i] = s2c(al, sym_to_new_name[sym]);
+                    xx.m_dependencies[i] = new_name(sym);
                 }
             }
         }
@@ -379,7 +385,7 @@ class UniqueSymbolVisitor: public ASR::BaseWalkVisitor<UniqueSymbolVisitor> {
         ASR::GenericProcedure_t& xx = const_cast<ASR::GenericProcedure_t&>(x);
         ASR::symbol_t *sym = ASR::down_cast<ASR::symbol_t>((ASR::asr_t*)&x);
         if (sym_to_new_name.find(sym) != sym_to_new_name.end()) {
-            xx.m_name = s2c(al, sym_to_new_name[sym]);
+            xx.m_name = new_name(sym);
         }
     }
 
@@ -387,7 +393,7 @@ class UniqueSymbolVisitor: public ASR::BaseWalkVisitor<UniqueSymbolVisitor> {
         ASR::CustomOperator_t& xx = const_cast<ASR::CustomOperator_t&>(x);
         ASR::symbol_t *sym = ASR::down_cast<ASR::symbol_t>((ASR::asr_t*)&x);
         if (sym_to_new_name.find(sym) != sym_to_new_name.end()) {
-            xx.m_name = s2c(al, sym_to_new_name[sym]);
+            xx.m_name = new_name(sym);
         }
     }
 
@@ -395,15 +401,15 @@ class UniqueSymbolVisitor: public ASR::BaseWalkVisitor<UniqueSymbolVisitor> {
         ASR::ExternalSymbol_t& xx = const_cast<ASR::ExternalSymbol_t&>(x);
         ASR::symbol_t *sym = ASR::down_cast<ASR::symbol_t>((ASR::asr_t*)&x);
         if (sym_to_new_name.find(sym) != sym_to_new_name.end()) {
-            xx.m_name = s2c(al, sym_to_new_name[sym]);
+            xx.m_name = new_name(sym);
         }
         SymbolTable* s = ASRUtils::symbol_parent_symtab(x.m_external);
         ASR::symbol_t *asr_owner = ASR::down_cast<ASR::symbol_t>(s->asr_owner);
         if (sym_to_new_name.find(x.m_external) != sym_to_new_name.end()) {
-            xx.m_original_name = s2c(al, sym_to_new_name[x.m_external]);
+            xx.m_original_name = new_name(x.m_external);
         }
         if (sym_to_new_name.find(asr_owner) != sym_to_new_name.end()) {
-            xx.m_module_name = s2c(al, sym_to_new_name[asr_owner]);
+            xx.m_module_name = new_name(asr_owner);
         }
     }
 
@@ -412,14 +418,14 @@ class UniqueSymbolVisitor: public ASR::BaseWalkVisitor<UniqueSymbolVisitor> {
         T& xx = const_cast<T&>(x);
         ASR::symbol_t *sym = ASR::down_cast<ASR::symbol_t>((ASR::asr_t*)&x);
         if (sym_to_new_name.find(sym) != sym_to_new_name.end()) {
-            xx.m_name = s2c(al, sym_to_new_name[sym]);
+            xx.m_name = new_name(sym);
         }
         std::map<std::string, ASR::symbol_t*> current_scope_copy = current_scope;
         for (size_t i=0; i<xx.n_dependencies; i++) {
             if (current_scope.find(xx.m_dependencies[i]) != current_scope.end()) {
                 sym = current_scope[xx.m_dependencies[i]];
                 if (sym_to_new_name.find(sym) != sym_to_new_name.end()) {
-                    xx.m_dependencies[i] = s2c(al, sym_to_new_name[sym]);
+                    xx.m_dependencies[i] = new_name(sym);
                 }
             }
         }
@@ -428,7 +434,7 @@ class UniqueSymbolVisitor: public ASR::BaseWalkVisitor<UniqueSymbolVisitor> {
             if (current_scope.find(xx.m_members[i]) != current_scope.end()) {
                 sym = current_scope[xx.m_members[i]];
                 if (sym_to_new_name.find(sym) != sym_to_new_name.end()) {
-                    xx.m_members[i] = s2c(al, sym_to_new_name[sym]);
+                    xx.m_members[i] = new_name(sym);
                 }
             }
         }
@@ -460,13 +466,13 @@ class UniqueSymbolVisitor: public ASR::BaseWalkVisitor<UniqueSymbolVisitor> {
         ASR::Variable_t& xx = const_cast<ASR::Variable_t&>(x);
         ASR::symbol_t *sym = ASR::down_cast<ASR::symbol_t>((ASR::asr_t*)&x);
         if (sym_to_new_name.find(sym) != sym_to_new_name.end()) {
-            xx.m_name = s2c(al, sym_to_new_name[sym]);
+            xx.m_name = new_name(sym);
         }
         for (size_t i=0; i<xx.n_dependencies; i++) {
             if (current_scope.find(xx.m_dependencies[i]) != current_scope.end()) {
                 sym = current_scope[xx.m_dependencies[i]];
                 if (sym_to_new_name.find(sym) != sym_to_new_name.end()) {
-                    xx.m_dependencies[i] = s2c(al, sym_to_new_name[sym]);
+                    xx.m_dependencies[i] = new_name(sym);
                 }
             }
         }
@@ -476,7 +482,7 @@ class UniqueSymbolVisitor: public ASR::BaseWalkVisitor<UniqueSymbolVisitor> {
         ASR::Class_t& xx = const_cast<ASR::Class_t&>(x);
         ASR::symbol_t *sym = ASR::down_cast<ASR::symbol_t>((ASR::asr_t*)&x);
         if (sym_to_new_name.find(sym) != sym_to_new_name.end()) {
-            xx.m_name = s2c(al, sym_to_new_name[sym]);
+            xx.m_name = new_name(sym);
         }
         std::map<std::string, ASR::symbol_t*> current_scope_copy = current_scope;
         current_scope = x.m_symtab->get_scope();
@@ -496,7 +502,7 @@ class UniqueSymbolVisitor: public ASR::BaseWalkVisitor<UniqueSymbolVisitor> {
         ASR::ClassProcedure_t& xx = const_cast<ASR::ClassProcedure_t&>(x);
         ASR::symbol_t *sym = ASR::down_cast<ASR::symbol_t>((ASR::asr_t*)&x);
         if (sym_to_new_name.find(sym) != sym_to_new_name.end()) {
-            xx.m_name = s2c(al, sym_to_new_name[sym]);
+            xx.m_name = new_name(sym);
         }
     }
 
@@ -505,7 +511,7 @@ class UniqueSymbolVisitor: public ASR::BaseWalkVisitor<UniqueSymbolVisitor> {
         T& xx = const_cast<T&>(x);
         ASR::symbol_t *sym = ASR::down_cast<ASR::symbol_t>((ASR::asr_t*)&x);
         if (sym_to_new_name.find(sym) != sym_to_new_name.end()) {
-            xx.m_name = s2c(al, sym_to_new_name[sym]);
+            xx.m_name = new_name(sym);
         }
         std::map<std::string, ASR::symbol_t*> current_scope_copy = current_scope;
         current_scope = x.m_symtab->get_scope();
@@ -1,5 +1,6 @@
 #include <libasr/asr.h>
 #include <libasr/location.h>
+#include <libasr/pickle.h>
 #include <libasr/asr_utils.h>
 #include <libasr/pass/intrinsic_function_registry.h>
 #include <libasr/pass/intrinsic_array_function_registry.h>
@@ -17,7 +18,8 @@ public:
         return s;
     }
     void visit_symbol(const ASR::symbol_t &x) {
-        s.append(ASRUtils::symbol_parent_symtab(&x)->get_counter());
+        s.append(show_counters
+            ? ASRUtils::symbol_parent_symtab(&x)->get_counter() : "_");
         s.append(" ");
         if (use_colors) {
             s.append(color(fg::yellow));
@@ -171,11 +173,12 @@ public:
 };
 
 std::string pickle(ASR::asr_t &asr, bool colors, bool indent,
-        bool show_intrinsic_modules) {
+        bool show_intrinsic_modules, bool show_counters) {
     ASRPickleVisitor v;
     v.use_colors = colors;
     v.indent = indent;
     v.show_intrinsic_modules = show_intrinsic_modules;
+    v.show_counters = show_counters;
     v.visit_asr(asr);
     return v.get_str();
 }
@@ -6,9 +6,10 @@
 
 namespace LCompilers {
 
-    // Pickle an ASR node
+    // Pickle an ASR node. Without `show_counters` the IDs of the symbol
+    // tables are printed as `_`, so that the result only depends on the node.
     std::string pickle(ASR::asr_t &asr, bool colors=false, bool indent=false,
-            bool show_intrinsic_modules=false);
+            bool show_intrinsic_modules=false, bool show_counters=true);
     std::string pickle(ASR::TranslationUnit_t &asr, bool colors=false,
             bool indent=false, bool show_intrinsic_modules=false);
 
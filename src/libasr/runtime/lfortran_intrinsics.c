@@ -19,6 +19,18 @@
 #  include <unistd.h>
 #endif
 
+#if !defined(_WIN32) && !defined(COMPILE_TO_WASM)
+#  include <pthread.h>
+// Asynchronous data transfers are done by a worker thread
+#  define LFORTRAN_ASYNC_IO_THREAD
+#endif
+
+#if defined(_MSC_VER)
+#  define LFORTRAN_THREAD_LOCAL __declspec(thread)
+#else
+#  define LFORTRAN_THREAD_LOCAL __thread
+#endif
+
 #include <libasr/runtime/lfortran_intrinsics.h>
 #include <libasr/config.h>
 
@@ -106,58 +118,522 @@ LFORTRAN_API double _lfortran_sum(int n, double *v)
     return r;
 }
 
-LFORTRAN_API void _lfortran_random_number(int n, double *v)
+// >> Array reductions >> -----------------------------------------------------
+
+// Kernels for SUM, PRODUCT, MAXVAL, MINVAL and NORM2 of contiguous real
+// arrays. A plain reduction loop is a serial dependence chain that the
+// compiler may not vectorize without reassociating; the kernels keep
+// LFORTRAN_REDUCTION_LANES independent accumulators instead, which the
+// C compiler maps to SIMD registers. SUM and NORM2 additionally add
+// blocks pairwise, which bounds the rounding error by O(log n) instead of
+// O(n); the `_fast` variants (used with --fast) skip the pairwise tree.
+
+#define LFORTRAN_REDUCTION_LANES 8
+#define LFORTRAN_PAIRWISE_BLOCK 128
+
+// Defines `sum_<name>(n, v, scale, squares, fast)`, which sums the elements
+// of `v` (or the squares of the elements times `scale`) in the type `A`
+#define LFORTRAN_DEFINE_SUM_KERNELS(name, T, A)                                \
+static A sum_block_##name(int64_t n, const T *v, A scale, bool squares)       \
+{                                                                              \
+    A acc[LFORTRAN_REDUCTION_LANES] = {0};                                     \
+    int64_t i = 0;                                                             \
+    if (squares) {                                                             \
+        for (; i + LFORTRAN_REDUCTION_LANES <= n;                              \
+                i += LFORTRAN_REDUCTION_LANES) {                               \
+            for (int j = 0; j < LFORTRAN_REDUCTION_LANES; j++) {               \
+                A x = (A)v[i + j] * scale;                                     \
+                acc[j] += x * x;                                               \
+            }                                                                  \
+        }                                                                      \
+    } else {                                                                   \
+        for (; i + LFORTRAN_REDUCTION_LANES <= n;                              \
+                i += LFORTRAN_REDUCTION_LANES) {                               \
+            for (int j = 0; j < LFORTRAN_REDUCTION_LANES; j++) {               \
+                acc[j] += v[i + j];                                            \
+            }                                                                  \
+        }                                                                      \
+    }                                                                          \
+    A r = ((acc[0] + acc[1]) + (acc[2] + acc[3])) +                            \
+        ((acc[4] + acc[5]) + (acc[6] + acc[7]));                               \
+    for (; i < n; i++) {                                                       \
+        A x = squares ? (A)v[i] * scale : (A)v[i];                             \
+        r += squares ? x * x : x;                                              \
+    }                                                                          \
+    return r;                                                                  \
+}                                                                              \
+                                                                               \
+static A sum_pairwise_##name(int64_t n, const T *v, A scale, bool squares)    \
+{                                                                              \
+    if (n <= LFORTRAN_PAIRWISE_BLOCK) {                                        \
+        return sum_block_##name(n, v, scale, squares);                         \
+    }                                                                          \
+    int64_t half = n / 2;                                                      \
+    half -= half % LFORTRAN_REDUCTION_LANES;                                   \
+    return sum_pairwise_##name(half, v, scale, squares)                        \
+        + sum_pairwise_##name(n - half, v + half, scale, squares);             \
+}                                                                              \
+                                                                               \
+static A sum_##name(int64_t n, const T *v, A scale, bool squares, bool fast)  \
+{                                                                              \
+    return fast ? sum_block_##name(n, v, scale, squares)                       \
+        : sum_pairwise_##name(n, v, scale, squares);                           \
+}
+
+// Defines PRODUCT, MAXVAL and MINVAL. Like gfortran, MAXVAL and MINVAL skip
+// NaNs unless all elements are NaN, and return -huge(v) and huge(v) for an
+// empty array.
+#define LFORTRAN_DEFINE_REDUCTION_KERNELS(suffix, T, HUGE)                     \
+LFORTRAN_API T _lfortran_product_##suffix(int64_t n, T *v)                     \
+{                                                                              \
+    T acc[LFORTRAN_REDUCTION_LANES] = {1, 1, 1, 1, 1, 1, 1, 1};                \
+    int64_t i = 0;                                                             \
+    for (; i + LFORTRAN_REDUCTION_LANES <= n; i += LFORTRAN_REDUCTION_LANES) { \
+        for (int j = 0; j < LFORTRAN_REDUCTION_LANES; j++) {                   \
+            acc[j] *= v[i + j];                                                \
+        }                                                                      \
+    }                                                                          \
+    T r = ((acc[0] * acc[1]) * (acc[2] * acc[3])) *                            \
+        ((acc[4] * acc[5]) * (acc[6] * acc[7]));                               \
+    for (; i < n; i++) {                                                       \
+        r *= v[i];                                                             \
+    }                                                                          \
+    return r;                                                                  \
+}                                                                              \
+                                                                               \
+static T extremum_##suffix(int64_t n, const T *v, bool max)                   \
+{                                                                              \
+    if (n == 0) {                                                              \
+        return max ? -HUGE : HUGE;                                             \
+    }                                                                          \
+    T init = max ? -INFINITY : INFINITY;                                       \
+    T acc[LFORTRAN_REDUCTION_LANES];                                           \
+    for (int j = 0; j < LFORTRAN_REDUCTION_LANES; j++) {                       \
+        acc[j] = init;                                                         \
+    }                                                                          \
+    int64_t i = 0;                                                             \
+    if (max) {                                                                 \
+        for (; i + LFORTRAN_REDUCTION_LANES <= n;                              \
+                i += LFORTRAN_REDUCTION_LANES) {                               \
+            for (int j = 0; j < LFORTRAN_REDUCTION_LANES; j++) {               \
+                acc[j] = v[i + j] > acc[j] ? v[i + j] : acc[j];                \
+            }                                                                  \
+        }                                                                      \
+    } else {                                                                   \
+        for (; i + LFORTRAN_REDUCTION_LANES <= n;                              \
+                i += LFORTRAN_REDUCTION_LANES) {                               \
+            for (int j = 0; j < LFORTRAN_REDUCTION_LANES; j++) {               \
+                acc[j] = v[i + j] < acc[j] ? v[i + j] : acc[j];                \
+            }                                                                  \
+        }                                                                      \
+    }                                                                          \
+    T r = init;                                                                \
+    for (int j = 0; j < LFORTRAN_REDUCTION_LANES; j++) {                       \
+        r = (max ? acc[j] > r : acc[j] < r) ? acc[j] : r;                      \
+    }                                                                          \
+    for (; i < n; i++) {                                                       \
+        r = (max ? v[i] > r : v[i] < r) ? v[i] : r;                            \
+    }                                                                          \
+    if (r == init) {                                                           \
+        for (i = 0; i < n; i++) {                                              \
+            if (!isnan(v[i])) return r;                                        \
+        }                                                                      \
+        return NAN;                                                            \
+    }                                                                          \
+    return r;                                                                  \
+}                                                                              \
+                                                                               \
+LFORTRAN_API T _lfortran_maxval_##suffix(int64_t n, T *v)                      \
+{                                                                              \
+    return extremum_##suffix(n, v, true);                                      \
+}                                                                              \
+                                                                               \
+LFORTRAN_API T _lfortran_minval_##suffix(int64_t n, T *v)                      \
+{                                                                              \
+    return extremum_##suffix(n, v, false);                                     \
+}
+
+LFORTRAN_DEFINE_SUM_KERNELS(r4, float, float)
+LFORTRAN_DEFINE_SUM_KERNELS(r8, double, double)
+// The squares of single precision elements are summed in double precision,
+// where they can neither overflow nor underflow
+LFORTRAN_DEFINE_SUM_KERNELS(r4_r8, float, double)
+LFORTRAN_DEFINE_REDUCTION_KERNELS(r4, float, FLT_MAX)
+LFORTRAN_DEFINE_REDUCTION_KERNELS(r8, double, DBL_MAX)
+
+LFORTRAN_API float _lfortran_sum_r4(int64_t n, float *v)
+{
+    return sum_r4(n, v, 1, false, false);
+}
+
+LFORTRAN_API double _lfortran_sum_r8(int64_t n, double *v)
+{
+    return sum_r8(n, v, 1, false, false);
+}
+
+LFORTRAN_API float _lfortran_sum_fast_r4(int64_t n, float *v)
+{
+    return sum_r4(n, v, 1, false, true);
+}
+
+LFORTRAN_API double _lfortran_sum_fast_r8(int64_t n, double *v)
+{
+    return sum_r8(n, v, 1, false, true);
+}
+
+LFORTRAN_API float _lfortran_norm2_r4(int64_t n, float *v)
+{
+    return sqrt(sum_r4_r8(n, v, 1, true, false));
+}
+
+LFORTRAN_API float _lfortran_norm2_fast_r4(int64_t n, float *v)
+{
+    return sqrt(sum_r4_r8(n, v, 1, true, true));
+}
+
+// The squares are summed unscaled first. Only if that overflows, or is so
+// small that some squares may have underflowed, the sum is redone with the
+// elements scaled by the power of two (an exact operation) that brings the
+// largest magnitude close to 1.
+static double norm2_r8(int64_t n, const double *v, bool fast)
+{
+    double s = sum_r8(n, v, 1, true, fast);
+    if (isnan(s) || (isfinite(s) && s >= 0x1p-900)) {
+        return sqrt(s);
+    }
+    double amax = 0;
+    for (int64_t i = 0; i < n; i++) {
+        double x = fabs(v[i]);
+        amax = x > amax ? x : amax;
+    }
+    if (amax == 0 || isinf(amax)) {
+        return amax;
+    }
+    int e = ilogb(amax);
+    s = sum_r8(n, v, ldexp(1, -e), true, fast);
+    return ldexp(sqrt(s), e);
+}
+
+LFORTRAN_API double _lfortran_norm2_r8(int64_t n, double *v)
+{
+    return norm2_r8(n, v, false);
+}
+
+LFORTRAN_API double _lfortran_norm2_fast_r8(int64_t n, double *v)
+{
+    return norm2_r8(n, v, true);
+}
+
+// << Array reductions << -----------------------------------------------------
+
+// >> Random numbers >> -------------------------------------------------------
+
+// RANDOM_NUMBER uses xoshiro256++ (Blackman and Vigna). Every thread draws
+// from its own stream: stream k starts 2^128 * k steps after the seed (see
+// `rng_jump`), so streams never overlap and no lock is taken per number.
+// RANDOM_SEED(PUT=) and the seeding functions below reset the streams; the
+// calling thread continues with stream 0, other threads pick up a new
+// stream on their next draw. Seeding while other threads draw is a race.
+
+#if defined(_MSC_VER)
+#  define rng_atomic_fetch_add(p) ((uint32_t)InterlockedIncrement((volatile long *)(p)) - 1)
+#  define rng_atomic_load(p) (*(volatile uint32_t *)(p))
+#else
+#  define rng_atomic_fetch_add(p) __atomic_fetch_add((p), 1, __ATOMIC_RELAXED)
+#  define rng_atomic_load(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#endif
+
+// Number of default integers in the seed of RANDOM_SEED
+#define LFORTRAN_RANDOM_SEED_SIZE 8
+
+static uint64_t rng_seed[4] = {
+    0x9e3779b97f4a7c15ULL, 0xbf58476d1ce4e5b9ULL,
+    0x94d049bb133111ebULL, 0x2545f4914f6cdd1dULL
+};
+// Incremented by every reseed, so that threads notice their stream is stale
+static uint32_t rng_generation = 1;
+// Next stream to hand out in the current generation
+static uint32_t rng_next_stream = 1;
+
+struct rng_state {
+    uint64_t s[4];
+    uint32_t generation;
+};
+
+static LFORTRAN_THREAD_LOCAL struct rng_state rng;
+
+static inline uint64_t rng_rotl(uint64_t x, int k)
+{
+    return (x << k) | (x >> (64 - k));
+}
+
+static inline uint64_t rng_next(uint64_t *s)
+{
+    uint64_t result = rng_rotl(s[0] + s[3], 23) + s[0];
+    uint64_t t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rng_rotl(s[3], 45);
+    return result;
+}
+
+// Advances `s` by 2^128 steps
+static void rng_jump(uint64_t *s)
+{
+    static const uint64_t jump[4] = {
+        0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL,
+        0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL
+    };
+    uint64_t t[4] = {0, 0, 0, 0};
+    int i, b;
+    for (i = 0; i < 4; i++) {
+        for (b = 0; b < 64; b++) {
+            if (jump[i] & ((uint64_t)1 << b)) {
+                t[0] ^= s[0];
+                t[1] ^= s[1];
+                t[2] ^= s[2];
+                t[3] ^= s[3];
+            }
+            rng_next(s);
+        }
+    }
+    memcpy(s, t, sizeof(t));
+}
+
+static uint64_t rng_splitmix64(uint64_t *x)
+{
+    uint64_t z = (*x += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+// Makes `s` the seed of all streams and the state of the calling thread
+static void rng_reseed(const uint64_t *s)
 {
     int i;
-    for (i=0; i < n; i++) {
-        v[i] = rand() / (double) RAND_MAX;
+    if ((s[0] | s[1] | s[2] | s[3]) == 0) {
+        // The all zero state is a fixed point of xoshiro
+        uint64_t x = 0;
+        for (i = 0; i < 4; i++) rng_seed[i] = rng_splitmix64(&x);
+    } else {
+        memcpy(rng_seed, s, sizeof(rng_seed));
+    }
+    rng_next_stream = 1;
+    rng.generation = rng_atomic_fetch_add(&rng_generation) + 1;
+    memcpy(rng.s, rng_seed, sizeof(rng.s));
+}
+
+static void rng_seed_from(uint64_t x)
+{
+    uint64_t s[4];
+    int i;
+    for (i = 0; i < 4; i++) s[i] = rng_splitmix64(&x);
+    rng_reseed(s);
+}
+
+// Returns the state of the calling thread, starting a new stream if the
+// thread has not drawn since the last reseed
+static inline uint64_t *rng_state(void)
+{
+    uint32_t generation = rng_atomic_load(&rng_generation);
+    if (rng.generation != generation) {
+        uint32_t stream = rng_atomic_fetch_add(&rng_next_stream);
+        memcpy(rng.s, rng_seed, sizeof(rng.s));
+        while (stream-- > 0) rng_jump(rng.s);
+        rng.generation = generation;
+    }
+    return rng.s;
+}
+
+// Uniform numbers in [0, 1) from the upper bits of the generator output
+static inline double rng_to_double(uint64_t x)
+{
+    return (x >> 11) * (1.0 / 9007199254740992.0);
+}
+
+static inline float rng_to_float(uint64_t x)
+{
+    return (x >> 40) * (1.0f / 16777216.0f);
+}
+
+LFORTRAN_API void _lfortran_random_number_r4(int64_t n, float *v)
+{
+    uint64_t s[4];
+    uint64_t *state = rng_state();
+    int64_t i;
+    // Keep the state in registers for the loop
+    memcpy(s, state, sizeof(s));
+    for (i = 0; i < n; i++) {
+        v[i] = rng_to_float(rng_next(s));
+    }
+    memcpy(state, s, sizeof(s));
+}
+
+LFORTRAN_API void _lfortran_random_number_r8(int64_t n, double *v)
+{
+    uint64_t s[4];
+    uint64_t *state = rng_state();
+    int64_t i;
+    memcpy(s, state, sizeof(s));
+    for (i = 0; i < n; i++) {
+        v[i] = rng_to_double(rng_next(s));
+    }
+    memcpy(state, s, sizeof(s));
+}
+
+LFORTRAN_API float _lfortran_sp_rand_num()
+{
+    return rng_to_float(rng_next(rng_state()));
+}
+
+LFORTRAN_API double _lfortran_dp_rand_num()
+{
+    return rng_to_double(rng_next(rng_state()));
+}
+
+LFORTRAN_API int32_t _lfortran_random_seed_size()
+{
+    return LFORTRAN_RANDOM_SEED_SIZE;
+}
+
+// The seed is the xoshiro state, split into 32 bit halves
+LFORTRAN_API void _lfortran_random_seed_put(int32_t *put)
+{
+    uint64_t s[4];
+    int i;
+    for (i = 0; i < 4; i++) {
+        s[i] = (uint64_t)(uint32_t)put[2*i]
+            | ((uint64_t)(uint32_t)put[2*i + 1] << 32);
+    }
+    rng_reseed(s);
+}
+
+LFORTRAN_API void _lfortran_random_seed_get(int32_t *get)
+{
+    uint64_t *s = rng_state();
+    int i;
+    for (i = 0; i < 4; i++) {
+        get[2*i] = (int32_t)(uint32_t)s[i];
+        get[2*i + 1] = (int32_t)(uint32_t)(s[i] >> 32);
     }
 }
 
+LFORTRAN_API void _lfortran_random_number(int n, double *v)
+{
+    _lfortran_random_number_r8(n, v);
+}
+
 LFORTRAN_API void _lfortran_init_random_seed(unsigned seed)
 {
-    srand(seed);
+    rng_seed_from(seed);
 }
 
 LFORTRAN_API void _lfortran_init_random_clock()
 {
-    unsigned int count;
+    uint64_t count;
 #if defined(_WIN32)
-    count = (unsigned int)clock();
+    count = (uint64_t)clock() ^ ((uint64_t)time(NULL) << 32);
 #else
     struct timespec ts;
-    if (clock_gettime(CLOCK_MONOTONIC, &ts) == 0) {
-        count = (unsigned int)(ts.tv_nsec);
+    if (clock_gettime(CLOCK_REALTIME, &ts) == 0) {
+        count = (uint64_t)ts.tv_nsec ^ ((uint64_t)ts.tv_sec << 32);
     } else {
-        count = (unsigned int)clock();
+        count = (uint64_t)clock();
     }
 #endif
-    srand(count);
+    rng_seed_from(count);
 }
 
 LFORTRAN_API double _lfortran_random()
 {
-    return (rand() / (double) RAND_MAX);
+    return _lfortran_dp_rand_num();
+}
+
+// Uniform integer in [0, range) without modulo bias (Lemire's method)
+static uint64_t rng_bounded(uint64_t range)
+{
+    uint64_t *s = rng_state();
+    uint64_t x = rng_next(s) >> 32;
+    if (range == 0 || range > UINT32_MAX) {
+        return range == 0 ? 0 : x;
+    }
+    uint64_t m = x * range;
+    uint32_t low = (uint32_t)m;
+    if (low < range) {
+        uint32_t threshold = (uint32_t)(-(uint32_t)range) % (uint32_t)range;
+        while (low < threshold) {
+            x = rng_next(s) >> 32;
+            m = x * range;
+            low = (uint32_t)m;
+        }
+    }
+    return m >> 32;
 }
 
 LFORTRAN_API int _lfortran_randrange(int lower, int upper)
 {
-    int rr = lower + (rand() % (upper - lower));
-    return rr;
+    return lower + (int)rng_bounded((uint64_t)((int64_t)upper - lower));
 }
 
 LFORTRAN_API int _lfortran_random_int(int lower, int upper)
 {
-    int randint = lower + (rand() % (upper - lower + 1));
-    return randint;
+    return lower + (int)rng_bounded((uint64_t)((int64_t)upper - lower + 1));
+}
+
+// << Random numbers << -------------------------------------------------------
+
+// >> Output buffering >> -----------------------------------------------------
+
+// Size of the stdio buffer given to stdout and to every unit opened with
+// OPEN. The C library default (BUFSIZ or st_blksize, typically 4-8 KiB)
+// means a write(2) every few records for output heavy programs.
+#define LFORTRAN_IO_BUFFER_SIZE (1 << 16)
+
+// When set (LFORTRAN_UNBUFFERED_IO=1 in the environment) every PRINT and
+// WRITE is flushed immediately, which was the behaviour of earlier versions.
+static bool _lfortran_unbuffered_io = false;
+
+static char _lfortran_stdout_buffer[LFORTRAN_IO_BUFFER_SIZE];
+
+static void _lfortran_init_io() {
+    const char *env = getenv("LFORTRAN_UNBUFFERED_IO");
+    if (env != NULL && strcmp(env, "") != 0 && strcmp(env, "0") != 0) {
+        _lfortran_unbuffered_io = true;
+        return;
+    }
+    // Output to a terminal is flushed at the end of each record (line), so
+    // interactive programs behave as before; output to a file or a pipe is
+    // fully buffered and flushed when the buffer fills, on FLUSH, before
+    // reading from stdin, before writing to stderr and at program exit.
+#if defined(_WIN32)
+    bool is_tty = _isatty(_fileno(stdout));
+#else
+    bool is_tty = isatty(fileno(stdout));
+#endif
+    setvbuf(stdout, _lfortran_stdout_buffer, is_tty ? _IOLBF : _IOFBF,
+        LFORTRAN_IO_BUFFER_SIZE);
+}
+
+// Called before every read from stdin, so that a prompt written without a
+// trailing newline is visible before the program blocks on input.
+static inline void _lfortran_flush_before_read() {
+    fflush(stdout);
 }
 
+// << Output buffering << -----------------------------------------------------
+
 LFORTRAN_API void _lfortran_printf(const char* format, ...)
 {
     va_list args;
     va_start(args, format);
     vfprintf(stdout, format, args);
-    fflush(stdout);
+    if (_lfortran_unbuffered_io) {
+        fflush(stdout);
+    }
     va_end(args);
 }
 
@@ -169,28 +645,73 @@ char* substring(const char* str, int start, int end) {
     return substr;
 }
 
-char* append_to_string(char* str, const char* append) {
-    int len1 = strlen(str);
-    int len2 = strlen(append);
-    str = (char*)realloc(str, (len1 + len2 + 1) * sizeof(char));
-    strcat(str, append);
-    return str;
+/*
+Growable buffer the formatted output is built in. Appending is amortised
+O(1), so formatting a whole array into one buffer stays linear in its size.
+*/
+struct string_builder {
+    char* s;
+    int64_t len;
+    int64_t cap;
+};
+
+static void sb_init(struct string_builder* sb) {
+    sb->cap = 64;
+    sb->len = 0;
+    sb->s = (char*)malloc(sb->cap * sizeof(char));
+    sb->s[0] = '\0';
 }
 
-void handle_integer(char* format, int64_t val, char** result) {
-    int width = 0, min_width = 0;
-    char* dot_pos = strchr(format, '.');
+static void sb_reserve(struct string_builder* sb, int64_t n) {
+    if (sb->len + n + 1 > sb->cap) {
+        while (sb->len + n + 1 > sb->cap) sb->cap *= 2;
+        sb->s = (char*)realloc(sb->s, sb->cap * sizeof(char));
+    }
+}
+
+static void sb_append_n(struct string_builder* sb, const char* str, int64_t n) {
+    sb_reserve(sb, n);
+    memcpy(sb->s + sb->len, str, n);
+    sb->len += n;
+    sb->s[sb->len] = '\0';
+}
+
+static void sb_append(struct string_builder* sb, const char* str) {
+    sb_append_n(sb, str, strlen(str));
+}
+
+static void sb_append_char(struct string_builder* sb, char c, int64_t n) {
+    if (n <= 0) return;
+    sb_reserve(sb, n);
+    memset(sb->s + sb->len, c, n);
+    sb->len += n;
+    sb->s[sb->len] = '\0';
+}
+
+static void sb_truncate(struct string_builder* sb, int64_t len) {
+    if (len < sb->len) {
+        sb->len = len;
+        sb->s[len] = '\0';
+    }
+}
+
+/*
+The `format_*` functions below implement the data edit descriptors, given
+their already parsed width and digits. The `handle_*` functions parse the
+text of a descriptor (e.g. "i5.3") for `_lcompilers_string_format_fortran`,
+while the compiled formats of `_lcompilers_string_format_fortran_compiled`
+call the `format_*` functions directly.
+*/
+static void format_integer(int width, int min_width, bool has_min_width,
+        int64_t val, struct string_builder* result) {
     int len = (val == 0) ? 1 : (int)log10(llabs(val)) + 1;
     int sign_width = (val < 0) ? 1 : 0;
-    if (dot_pos != NULL) {
-        dot_pos++;
-        width = atoi(format + 1);
-        min_width = atoi(dot_pos);
+    if (has_min_width) {
         if (min_width > width && width != 0) {
             perror("Minimum number of digits cannot be more than the specified width for format.\n");
         }
     } else {
-        width = atoi(format + 1);
+        min_width = 0;
         if (width == 0) {
             width = len + sign_width;
         }
@@ -198,66 +719,70 @@ void handle_integer(char* format, int64_t val, char** result) {
     if (width >= len + sign_width || width == 0) {
         if (min_width > len) {
             for (int i = 0; i < (width - min_width - sign_width); i++) {
-                *result = append_to_string(*result, " ");
+                sb_append(result, " ");
             }
             if (val < 0) {
-                *result = append_to_string(*result, "-");
+                sb_append(result, "-");
             }
             for (int i = 0; i < (min_width - len); i++) {
-                *result = append_to_string(*result, "0");
+                sb_append(result, "0");
             }
         } else if (width == 0) {
             if (val < 0) {
-                *result = append_to_string(*result, "-");
+                sb_append(result, "-");
             }
             for (int i = 0; i < (min_width - len - sign_width); i++) {
-                *result = append_to_string(*result, "0");
+                sb_append(result, "0");
             }
         } else {
             for (int i = 0; i < (width - len - sign_width); i++) {
-                *result = append_to_string(*result, " ");
+                sb_append(result, " ");
             }
             if (val < 0) {
-                *result = append_to_string(*result, "-");
+                sb_append(result, "-");
             }
         }
         char str[20];
         sprintf(str, "%lld", llabs(val));
-        *result = append_to_string(*result, str);
+        sb_append(result, str);
     } else {
         for (int i = 0; i < width; i++) {
-            *result = append_to_string(*result, "*");
+            sb_append(result, "*");
         }
     }
 }
 
-void handle_logical(char* format, bool val, char** result) {
-    int width = atoi(format + 1);
+void handle_integer(char* format, int64_t val, struct string_builder* result) {
+    char* dot_pos = strchr(format, '.');
+    format_integer(atoi(format + 1), dot_pos ? atoi(dot_pos + 1) : 0,
+        dot_pos != NULL, val, result);
+}
+
+static void format_logical(int width, bool val, struct string_builder* result) {
     for (int i = 0; i < width - 1; i++) {
-        *result = append_to_string(*result, " ");
+        sb_append(result, " ");
     }
     if (val) {
-        *result = append_to_string(*result, "T");
+        sb_append(result, "T");
     } else {
-        *result = append_to_string(*result, "F");
+        sb_append(result, "F");
     }
 }
 
-void handle_float(char* format, double val, char** result) {
-    int width = 0, decimal_digits = 0;
+void handle_logical(char* format, bool val, struct string_builder* result) {
+    format_logical(atoi(format + 1), val, result);
+}
+
+static void format_float(int width, int decimal_digits, double val,
+        struct string_builder* result) {
+    // F0.d: no leading zero for values less than one
+    bool zero_width = width == 0;
     long integer_part = (long)fabs(val);
     double decimal_part = fabs(val) - integer_part;
 
     int sign_width = (val < 0) ? 1 : 0;
     int integer_length = (integer_part == 0) ? 1 : (int)log10(integer_part) + 1;
 
-    // parsing the format
-    char* dot_pos = strchr(format, '.');
-    if (dot_pos != NULL) {
-        decimal_digits = atoi(dot_pos + 1);
-        width = atoi(format + 1);
-    }
-
     double rounding_factor = pow(10, -decimal_digits);
     decimal_part = round(decimal_part / rounding_factor) * rounding_factor;
 
@@ -290,7 +815,7 @@ void handle_float(char* format, double val, char** result) {
     if (val < 0) {
         strcat(formatted_value, "-");
     }
-    if (integer_part == 0 && format[1] == '0') {
+    if (integer_part == 0 && zero_width) {
         strcat(formatted_value, "");
     } else {
         strcat(formatted_value, int_str);
@@ -301,27 +826,29 @@ void handle_float(char* format, double val, char** result) {
     // checking for overflow
     if (strlen(formatted_value) > width) {
         for (int i = 0; i < width; i++) {
-            *result = append_to_string(*result, "*");
+            sb_append(result, "*");
         }
     } else {
-        *result = append_to_string(*result, formatted_value);
+        sb_append(result, formatted_value);
     }
 }
 
-/*
-`handle_en` - Formats a floating-point number using a Fortran-style "EN" format.
+void handle_float(char* format, double val, struct string_builder* result) {
+    int width = 0, decimal_digits = 0;
+    char* dot_pos = strchr(format, '.');
+    if (dot_pos != NULL) {
+        decimal_digits = atoi(dot_pos + 1);
+        width = atoi(format + 1);
+    }
+    format_float(width, decimal_digits, val, result);
+}
 
-NOTE: The function allocates memory for the formatted result, which is returned via
-the `result` parameter. It is the responsibility of the caller to free this memory
-using `free(*result)` after it is no longer needed.
+/*
+`format_en` - Formats a floating-point number using a Fortran-style "EN" format
+and appends it to `result`.
 */
-void handle_en(char* format, double val, int scale, char** result, char* c) {
-    int width, decimal_digits;
-    char *num_pos = format, *dot_pos = strchr(format, '.');
-    decimal_digits = atoi(++dot_pos);
-    while (!isdigit(*num_pos)) num_pos++;
-    width = atoi(num_pos);
-
+static void format_en(int width, int decimal_digits, double val,
+        struct string_builder* result, const char* c) {
     // Calculate exponent
     int exponent = 0;
     if (val != 0.0) {
@@ -355,36 +882,37 @@ void handle_en(char* format, double val, int scale, char** result, char* c) {
     }
 
     // Handle width and padding
-    char* final_result = malloc(width + 1);
     int padding = width - strlen(formatted_value);
     if (padding > 0) {
-        memset(final_result, ' ', padding);
-        strcpy(final_result + padding, formatted_value);
+        sb_append_char(result, ' ', padding);
+        sb_append(result, formatted_value);
     } else {
-        strncpy(final_result, formatted_value, width);
-        final_result[width] = '\0';
+        sb_append_n(result, formatted_value, width);
     }
+}
 
-    // Assign the result to the output parameter
-    *result = final_result;
+void handle_en(char* format, double val, int scale, struct string_builder* result, char* c) {
+    char *num_pos = format, *dot_pos = strchr(format, '.');
+    int decimal_digits = atoi(++dot_pos);
+    while (!isdigit(*num_pos)) num_pos++;
+    format_en(atoi(num_pos), decimal_digits, val, result, c);
 }
 
-void handle_decimal(char* format, double val, int scale, char** result, char* c) {
+/*
+`format_decimal` - D, E and ES editing. `exp` is the number of exponent
+digits (2 when not given) and `scale` the current scale factor (nP).
+*/
+static void format_decimal(int width, int decimal_digits, int exp, bool is_es,
+        double val, int scale, struct string_builder* result, const char* c) {
     // Consider an example: write(*, "(es10.2)") 1.123e+10
-    // format = "es10.2", val = 11230000128.00, scale = 0, c = "E"
-    int width = 0, decimal_digits = 0;
+    // width = 10, decimal_digits = 2, val = 11230000128.00, scale = 0, c = "E"
+    int given_width = width;
     int sign_width = (val < 0) ? 1 : 0;
     // sign_width = 0
     double integer_part = trunc(val);
     int integer_length = (integer_part == 0) ? 1 : (int)log10(fabs(integer_part)) + 1;
     // integer_part = 11230000128, integer_length = 11
 
-    char *num_pos = format ,*dot_pos = strchr(format, '.');
-    decimal_digits = atoi(++dot_pos);
-    while(!isdigit(*num_pos)) num_pos++;
-    width = atoi(num_pos);
-    // width = 10, decimal_digits = 2
-
     char val_str[128];
     // TODO: This will work for up to `E65.60` but will fail for:
     // print "(E67.62)", 1.23456789101112e-62_8
@@ -398,11 +926,6 @@ void handle_decimal(char* format, double val, int scale, char** result, char* c)
     }
     // val_str = "11230000128."
 
-    int exp = 2;
-    char* exp_loc = strchr(num_pos, 'e');
-    if (exp_loc != NULL) {
-        exp = atoi(++exp_loc);
-    }
     // exp = 2;
 
     char* ptr = strchr(val_str, '.');
@@ -423,27 +946,23 @@ void handle_decimal(char* format, double val, int scale, char** result, char* c)
         decimal--;
         // loop end: decimal = -9
     }
-    if (tolower(format[1]) == 's') {
+    if (is_es) {
         scale = 1;
         decimal--;
         // decimal = 0,   case:  1.123e+10
         // decimal = -10, case:  1.123e-10
     }
 
-    if (dot_pos != NULL) {
-        if (width == 0) {
-            if (decimal_digits == 0) {
-                width = 14 + sign_width;
-                decimal_digits = 9;
-            } else {
-                width = decimal_digits + 5 + sign_width;
-            }
-        }
-        if (decimal_digits > width - 3) {
-            perror("Specified width is not enough for the specified number of decimal digits.\n");
+    if (width == 0) {
+        if (decimal_digits == 0) {
+            width = 14 + sign_width;
+            decimal_digits = 9;
+        } else {
+            width = decimal_digits + 5 + sign_width;
         }
-    } else {
-        width = atoi(format + 1);
+    }
+    if (decimal_digits > width - 3) {
+        perror("Specified width is not enough for the specified number of decimal digits.\n");
     }
     if (decimal_digits > strlen(val_str)) {
         int k = decimal_digits - (strlen(val_str) - integer_length);
@@ -483,11 +1002,11 @@ void handle_decimal(char* format, double val, int scale, char** result, char* c)
         }
         strncat(formatted_value, val_str, decimal_digits + scale - zeros);
     } else {
-        char* temp = substring(val_str, 0, scale);
-        strcat(formatted_value, temp);
+        strncat(formatted_value, val_str, scale);
         strcat(formatted_value, ".");
         // formatted_value = "  1."
-        char* new_str = substring(val_str, scale, strlen(val_str));
+        char new_str[128];
+        strcpy(new_str, val_str + scale);
         // new_str = "1230000128" case:  1.123e+10
         int zeros = 0;
         if (decimal_digits < strlen(new_str) && decimal_digits + scale <= 15) {
@@ -505,15 +1024,13 @@ void handle_decimal(char* format, double val, int scale, char** result, char* c)
         new_str[decimal_digits] = '\0';
         strcat(formatted_value, new_str);
         // formatted_value = "  1.12"
-        free(new_str);
-        free(temp);
     }
 
     strcat(formatted_value, c);
     // formatted_value = "  1.12E"
 
     char exponent[12];
-    if (atoi(num_pos) == 0) {
+    if (given_width == 0) {
         sprintf(exponent, "%+02d", (integer_length > 0 && integer_part != 0 ? integer_length - scale : decimal));
     } else {
         sprintf(exponent, "%+0*d", exp+1, (integer_length > 0 && integer_part != 0 ? integer_length - scale : decimal));
@@ -532,14 +1049,27 @@ void handle_decimal(char* format, double val, int scale, char** result, char* c)
 
     if (strlen(formatted_value) > width) {
         for(int i=0; i<width; i++){
-            *result = append_to_string(*result,"*");
+            sb_append(result, "*");
         }
     } else {
-        *result = append_to_string(*result, formatted_value);
+        sb_append(result, formatted_value);
         // result = "  1.12E+10"
     }
 }
 
+void handle_decimal(char* format, double val, int scale, struct string_builder* result, char* c) {
+    char *num_pos = format ,*dot_pos = strchr(format, '.');
+    int decimal_digits = atoi(++dot_pos);
+    while(!isdigit(*num_pos)) num_pos++;
+    int exp = 2;
+    char* exp_loc = strchr(num_pos, 'e');
+    if (exp_loc != NULL) {
+        exp = atoi(++exp_loc);
+    }
+    format_decimal(atoi(num_pos), decimal_digits, exp, tolower(format[1]) == 's',
+        val, scale, result, c);
+}
+
 /*
 Ignore blank space characters within format specification, except
 within character string edit descriptor
@@ -744,66 +1274,267 @@ char** parse_fortran_format(char* format, int *count, int *item_start) {
     return format_values_2;
 }
 
-LFORTRAN_API char* _lcompilers_string_format_fortran(int count, const char* format, ...)
-{
-    va_list args;
-    va_start(args, format);
-    char* cleaned_format = remove_spaces_except_quotes(format);
-    if (!cleaned_format) {
-        va_end(args);
-        return NULL;
-    }
-    int len = strlen(cleaned_format);
-    char* modified_input_string = (char*)malloc((len+1) * sizeof(char));
-    strncpy(modified_input_string, cleaned_format, len);
-    modified_input_string[len] = '\0';
-    if (cleaned_format[0] == '(' && cleaned_format[len-1] == ')') {
-        memmove(modified_input_string, modified_input_string + 1, strlen(modified_input_string));
-        modified_input_string[len-2] = '\0';
-    }
-    int format_values_count = 0,item_start_idx=0;
-    char** format_values = parse_fortran_format(modified_input_string,&format_values_count,&item_start_idx);
-    char* result = (char*)malloc(sizeof(char));
-    result[0] = '\0';
-    int item_start = 0;
-    bool array = false;
-    while (1) {
-        int scale = 0;
-        for (int i = item_start; i < format_values_count; i++) {
-            if(format_values[i] == NULL) continue;
-            char* value = format_values[i];
+/*
+Source of the values consumed by the Fortran formatter: either the C
+variadic arguments of `_lcompilers_string_format_fortran`, whose types are
+implied by the edit descriptors, or the typed items (scalars and array
+descriptors) of `_lcompilers_string_format_fortran_array`.
+*/
+#define LFORTRAN_MAX_RANK 15
 
-            if (value[0] == '(' && value[strlen(value)-1] == ')') {
-                value[strlen(value)-1] = '\0';
-                int new_fmt_val_count = 0;
-                char** new_fmt_val = parse_fortran_format(++value,&new_fmt_val_count,&item_start_idx);
+struct format_value {
+    int32_t type;
+    int64_t i;
+    double r;
+    char* s;
+};
 
-                char** ptr = (char**)realloc(format_values, (format_values_count + new_fmt_val_count + 1) * sizeof(char*));
-                if (ptr == NULL) {
-                    perror("Memory allocation failed.\n");
-                    free(format_values);
-                } else {
-                    format_values = ptr;
-                }
-                for (int k = format_values_count - 1; k >= i+1; k--) {
-                    format_values[k + new_fmt_val_count] = format_values[k];
-                }
-                for (int k = 0; k < new_fmt_val_count; k++) {
-                    format_values[i + 1 + k] = new_fmt_val[k];
-                }
-                format_values_count = format_values_count + new_fmt_val_count;
-                free(format_values[i]);
-                format_values[i] = NULL;
-                free(new_fmt_val);
-                continue;
-            }
+struct format_args {
+    int64_t count; // Number of values not formatted yet
+    va_list* args;
+    bool typed;
+    // The typed item being formatted
+    int32_t type;
+    int32_t rank;
+    char* data;
+    int32_t offset;
+    struct _lfortran_dimension_descriptor* dims;
+    int32_t pos[LFORTRAN_MAX_RANK];
+    int64_t remaining; // Elements of the current item not formatted yet
+    struct format_value scalar;
+    bool has_imag; // The imaginary part of a complex element is pending
+    double imag;
+};
 
-            if (value[0] == '/') {
-                result = append_to_string(result, "\n");
-            } else if (value[0] == '*') {
-                array = true;
-            } else if (isdigit(value[0]) && tolower(value[1]) == 'p') {
-                // Scale Factor nP
+static int64_t format_item_element_size(int32_t type) {
+    switch (type) {
+        case _lfortran_format_int8: return 1;
+        case _lfortran_format_int16: return 2;
+        case _lfortran_format_int32: return 4;
+        case _lfortran_format_int64: return 8;
+        case _lfortran_format_real32: return 4;
+        case _lfortran_format_real64: return 8;
+        case _lfortran_format_complex32: return 8;
+        case _lfortran_format_complex64: return 16;
+        case _lfortran_format_logical: return 1;
+        default: {
+            printf("Runtime error: unsupported item type %d in formatted output\n", type);
+            exit(1);
+        }
+    }
+}
+
+// Reads the next item from the variadic arguments (see lfortran_intrinsics.h
+// for the layout) and returns the number of values it contributes.
+static int64_t format_args_read_item(struct format_args* fa) {
+    fa->type = va_arg(*fa->args, int32_t);
+    fa->rank = va_arg(*fa->args, int32_t);
+    if (fa->rank == 0) {
+        fa->scalar.type = fa->type;
+        switch (fa->type) {
+            case _lfortran_format_int64:
+                fa->scalar.i = va_arg(*fa->args, int64_t);
+                break;
+            case _lfortran_format_real64:
+                fa->scalar.r = va_arg(*fa->args, double);
+                break;
+            case _lfortran_format_complex64:
+                fa->scalar.r = va_arg(*fa->args, double);
+                fa->imag = va_arg(*fa->args, double);
+                break;
+            case _lfortran_format_logical:
+                fa->scalar.i = strcmp(va_arg(*fa->args, char*), "True") == 0;
+                break;
+            case _lfortran_format_character:
+                fa->scalar.s = va_arg(*fa->args, char*);
+                break;
+            default: {
+                printf("Runtime error: unsupported scalar type %d in formatted output\n", fa->type);
+                exit(1);
+            }
+        }
+        fa->remaining = 1;
+    } else {
+        if (fa->rank > LFORTRAN_MAX_RANK) {
+            printf("Runtime error: arrays of rank %d are not supported in formatted output\n", fa->rank);
+            exit(1);
+        }
+        fa->data = va_arg(*fa->args, char*);
+        fa->offset = va_arg(*fa->args, int32_t);
+        fa->dims = va_arg(*fa->args, struct _lfortran_dimension_descriptor*);
+        fa->remaining = 1;
+        for (int32_t k = 0; k < fa->rank; k++) {
+            fa->pos[k] = 0;
+            fa->remaining *= fa->dims[k].size > 0 ? fa->dims[k].size : 0;
+        }
+    }
+    bool is_complex = fa->type == _lfortran_format_complex32 ||
+        fa->type == _lfortran_format_complex64;
+    return is_complex ? 2 * fa->remaining : fa->remaining;
+}
+
+static void format_args_next(struct format_args* fa, struct format_value* v) {
+    if (fa->has_imag) {
+        fa->has_imag = false;
+        v->type = _lfortran_format_real64;
+        v->r = fa->imag;
+        return;
+    }
+    while (fa->remaining == 0) {
+        format_args_read_item(fa);
+    }
+    fa->remaining--;
+    if (fa->rank == 0) {
+        *v = fa->scalar;
+        if (fa->type == _lfortran_format_complex64) {
+            v->type = _lfortran_format_real64;
+            fa->has_imag = true;
+        }
+        return;
+    }
+    // Column major walk over the (possibly strided) array
+    int64_t idx = fa->offset;
+    for (int32_t k = 0; k < fa->rank; k++) {
+        idx += (int64_t)fa->pos[k] * fa->dims[k].stride;
+    }
+    for (int32_t k = 0; k < fa->rank; k++) {
+        if (++fa->pos[k] < fa->dims[k].size) break;
+        fa->pos[k] = 0;
+    }
+    char* p = fa->data + idx * format_item_element_size(fa->type);
+    v->type = fa->type;
+    switch (fa->type) {
+        case _lfortran_format_int8: v->i = *(int8_t*)p; break;
+        case _lfortran_format_int16: v->i = *(int16_t*)p; break;
+        case _lfortran_format_int32: v->i = *(int32_t*)p; break;
+        case _lfortran_format_int64: v->i = *(int64_t*)p; break;
+        case _lfortran_format_real32: v->r = *(float*)p; break;
+        case _lfortran_format_real64: v->r = *(double*)p; break;
+        case _lfortran_format_complex32: {
+            v->r = ((float*)p)[0];
+            fa->imag = ((float*)p)[1];
+            fa->has_imag = true;
+            break;
+        }
+        case _lfortran_format_complex64: {
+            v->r = ((double*)p)[0];
+            fa->imag = ((double*)p)[1];
+            fa->has_imag = true;
+            break;
+        }
+        case _lfortran_format_logical: v->i = *(bool*)p; break;
+    }
+    if (v->type >= _lfortran_format_real32 && v->type <= _lfortran_format_complex64) {
+        v->type = _lfortran_format_real64;
+    } else if (v->type != _lfortran_format_logical) {
+        v->type = _lfortran_format_int64;
+    }
+}
+
+static int64_t format_args_integer(struct format_args* fa) {
+    if (!fa->typed) {
+        return va_arg(*fa->args, int64_t);
+    }
+    struct format_value v;
+    format_args_next(fa, &v);
+    return v.type == _lfortran_format_real64 ? (int64_t)v.r : v.i;
+}
+
+static double format_args_real(struct format_args* fa) {
+    if (!fa->typed) {
+        return va_arg(*fa->args, double);
+    }
+    struct format_value v;
+    format_args_next(fa, &v);
+    return v.type == _lfortran_format_real64 ? v.r : (double)v.i;
+}
+
+static bool format_args_logical(struct format_args* fa) {
+    if (!fa->typed) {
+        char* val_str = va_arg(*fa->args, char*);
+        return strcmp(val_str, "True") == 0;
+    }
+    struct format_value v;
+    format_args_next(fa, &v);
+    return v.i != 0;
+}
+
+static char* format_args_string(struct format_args* fa) {
+    if (!fa->typed) {
+        return va_arg(*fa->args, char*);
+    }
+    struct format_value v;
+    format_args_next(fa, &v);
+    if (v.type == _lfortran_format_character) {
+        return v.s;
+    } else if (v.type == _lfortran_format_logical) {
+        return v.i ? "T" : "F";
+    }
+    return NULL;
+}
+
+static char* format_fortran(const char* format, struct format_args* fa)
+{
+    char* cleaned_format = remove_spaces_except_quotes(format);
+    if (!cleaned_format) {
+        return NULL;
+    }
+    int len = strlen(cleaned_format);
+    char* modified_input_string = (char*)malloc((len+1) * sizeof(char));
+    strncpy(modified_input_string, cleaned_format, len);
+    modified_input_string[len] = '\0';
+    free(cleaned_format);
+    if (modified_input_string[0] == '(' && modified_input_string[len-1] == ')') {
+        memmove(modified_input_string, modified_input_string + 1, strlen(modified_input_string));
+        modified_input_string[len-2] = '\0';
+    }
+    int format_values_count = 0,item_start_idx=0;
+    char** format_values = parse_fortran_format(modified_input_string,&format_values_count,&item_start_idx);
+    struct string_builder result_sb;
+    struct string_builder* result = &result_sb;
+    sb_init(result);
+    // Start of the current record, `T` positions are relative to it
+    int64_t record_start = 0;
+    int item_start = 0;
+    bool array = false;
+    while (1) {
+        int scale = 0;
+        for (int i = item_start; i < format_values_count; i++) {
+            if(format_values[i] == NULL) continue;
+            char* value = format_values[i];
+
+            if (value[0] == '(' && value[strlen(value)-1] == ')') {
+                value[strlen(value)-1] = '\0';
+                int new_fmt_val_count = 0;
+                char** new_fmt_val = parse_fortran_format(++value,&new_fmt_val_count,&item_start_idx);
+
+                char** ptr = (char**)realloc(format_values, (format_values_count + new_fmt_val_count + 1) * sizeof(char*));
+                if (ptr == NULL) {
+                    perror("Memory allocation failed.\n");
+                    free(format_values);
+                } else {
+                    format_values = ptr;
+                }
+                for (int k = format_values_count - 1; k >= i+1; k--) {
+                    format_values[k + new_fmt_val_count] = format_values[k];
+                }
+                for (int k = 0; k < new_fmt_val_count; k++) {
+                    format_values[i + 1 + k] = new_fmt_val[k];
+                }
+                format_values_count = format_values_count + new_fmt_val_count;
+                free(format_values[i]);
+                format_values[i] = NULL;
+                free(new_fmt_val);
+                continue;
+            }
+
+            if (value[0] == '/') {
+                sb_append(result, "\n");
+                record_start = result->len;
+            } else if (value[0] == '*') {
+                array = true;
+            } else if (isdigit(value[0]) && tolower(value[1]) == 'p') {
+                // Scale Factor nP
                 scale = atoi(&value[0]);
             } else if (value[0] == '-' && isdigit(value[1]) && tolower(value[2]) == 'p') {
                 char temp[3] = {value[0],value[1],'\0'};
@@ -811,96 +1542,89 @@ LFORTRAN_API char* _lcompilers_string_format_fortran(int count, const char* form
             } else if ((value[0] == '\"' && value[strlen(value) - 1] == '\"') ||
                 (value[0] == '\'' && value[strlen(value) - 1] == '\'')) {
                 // String
-                value = substring(value, 1, strlen(value) - 1);
-                result = append_to_string(result, value);
-                free(value);
+                sb_append_n(result, value + 1, strlen(value) - 2);
             } else if (tolower(value[0]) == 'a') {
                 // Character Editing (A[n])
-                if ( count == 0 ) break;
-                count--;
-                char* arg = va_arg(args, char*);
+                if ( fa->count == 0 ) break;
+                fa->count--;
+                char* arg = format_args_string(fa);
                 if (arg == NULL) continue;
                 if (strlen(value) == 1) {
-                    result = append_to_string(result, arg);
+                    sb_append(result, arg);
                 } else {
-                    char* str = (char*)malloc((strlen(value)) * sizeof(char));
-                    memmove(str, value+1, strlen(value));
-                    int buffer_size = 20;
-                    char* s = (char*)malloc(buffer_size * sizeof(char));
-                    snprintf(s, buffer_size, "%%%s.%ss", str, str);
-                    char* string = (char*)malloc((atoi(str) + 1) * sizeof(char));
-                    sprintf(string,s, arg);
-                    result = append_to_string(result, string);
-                    free(str);
-                    free(s);
-                    free(string);
+                    // Right justified in a field of width n, truncated
+                    // to its first n characters if longer
+                    int width = atoi(value + 1);
+                    int arg_len = strlen(arg);
+                    if (arg_len < width) {
+                        sb_append_char(result, ' ', width - arg_len);
+                        sb_append_n(result, arg, arg_len);
+                    } else {
+                        sb_append_n(result, arg, width);
+                    }
                 }
             } else if (tolower(value[strlen(value) - 1]) == 'x') {
-                result = append_to_string(result, " ");
+                sb_append(result, " ");
             } else if (tolower(value[0]) == 'i') {
                 // Integer Editing ( I[w[.m]] )
-                if ( count == 0 ) break;
-                count--;
-                int64_t val = va_arg(args, int64_t);
-                handle_integer(value, val, &result);
+                if ( fa->count == 0 ) break;
+                fa->count--;
+                int64_t val = format_args_integer(fa);
+                handle_integer(value, val, result);
             } else if (tolower(value[0]) == 'd') {
                 // D Editing (D[w[.d]])
-                if ( count == 0 ) break;
-                count--;
-                double val = va_arg(args, double);
-                handle_decimal(value, val, scale, &result, "D");
+                if ( fa->count == 0 ) break;
+                fa->count--;
+                double val = format_args_real(fa);
+                handle_decimal(value, val, scale, result, "D");
             } else if (tolower(value[0]) == 'e') {
                 // Check if the next character is 'N' for EN format
                 char format_type = tolower(value[1]);
                 if (format_type == 'n') {
-                    if (count == 0) break;
-                    count--;
-                    double val = va_arg(args, double);
-                    handle_en(value, val, scale, &result, "E");
+                    if (fa->count == 0) break;
+                    fa->count--;
+                    double val = format_args_real(fa);
+                    handle_en(value, val, scale, result, "E");
                 } else {
-                    if (count == 0) break;
-                    count--;
-                    double val = va_arg(args, double);
-                    handle_decimal(value, val, scale, &result, "E");
+                    if (fa->count == 0) break;
+                    fa->count--;
+                    double val = format_args_real(fa);
+                    handle_decimal(value, val, scale, result, "E");
                 }
             } else if (tolower(value[0]) == 'f') {
-                if ( count == 0 ) break;
-                count--;
-                double val = va_arg(args, double);
-                handle_float(value, val, &result);
+                if ( fa->count == 0 ) break;
+                fa->count--;
+                double val = format_args_real(fa);
+                handle_float(value, val, result);
             } else if (tolower(value[0]) == 'l') {
-                if ( count == 0 ) break;
-                count--;
-                char* val_str = va_arg(args, char*);
-                bool val = (strcmp(val_str, "True") == 0);
-                handle_logical(value, val, &result);
+                if ( fa->count == 0 ) break;
+                fa->count--;
+                bool val = format_args_logical(fa);
+                handle_logical(value, val, result);
             } else if (tolower(value[0]) == 't') {
-                if (count == 0) break;
+                if (fa->count == 0) break;
                 int tab_position = atoi(value + 1);
-                int current_length = strlen(result);
-                int spaces_needed = tab_position - current_length - 1;
+                int64_t current_length = result->len - record_start;
+                int64_t spaces_needed = tab_position - current_length - 1;
                 if (spaces_needed > 0) {
-                    char* spaces = (char*)malloc((spaces_needed + 1) * sizeof(char));
-                    memset(spaces, ' ', spaces_needed);
-                    spaces[spaces_needed] = '\0';
-                    result = append_to_string(result, spaces);
-                    free(spaces);
+                    sb_append_char(result, ' ', spaces_needed);
                 } else if (spaces_needed < 0) {
                     // Truncate the string to the length specified by Tn if the current position exceeds it
                     if (tab_position < current_length) {
-                        result[tab_position] = '\0';  // Truncate the string at the position specified by Tn
+                        sb_truncate(result, record_start + tab_position);
                     }
                 }
             } else if (strlen(value) != 0) {
-                if ( count == 0 ) break;
-                count--;
+                if ( fa->count == 0 ) break;
+                fa->count--;
                 printf("Printing support is not available for %s format.\n",value);
             }
 
         }
-        if ( count > 0 ) {
+        if ( fa->count > 0 ) {
             if (!array) {
-                result = append_to_string(result, "\n");
+                sb_append(result, "\n");
+                record_start = result->len;
             }
             item_start = item_start_idx;
         } else {
@@ -913,14 +1637,283 @@ LFORTRAN_API char* _lcompilers_string_format_fortran(int count, const char* form
             free(format_values[i]);
     }
     free(format_values);
+    return result->s;
+}
+
+LFORTRAN_API char* _lcompilers_string_format_fortran(int count, const char* format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    struct format_args fa;
+    memset(&fa, 0, sizeof(fa));
+    fa.count = count;
+    fa.args = &args;
+    fa.typed = false;
+    char* result = format_fortran(format, &fa);
+    va_end(args);
+    return result;
+}
+
+LFORTRAN_API char* _lcompilers_string_format_fortran_array(const char* format, int32_t n_items, ...)
+{
+    // The first walk over the items only counts the values, so that the
+    // format reversion knows when to stop
+    va_list args;
+    va_start(args, n_items);
+    struct format_args fa;
+    memset(&fa, 0, sizeof(fa));
+    fa.args = &args;
+    int64_t count = 0;
+    for (int32_t i = 0; i < n_items; i++) {
+        count += format_args_read_item(&fa);
+    }
+    va_end(args);
+
+    va_start(args, n_items);
+    memset(&fa, 0, sizeof(fa));
+    fa.count = count;
+    fa.args = &args;
+    fa.typed = true;
+    char* result = format_fortran(format, &fa);
+    va_end(args);
+    return result;
+}
+
+// >> Compiled formats >> ------------------------------------------------------
+
+static uint32_t format_read_operand(const uint8_t** pc) {
+    // Unsigned LEB128
+    uint32_t value = 0;
+    int shift = 0;
+    uint8_t byte;
+    do {
+        byte = *(*pc)++;
+        value |= (uint32_t)(byte & 0x7f) << shift;
+        shift += 7;
+    } while (byte & 0x80);
+    return value;
+}
+
+#define LFORTRAN_MAX_FORMAT_DEPTH 16
+
+/*
+Interprets a format compiled by the compiler (see `enum _lfortran_format_op`)
+with the same semantics as `format_fortran`, but without parsing or any
+allocation besides the result.
+*/
+static char* format_fortran_compiled(const uint8_t* code, struct format_args* fa)
+{
+    struct string_builder result_sb;
+    struct string_builder* result = &result_sb;
+    sb_init(result);
+    int64_t record_start = 0;
+    const uint8_t* reversion = code;
+    bool unlimited = false;
+    // Active repeat groups: where each starts and how often it still runs
+    const uint8_t* repeat_start[LFORTRAN_MAX_FORMAT_DEPTH];
+    uint32_t repeat_left[LFORTRAN_MAX_FORMAT_DEPTH];
+    const uint8_t* pc = code;
+    while (1) {
+        int scale = 0;
+        int depth = 0;
+        int64_t count_before = fa->count;
+        bool done = false;
+        while (!done) {
+            uint8_t op = *pc++;
+            switch (op) {
+                case _lfortran_format_op_end: {
+                    done = true;
+                    break;
+                }
+                case _lfortran_format_op_literal: {
+                    uint32_t n = format_read_operand(&pc);
+                    sb_append_n(result, (const char*)pc, n);
+                    pc += n;
+                    break;
+                }
+                case _lfortran_format_op_newline: {
+                    sb_append(result, "\n");
+                    record_start = result->len;
+                    break;
+                }
+                case _lfortran_format_op_space: {
+                    sb_append_char(result, ' ', format_read_operand(&pc));
+                    break;
+                }
+                case _lfortran_format_op_tab: {
+                    int64_t tab_position = format_read_operand(&pc);
+                    if (fa->count == 0) {
+                        done = true;
+                        break;
+                    }
+                    int64_t current_length = result->len - record_start;
+                    int64_t spaces_needed = tab_position - current_length - 1;
+                    if (spaces_needed > 0) {
+                        sb_append_char(result, ' ', spaces_needed);
+                    } else if (tab_position < current_length) {
+                        sb_truncate(result, record_start + tab_position);
+                    }
+                    break;
+                }
+                case _lfortran_format_op_scale: {
+                    uint32_t negative = format_read_operand(&pc);
+                    scale = format_read_operand(&pc);
+                    if (negative) scale = -scale;
+                    break;
+                }
+                case _lfortran_format_op_unlimited: {
+                    unlimited = true;
+                    break;
+                }
+                case _lfortran_format_op_reversion: {
+                    reversion = pc - 1;
+                    break;
+                }
+                case _lfortran_format_op_repeat: {
+                    repeat_left[depth] = format_read_operand(&pc);
+                    repeat_start[depth] = pc;
+                    depth++;
+                    break;
+                }
+                case _lfortran_format_op_repeat_end: {
+                    if (--repeat_left[depth - 1] > 0) {
+                        pc = repeat_start[depth - 1];
+                    } else {
+                        depth--;
+                    }
+                    break;
+                }
+                case _lfortran_format_op_a: {
+                    uint32_t width = format_read_operand(&pc);
+                    if (fa->count == 0) {
+                        done = true;
+                        break;
+                    }
+                    fa->count--;
+                    char* arg = format_args_string(fa);
+                    if (arg == NULL) break;
+                    int arg_len = strlen(arg);
+                    if (width == 0) {
+                        sb_append_n(result, arg, arg_len);
+                    } else if (arg_len < (int)width) {
+                        sb_append_char(result, ' ', width - arg_len);
+                        sb_append_n(result, arg, arg_len);
+                    } else {
+                        sb_append_n(result, arg, width);
+                    }
+                    break;
+                }
+                case _lfortran_format_op_i: {
+                    uint32_t width = format_read_operand(&pc);
+                    uint32_t min_width = format_read_operand(&pc);
+                    if (fa->count == 0) {
+                        done = true;
+                        break;
+                    }
+                    fa->count--;
+                    format_integer(width, min_width > 0 ? min_width - 1 : 0,
+                        min_width > 0, format_args_integer(fa), result);
+                    break;
+                }
+                case _lfortran_format_op_f: {
+                    uint32_t width = format_read_operand(&pc);
+                    uint32_t decimal_digits = format_read_operand(&pc);
+                    if (fa->count == 0) {
+                        done = true;
+                        break;
+                    }
+                    fa->count--;
+                    format_float(width, decimal_digits, format_args_real(fa), result);
+                    break;
+                }
+                case _lfortran_format_op_e:
+                case _lfortran_format_op_es:
+                case _lfortran_format_op_d: {
+                    uint32_t width = format_read_operand(&pc);
+                    uint32_t decimal_digits = format_read_operand(&pc);
+                    uint32_t exp = format_read_operand(&pc);
+                    if (fa->count == 0) {
+                        done = true;
+                        break;
+                    }
+                    fa->count--;
+                    format_decimal(width, decimal_digits, exp,
+                        op == _lfortran_format_op_es, format_args_real(fa), scale,
+                        result, op == _lfortran_format_op_d ? "D" : "E");
+                    break;
+                }
+                case _lfortran_format_op_en: {
+                    uint32_t width = format_read_operand(&pc);
+                    uint32_t decimal_digits = format_read_operand(&pc);
+                    if (fa->count == 0) {
+                        done = true;
+                        break;
+                    }
+                    fa->count--;
+                    format_en(width, decimal_digits, format_args_real(fa), result, "E");
+                    break;
+                }
+                case _lfortran_format_op_l: {
+                    uint32_t width = format_read_operand(&pc);
+                    if (fa->count == 0) {
+                        done = true;
+                        break;
+                    }
+                    fa->count--;
+                    format_logical(width, format_args_logical(fa), result);
+                    break;
+                }
+                default: {
+                    printf("Runtime error: invalid compiled format (opcode %d)\n", op);
+                    exit(1);
+                }
+            }
+        }
+        // A format without data edit descriptors cannot consume the values
+        if (fa->count > 0 && fa->count < count_before) {
+            if (!unlimited) {
+                sb_append(result, "\n");
+                record_start = result->len;
+            }
+            pc = reversion;
+        } else {
+            break;
+        }
+    }
+    return result->s;
+}
+
+LFORTRAN_API char* _lcompilers_string_format_fortran_compiled(const uint8_t* code, int32_t n_items, ...)
+{
+    va_list args;
+    va_start(args, n_items);
+    struct format_args fa;
+    memset(&fa, 0, sizeof(fa));
+    fa.args = &args;
+    int64_t count = 0;
+    for (int32_t i = 0; i < n_items; i++) {
+        count += format_args_read_item(&fa);
+    }
+    va_end(args);
+
+    va_start(args, n_items);
+    memset(&fa, 0, sizeof(fa));
+    fa.count = count;
+    fa.args = &args;
+    fa.typed = true;
+    char* result = format_fortran_compiled(code, &fa);
     va_end(args);
     return result;
 }
 
+// << Compiled formats << ------------------------------------------------------
+
 LFORTRAN_API void _lcompilers_print_error(const char* format, ...)
 {
     va_list args;
     va_start(args, format);
+    // Keep buffered stdout ordered with respect to the error message
+    fflush(stdout);
     vfprintf(stderr, format, args);
     fflush(stderr);
     va_end(args);
@@ -1629,58 +2622,207 @@ LFORTRAN_API double _lfortran_zphase(double_complex_t x)
     return atan2(cimag(x), creal(x));
 }
 
-// strcat  --------------------------------------------------------------------
+// >> String scratch arena >> -------------------------------------------------
 
-LFORTRAN_API void _lfortran_strcat(char** s1, char** s2, char** dest)
+// String temporaries that generated code only reads, like the operands of a
+// concatenation or a comparison, are allocated from a per-thread arena
+// instead of with malloc. Codegen brackets the expression that consumes them
+// with _lfortran_string_scratch_mark() and _lfortran_string_scratch_release(),
+// which frees all of them at once.
+//
+// Every scratch string is preceded by its length. The most recent one can be
+// extended in place, so `a // b // c // d` appends to a single buffer and
+// never recomputes the length of the partial result.
+
+#define LFORTRAN_SCRATCH_CHUNK_SIZE (64 * 1024)
+
+struct scratch_chunk {
+    struct scratch_chunk *prev;
+    // Total size of all the chunks below this one; marks are offsets into
+    // this virtual stack, so that they stay ordered across chunks
+    int64_t base;
+    size_t size;
+    size_t used;
+};
+
+struct scratch_arena {
+    struct scratch_chunk *chunk;
+    // One released chunk is kept to avoid a malloc/free pair per statement
+    struct scratch_chunk *spare;
+    // The most recent string, it ends at `chunk->used`
+    char *last;
+};
+
+static LFORTRAN_THREAD_LOCAL struct scratch_arena scratch;
+
+static inline char *scratch_chunk_data(struct scratch_chunk *c)
 {
-    int cntr = 0;
-    char trmn = '\0';
-    int s1_len = strlen(*s1);
-    int s2_len = strlen(*s2);
-    int trmn_size = sizeof(trmn);
-    char* dest_char = (char*)malloc(s1_len+s2_len+trmn_size);
-    for (int i = 0; i < s1_len; i++) {
-        dest_char[cntr] = (*s1)[i];
-        cntr++;
+    return (char *)(c + 1);
+}
+
+// Room taken by a string of length `len`: the length, the characters and
+// the terminating null, rounded up to keep the lengths aligned
+static inline size_t scratch_string_size(size_t len)
+{
+    return (sizeof(int64_t) + len + 1 + 7) & ~(size_t)7;
+}
+
+static inline int64_t *scratch_string_len(char *s)
+{
+    return (int64_t *)(s - sizeof(int64_t));
+}
+
+static char *scratch_alloc(size_t len)
+{
+    size_t need = scratch_string_size(len);
+    struct scratch_chunk *c = scratch.chunk;
+    if (c == NULL || c->size - c->used < need) {
+        // Leave room to extend large strings in place
+        size_t size = 2 * need > LFORTRAN_SCRATCH_CHUNK_SIZE ? 2 * need : LFORTRAN_SCRATCH_CHUNK_SIZE;
+        struct scratch_chunk *n;
+        if (scratch.spare && scratch.spare->size >= size) {
+            n = scratch.spare;
+            scratch.spare = NULL;
+        } else {
+            n = (struct scratch_chunk *)malloc(sizeof(struct scratch_chunk) + size);
+            if (n == NULL) {
+                fprintf(stderr, "Error: out of memory for string temporaries\n");
+                exit(1);
+            }
+            n->size = size;
+        }
+        n->prev = c;
+        n->base = c ? c->base + (int64_t)c->size : 0;
+        n->used = 0;
+        scratch.chunk = n;
+        c = n;
+    }
+    char *s = scratch_chunk_data(c) + c->used + sizeof(int64_t);
+    c->used += need;
+    *scratch_string_len(s) = len;
+    s[len] = '\0';
+    scratch.last = s;
+    return s;
+}
+
+// Grows the most recent scratch string `s` to `len` characters in place.
+// Returns false if `s` is not the most recent string or does not fit.
+static bool scratch_extend(char *s, size_t len)
+{
+    struct scratch_chunk *c = scratch.chunk;
+    if (s == NULL || s != scratch.last) return false;
+    size_t start = (size_t)(s - sizeof(int64_t) - scratch_chunk_data(c));
+    size_t need = scratch_string_size(len);
+    if (c->size - start < need) return false;
+    c->used = start + need;
+    *scratch_string_len(s) = len;
+    s[len] = '\0';
+    return true;
+}
+
+static inline size_t scratch_strlen(char *s)
+{
+    return s == scratch.last && s != NULL ? (size_t)*scratch_string_len(s) : strlen(s);
+}
+
+LFORTRAN_API int64_t _lfortran_string_scratch_mark()
+{
+    struct scratch_chunk *c = scratch.chunk;
+    return c ? c->base + (int64_t)c->used : 0;
+}
+
+LFORTRAN_API void _lfortran_string_scratch_release(int64_t mark)
+{
+    struct scratch_chunk *c = scratch.chunk;
+    while (c && c->base > mark) {
+        struct scratch_chunk *prev = c->prev;
+        if (scratch.spare == NULL) {
+            scratch.spare = c;
+        } else if (scratch.spare->size < c->size) {
+            free(scratch.spare);
+            scratch.spare = c;
+        } else {
+            free(c);
+        }
+        c = prev;
     }
-    for (int i = 0; i < s2_len; i++) {
-        dest_char[cntr] = (*s2)[i];
-        cntr++;
+    scratch.chunk = c;
+    if (c && c->base + (int64_t)c->used > mark) {
+        c->used = (size_t)(mark - c->base);
     }
-    dest_char[cntr] = trmn;
-    *dest = &(dest_char[0]);
+    scratch.last = NULL;
+}
+
+// << String scratch arena << -------------------------------------------------
+
+// Allocates room for a string of length `len` and its terminating null,
+// from the scratch arena for temporaries that are only read
+static inline char *str_alloc(size_t len, bool in_scratch)
+{
+    return in_scratch ? scratch_alloc(len) : (char *)malloc(len + 1);
+}
+
+// strcat  --------------------------------------------------------------------
+
+static void str_concat(char **s1, char **s2, char **dest, bool in_scratch)
+{
+    size_t s1_len = scratch_strlen(*s1);
+    size_t s2_len = scratch_strlen(*s2);
+    char *dest_char;
+    if (in_scratch && scratch_extend(*s1, s1_len + s2_len)) {
+        // `*s1` is the previous partial result of a chain of concatenations
+        dest_char = *s1;
+    } else {
+        dest_char = str_alloc(s1_len + s2_len, in_scratch);
+        memcpy(dest_char, *s1, s1_len);
+    }
+    memcpy(dest_char + s1_len, *s2, s2_len);
+    dest_char[s1_len + s2_len] = '\0';
+    *dest = dest_char;
+}
+
+LFORTRAN_API void _lfortran_strcat(char** s1, char** s2, char** dest)
+{
+    str_concat(s1, s2, dest, false);
+}
+
+LFORTRAN_API void _lfortran_strcat_scratch(char** s1, char** s2, char** dest)
+{
+    str_concat(s1, s2, dest, true);
 }
 
 // strcpy -----------------------------------------------------------
 
 LFORTRAN_API void _lfortran_strcpy(char** x, char *y, int8_t free_target)
 {
+    size_t y_len = strlen(y);
     if (free_target) {
         if (*x) {
             // We should free `x` here, but cannot due to:
             // https://github.com/lfortran/lfortran/issues/3787
             //free((void *)*x);
         }
-        *x = (char*) malloc((strlen(y) + 1) * sizeof(char));
-        _lfortran_string_init(strlen(y) + 1, *x);
+        *x = (char*) malloc((y_len + 1) * sizeof(char));
+        _lfortran_string_init(y_len + 1, *x);
     }
     if( *x == NULL ) {
-        *x = (char*) malloc((strlen(y) + 1) * sizeof(char));
-        _lfortran_string_init(strlen(y) + 1, *x);
+        *x = (char*) malloc((y_len + 1) * sizeof(char));
+        _lfortran_string_init(y_len + 1, *x);
     }
-    for (size_t i = 0; i < strlen(*x); i++) {
-        if (i < strlen(y)) {
-            x[0][i] = y[i];
-        } else {
-            x[0][i] = ' ';
-        }
+    // Copy into the existing length of `x`, padding with blanks
+    size_t x_len = strlen(*x);
+    if (x_len <= y_len) {
+        memmove(*x, y, x_len);
+    } else {
+        memmove(*x, y, y_len);
+        memset(*x + y_len, ' ', x_len - y_len);
     }
 }
 
 #define MIN(x, y) ((x < y) ? x : y)
 
 int strlen_without_trailing_space(char *str) {
-    int end = strlen(str) - 1;
+    int end = scratch_strlen(str) - 1;
     while(end >= 0 && str[end] == ' ') end--;
     return end + 1;
 }
@@ -1860,21 +3002,29 @@ LFORTRAN_API char* _lfortran_strrepeat_c(char* s, int32_t n)
 }
 
 // idx starts from 1
-LFORTRAN_API char* _lfortran_str_item(char* s, int32_t idx) {
+static char* str_item(char* s, int32_t idx, bool in_scratch) {
 
-    int s_len = strlen(s);
+    int s_len = scratch_strlen(s);
     int original_idx = idx - 1;
     if (idx < 1) idx += s_len;
     if (idx < 1 || idx >= s_len + 1) {
         printf("String index: %d is out of Bounds\n", original_idx);
         exit(1);
     }
-    char* res = (char*)malloc(2);
+    char* res = str_alloc(1, in_scratch);
     res[0] = s[idx-1];
     res[1] = '\0';
     return res;
 }
 
+LFORTRAN_API char* _lfortran_str_item(char* s, int32_t idx) {
+    return str_item(s, idx, false);
+}
+
+LFORTRAN_API char* _lfortran_str_item_scratch(char* s, int32_t idx) {
+    return str_item(s, idx, true);
+}
+
 // idx1 and idx2 both start from 1
 LFORTRAN_API char* _lfortran_str_copy(char* s, int32_t idx1, int32_t idx2) {
 
@@ -1898,9 +3048,9 @@ LFORTRAN_API char* _lfortran_str_copy(char* s, int32_t idx1, int32_t idx2) {
     return dest_char;
 }
 
-LFORTRAN_API char* _lfortran_str_slice(char* s, int32_t idx1, int32_t idx2, int32_t step,
-                        bool idx1_present, bool idx2_present) {
-    int s_len = strlen(s);
+static char* str_slice(char* s, int32_t idx1, int32_t idx2, int32_t step,
+                        bool idx1_present, bool idx2_present, bool in_scratch) {
+    int s_len = scratch_strlen(s);
     if (step == 0) {
         printf("slice step cannot be zero\n");
         exit(1);
@@ -1934,23 +3084,38 @@ LFORTRAN_API char* _lfortran_str_slice(char* s, int32_t idx1, int32_t idx2, int3
         dest_len = (idx2-idx1+step+1)/step + 1;
     }
 
-    char* dest_char = (char*)malloc(dest_len);
+    char* dest_char = str_alloc(dest_len - 1, in_scratch);
     int s_i = idx1, d_i = 0;
-    while((step > 0 && s_i >= idx1 && s_i < idx2) ||
-        (step < 0 && s_i <= idx1 && s_i > idx2)) {
-        dest_char[d_i++] = s[s_i];
-        s_i+=step;
+    if (step == 1) {
+        memcpy(dest_char, s + idx1, dest_len - 1);
+        d_i = dest_len - 1;
+    } else {
+        while((step > 0 && s_i >= idx1 && s_i < idx2) ||
+            (step < 0 && s_i <= idx1 && s_i > idx2)) {
+            dest_char[d_i++] = s[s_i];
+            s_i+=step;
+        }
     }
     dest_char[d_i] = '\0';
     return dest_char;
 }
 
-LFORTRAN_API char* _lfortran_str_slice_assign(char* s, char *r, int32_t idx1, int32_t idx2, int32_t step,
+LFORTRAN_API char* _lfortran_str_slice(char* s, int32_t idx1, int32_t idx2, int32_t step,
                         bool idx1_present, bool idx2_present) {
-    int s_len = strlen(s);
-    int r_len = strlen(r);
-    if (step == 0) {
-        printf("slice step cannot be zero\n");
+    return str_slice(s, idx1, idx2, step, idx1_present, idx2_present, false);
+}
+
+LFORTRAN_API char* _lfortran_str_slice_scratch(char* s, int32_t idx1, int32_t idx2, int32_t step,
+                        bool idx1_present, bool idx2_present) {
+    return str_slice(s, idx1, idx2, step, idx1_present, idx2_present, true);
+}
+
+LFORTRAN_API char* _lfortran_str_slice_assign(char* s, char *r, int32_t idx1, int32_t idx2, int32_t step,
+                        bool idx1_present, bool idx2_present) {
+    int s_len = strlen(s);
+    int r_len = strlen(r);
+    if (step == 0) {
+        printf("slice step cannot be zero\n");
         exit(1);
     }
     s_len = (s_len < r_len) ? r_len : s_len;
@@ -1989,7 +3154,7 @@ LFORTRAN_API char* _lfortran_str_slice_assign(char* s, char *r, int32_t idx1, in
 
 LFORTRAN_API int32_t _lfortran_str_len(char** s)
 {
-    return strlen(*s);
+    return scratch_strlen(*s);
 }
 
 LFORTRAN_API int _lfortran_str_to_int(char** s)
@@ -2192,14 +3357,6 @@ LFORTRAN_API double _lfortran_time()
 #endif
 }
 
-LFORTRAN_API float _lfortran_sp_rand_num() {
-    return rand() / (float) RAND_MAX;
-}
-
-LFORTRAN_API double _lfortran_dp_rand_num() {
-    return rand() / (double) RAND_MAX;
-}
-
 LFORTRAN_API int64_t _lpython_open(char *path, char *flags)
 {
     FILE *fd;
@@ -2213,67 +3370,194 @@ LFORTRAN_API int64_t _lpython_open(char *path, char *flags)
     return (int64_t)fd;
 }
 
-#define MAXUNITS 1000
+// >> Unit table >> -----------------------------------------------------------
+
+enum unit_access {
+    unit_access_sequential,
+    unit_access_stream,
+    unit_access_direct
+};
+
+// Progress of a list-directed read statement, see `list_read_next`
+struct list_read_state {
+    int64_t repeat;        // Remaining repetitions of `token` (`r*c`)
+    bool null_value;       // The repeated value is null (`r*`)
+    bool slash;            // A slash ended the input of the statement
+    bool blank_separator;  // The last value ended with blanks or a record end
+    char* token;           // The current value
+    size_t token_capacity;
+};
+
+// Asynchronous transfers of a unit (see "Asynchronous I/O"), allocated
+// separately as the unit table moves its entries
+struct async_unit {
+    int32_t last_id;       // Id of the last started transfer
+    int32_t completed_id;  // The transfers up to this id completed
+    int32_t error_id;      // First failed transfer not reported yet, or 0
+    int32_t error_status;
+    bool error_read;
+};
 
+// State of a connected unit
 struct UNIT_FILE {
     int32_t unit;
-    FILE* filep;
-    bool unit_file_bin;
+    FILE* filep;           // NULL for a free slot of the table
+    bool unit_file_bin;    // FORM="unformatted"
+    enum unit_access access; // Sequential records have length markers
+    char* buffer;          // stdio buffer of `filep`
+    // The unit was positioned (OPEN, REWIND, BACKSPACE) since the last
+    // sequential write, so the next one ends the file after its record
+    bool end_file_on_write;
+    struct list_read_state list_read;
+    struct async_unit* async; // NULL unless ASYNCHRONOUS="yes"
 };
 
-int32_t last_index_used = -1;
+/*
+Connected units, in an open addressing hash table with linear probing,
+indexed by the unit number. Any unit number can be connected, and looking
+a unit up on every read and write does not depend on how many are open.
+*/
+static struct UNIT_FILE* unit_table = NULL;
+static uint32_t unit_table_capacity = 0; // 0 or a power of two
+static uint32_t unit_table_size = 0;
 
-struct UNIT_FILE unit_to_file[MAXUNITS];
+static inline uint32_t unit_table_slot(int32_t unit_num) {
+    // Fibonacci hashing, consecutive unit numbers spread over the table
+    return ((uint32_t)unit_num * 2654435769u) & (unit_table_capacity - 1);
+}
 
-void store_unit_file(int32_t unit_num, FILE* filep, bool unit_file_bin) {
-    for( int i = 0; i <= last_index_used; i++ ) {
-        if( unit_to_file[i].unit == unit_num ) {
-            unit_to_file[i].unit = unit_num;
-            unit_to_file[i].filep = filep;
-            unit_to_file[i].unit_file_bin = unit_file_bin;
+static struct UNIT_FILE* find_unit(int32_t unit_num) {
+    if (unit_table_size == 0) {
+        return NULL;
+    }
+    for (uint32_t i = unit_table_slot(unit_num); ;
+            i = (i + 1) & (unit_table_capacity - 1)) {
+        if (unit_table[i].filep == NULL) {
+            return NULL;
         }
+        if (unit_table[i].unit == unit_num) {
+            return &unit_table[i];
+        }
+    }
+}
+
+static void async_unit_wait(struct async_unit* a);
+
+// Looks the unit up once its pending asynchronous transfers completed, so
+// that other statements see the unit in the state the program order implies
+static struct UNIT_FILE* get_unit(int32_t unit_num) {
+    struct UNIT_FILE* u = find_unit(unit_num);
+    if (u != NULL && u->async != NULL) {
+        async_unit_wait(u->async);
     }
-    last_index_used += 1;
-    if( last_index_used >= MAXUNITS ) {
-        printf("Only %d units can be opened for now\n.", MAXUNITS);
+    return u;
+}
+
+static void unit_table_grow() {
+    struct UNIT_FILE* old_table = unit_table;
+    uint32_t old_capacity = unit_table_capacity;
+    unit_table_capacity = old_capacity == 0 ? 64 : 2 * old_capacity;
+    unit_table = (struct UNIT_FILE*) calloc(unit_table_capacity,
+        sizeof(struct UNIT_FILE));
+    if (unit_table == NULL) {
+        printf("Runtime error: Memory allocation failed for the unit table\n");
         exit(1);
     }
-    unit_to_file[last_index_used].unit = unit_num;
-    unit_to_file[last_index_used].filep = filep;
-    unit_to_file[last_index_used].unit_file_bin = unit_file_bin;
+    for (uint32_t i = 0; i < old_capacity; i++) {
+        if (old_table[i].filep == NULL) continue;
+        uint32_t j = unit_table_slot(old_table[i].unit);
+        while (unit_table[j].filep != NULL) {
+            j = (j + 1) & (unit_table_capacity - 1);
+        }
+        unit_table[j] = old_table[i];
+    }
+    free(old_table);
 }
 
-FILE* get_file_pointer_from_unit(int32_t unit_num, bool *unit_file_bin) {
-    *unit_file_bin = false;
-    for( int i = 0; i <= last_index_used; i++ ) {
-        if( unit_to_file[i].unit == unit_num ) {
-            *unit_file_bin = unit_to_file[i].unit_file_bin;
-            return unit_to_file[i].filep;
+void store_unit_file(int32_t unit_num, FILE* filep, bool unit_file_bin,
+        enum unit_access access, bool asynchronous, char* buffer) {
+    struct UNIT_FILE* u = get_unit(unit_num);
+    if (u == NULL) {
+        // Keep the table at most half full, so that probe sequences stay short
+        if (2 * (unit_table_size + 1) > unit_table_capacity) {
+            unit_table_grow();
         }
+        uint32_t i = unit_table_slot(unit_num);
+        while (unit_table[i].filep != NULL) {
+            i = (i + 1) & (unit_table_capacity - 1);
+        }
+        u = &unit_table[i];
+        unit_table_size++;
     }
-    return NULL;
+    u->unit = unit_num;
+    u->filep = filep;
+    u->unit_file_bin = unit_file_bin;
+    u->access = access;
+    u->buffer = buffer;
+    u->end_file_on_write = true;
+    free(u->list_read.token);
+    memset(&u->list_read, 0, sizeof(u->list_read));
+    if (asynchronous && u->async == NULL) {
+        u->async = (struct async_unit*) calloc(1, sizeof(struct async_unit));
+    } else if (!asynchronous) {
+        free(u->async);
+        u->async = NULL;
+    }
+}
+
+FILE* get_file_pointer_from_unit(int32_t unit_num, bool *unit_file_bin) {
+    struct UNIT_FILE* u = get_unit(unit_num);
+    if (u == NULL) {
+        *unit_file_bin = false;
+        return NULL;
+    }
+    *unit_file_bin = u->unit_file_bin;
+    return u->filep;
 }
 
 void remove_from_unit_to_file(int32_t unit_num) {
-    int index = -1;
-    for( int i = 0; i <= last_index_used; i++ ) {
-        if( unit_to_file[i].unit == unit_num ) {
-            index = i;
-            break;
-        }
+    struct UNIT_FILE* u = get_unit(unit_num);
+    if (u == NULL) {
+        return;
     }
-    if( index == -1 ) {
-        return ;
+    free(u->buffer);
+    free(u->list_read.token);
+    free(u->async);
+    // Backward shift deletion: move later entries of the probe sequence
+    // into the hole, unless that would put them before their home slot
+    uint32_t mask = unit_table_capacity - 1;
+    uint32_t hole = u - unit_table;
+    for (uint32_t i = (hole + 1) & mask; unit_table[i].filep != NULL;
+            i = (i + 1) & mask) {
+        uint32_t home = unit_table_slot(unit_table[i].unit);
+        if (((i - home) & mask) >= ((i - hole) & mask)) {
+            unit_table[hole] = unit_table[i];
+            hole = i;
+        }
     }
-    for( int i = index; i < last_index_used; i++ ) {
-        unit_to_file[i].unit = unit_to_file[i + 1].unit;
-        unit_to_file[i].filep = unit_to_file[i + 1].filep;
-        unit_to_file[i].unit_file_bin = unit_to_file[i + 1].unit_file_bin;
+    memset(&unit_table[hole], 0, sizeof(struct UNIT_FILE));
+    unit_table_size--;
+}
+
+// The next unit NEWUNIT= tries. Units from NEWUNIT= are negative, so that
+// they never clash with the units a program picks, and start below -1,
+// which stands for the standard input.
+static int32_t next_newunit = -10;
+
+LFORTRAN_API int32_t _lfortran_newunit() {
+    // Skips units from earlier NEWUNIT= that are still connected
+    while (find_unit(next_newunit) != NULL) {
+        next_newunit = next_newunit == INT32_MIN ? -10 : next_newunit - 1;
     }
-    last_index_used -= 1;
+    int32_t unit = next_newunit;
+    next_newunit = next_newunit == INT32_MIN ? -10 : next_newunit - 1;
+    return unit;
 }
 
-LFORTRAN_API int64_t _lfortran_open(int32_t unit_num, char *f_name, char *status, char *form)
+// << Unit table << -----------------------------------------------------------
+
+LFORTRAN_API int64_t _lfortran_open(int32_t unit_num, char *f_name, char *status, char *form,
+    char *access, char *asynchronous)
 {
     if (f_name == NULL) {
         f_name = "_lfortran_generated_file.txt";
@@ -2286,6 +3570,14 @@ LFORTRAN_API int64_t _lfortran_open(int32_t unit_num, char *f_name, char *status
     if (form == NULL) {
         form = "formatted";
     }
+
+    if (access == NULL) {
+        access = "sequential";
+    }
+
+    if (asynchronous == NULL) {
+        asynchronous = "no";
+    }
     bool file_exists[1] = {false};
     _lfortran_inquire(f_name, file_exists, -1, NULL);
     char *access_mode = NULL;
@@ -2342,6 +3634,32 @@ LFORTRAN_API int64_t _lfortran_open(int32_t unit_num, char *f_name, char *status
         exit(1);
     }
 
+    enum unit_access unit_access;
+    if (streql(access, "sequential")) {
+        unit_access = unit_access_sequential;
+    } else if (streql(access, "stream")) {
+        unit_access = unit_access_stream;
+    } else if (streql(access, "direct")) {
+        printf("Runtime error: ACCESS=`direct` in OPEN statement is not "
+            "supported yet\n");
+        exit(1);
+    } else {
+        printf("Runtime error: ACCESS specifier in OPEN statement has "
+            "invalid value '%s'\n", access);
+        exit(1);
+    }
+
+    bool unit_async;
+    if (streql(asynchronous, "yes")) {
+        unit_async = true;
+    } else if (streql(asynchronous, "no")) {
+        unit_async = false;
+    } else {
+        printf("Runtime error: ASYNCHRONOUS specifier in OPEN statement has "
+            "invalid value '%s'\n", asynchronous);
+        exit(1);
+    }
+
     FILE *fd = fopen(f_name, access_mode);
     if (!fd)
     {
@@ -2349,7 +3667,14 @@ LFORTRAN_API int64_t _lfortran_open(int32_t unit_num, char *f_name, char *status
         perror(f_name);
         exit(1);
     }
-    store_unit_file(unit_num, fd, unit_file_bin);
+    char *buffer = NULL;
+    if (!_lfortran_unbuffered_io) {
+        buffer = (char*) malloc(LFORTRAN_IO_BUFFER_SIZE);
+        if (buffer != NULL) {
+            setvbuf(fd, buffer, _IOFBF, LFORTRAN_IO_BUFFER_SIZE);
+        }
+    }
+    store_unit_file(unit_num, fd, unit_file_bin, unit_access, unit_async, buffer);
     return (int64_t)fd;
 }
 
@@ -2358,6 +3683,11 @@ LFORTRAN_API void _lfortran_flush(int32_t unit_num)
     bool unit_file_bin;
     FILE* filep = get_file_pointer_from_unit(unit_num, &unit_file_bin);
     if( filep == NULL ) {
+        if( unit_num == 6 || unit_num == -1 ) {
+            // Preconnected output unit
+            fflush(stdout);
+            return;
+        }
         printf("Specified UNIT %d in FLUSH is not connected.\n", unit_num);
         exit(1);
     }
@@ -2390,24 +3720,25 @@ LFORTRAN_API void _lfortran_inquire(char *f_name, bool *exists, int32_t unit_num
 
 LFORTRAN_API void _lfortran_rewind(int32_t unit_num)
 {
-    bool unit_file_bin;
-    FILE* filep = get_file_pointer_from_unit(unit_num, &unit_file_bin);
-    if( filep == NULL ) {
+    struct UNIT_FILE* u = get_unit(unit_num);
+    if( u == NULL ) {
         printf("Specified UNIT %d in REWIND is not created or connected.\n", unit_num);
         exit(1);
     }
-    rewind(filep);
+    rewind(u->filep);
+    u->end_file_on_write = true;
 }
 
 LFORTRAN_API void _lfortran_backspace(int32_t unit_num)
 {
-    bool unit_file_bin;
-    FILE* fd = get_file_pointer_from_unit(unit_num, &unit_file_bin);
-    if( fd == NULL ) {
+    struct UNIT_FILE* u = get_unit(unit_num);
+    if( u == NULL ) {
         printf("Specified UNIT %d in BACKSPACE is not created or connected.\n",
             unit_num);
         exit(1);
     }
+    u->end_file_on_write = true;
+    FILE* fd = u->filep;
     int n = ftell(fd);
     for(int i = n; i >= 0; i --) {
         char c = fgetc(fd);
@@ -2423,108 +3754,515 @@ LFORTRAN_API void _lfortran_backspace(int32_t unit_num)
     }
 }
 
-LFORTRAN_API void _lfortran_read_int32(int32_t *p, int32_t unit_num)
-{
-    if (unit_num == -1) {
-        // Read from stdin
-        (void)!scanf("%d", p);
-        return;
-    }
+// >> List-directed input >> --------------------------------------------------
 
-    bool unit_file_bin;
-    FILE* filep = get_file_pointer_from_unit(unit_num, &unit_file_bin);
-    if (!filep) {
-        printf("No file found with given unit\n");
-        exit(1);
+/*
+List-directed input of numbers is tokenized by hand instead of with fscanf,
+which is slow, depends on the locale and does not know the Fortran rules:
+values are separated by blanks, ends of records or a comma, `r*c` stands
+for `r` copies of `c`, `r*` and an empty value between two commas are null
+values that leave the item unchanged, and a slash ends the input of the
+statement, leaving the remaining items unchanged. The state that outlives
+one item (repeats and slashes) is kept in the unit until the end of the
+statement, see `_lfortran_empty_read`.
+*/
+
+#if defined(_WIN32)
+#define list_read_lock(fp) _lock_file(fp)
+#define list_read_unlock(fp) _unlock_file(fp)
+#define list_read_getc(fp) _getc_nolock(fp)
+#else
+#define list_read_lock(fp) flockfile(fp)
+#define list_read_unlock(fp) funlockfile(fp)
+#define list_read_getc(fp) getc_unlocked(fp)
+#endif
+
+enum list_read_type {
+    list_read_int8,
+    list_read_int16,
+    list_read_int32,
+    list_read_int64,
+    list_read_real32,
+    list_read_real64,
+    list_read_complex32,
+    list_read_complex64
+};
+
+static struct list_read_state stdin_list_read;
+
+static size_t list_read_type_size(enum list_read_type type) {
+    switch (type) {
+        case list_read_int8: return 1;
+        case list_read_int16: return 2;
+        case list_read_int32: return 4;
+        case list_read_real32: return 4;
+        case list_read_complex32: return 8;
+        case list_read_complex64: return 16;
+        default: return 8;
     }
+}
 
-    if (unit_file_bin) {
-        (void)!fread(p, sizeof(*p), 1, filep);
-    } else {
-        (void)!fscanf(filep, "%d", p);
+static const char* list_read_type_name(enum list_read_type type) {
+    switch (type) {
+        case list_read_int8:
+        case list_read_int16:
+        case list_read_int32:
+        case list_read_int64: return "integer";
+        case list_read_real32:
+        case list_read_real64: return "real";
+        default: return "complex";
     }
 }
 
-LFORTRAN_API void _lfortran_read_int64(int64_t *p, int32_t unit_num)
-{
-    if (unit_num == -1) {
-        // Read from stdin
-        (void)!scanf("%" PRId64, p);
-        return;
+static inline bool list_read_is_blank(int c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+static void list_read_append(struct list_read_state* r, size_t n, int c) {
+    if (n + 1 >= r->token_capacity) {
+        r->token_capacity = r->token_capacity == 0 ? 64 : 2 * r->token_capacity;
+        r->token = (char*)realloc(r->token, r->token_capacity);
+        if (r->token == NULL) {
+            printf("Runtime error: Memory allocation failed in list-directed input\n");
+            exit(1);
+        }
     }
+    r->token[n] = (char)c;
+}
 
-    bool unit_file_bin;
-    FILE* filep = get_file_pointer_from_unit(unit_num, &unit_file_bin);
-    if (!filep) {
-        printf("No file found with given unit\n");
-        exit(1);
+/*
+Reads the next value of the statement into `r->token`. Returns false for a
+null value, and at the end of the file, which also sets `*eof`.
+*/
+static bool list_read_next(FILE* fp, struct list_read_state* r, bool* eof) {
+    if (r->repeat > 0) {
+        r->repeat--;
+        return !r->null_value;
+    }
+    if (r->slash) {
+        return false;
+    }
+    // Blanks and ends of records around a comma are part of one separator,
+    // so a comma that follows the blanks ending the last value is skipped
+    int c;
+    do {
+        c = list_read_getc(fp);
+        if (c == ',' && r->blank_separator) {
+            r->blank_separator = false;
+            c = ' ';
+        }
+    } while (list_read_is_blank(c));
+    r->blank_separator = false;
+    if (c == EOF) {
+        *eof = true;
+        return false;
+    }
+    if (c == ',') {
+        return false;
+    }
+    if (c == '/') {
+        r->slash = true;
+        return false;
+    }
+    // A complex value is enclosed in parentheses, which may contain
+    // separators and span records
+    size_t n = 0;
+    bool in_parentheses = false;
+    while (c != EOF) {
+        if (in_parentheses) {
+            in_parentheses = c != ')';
+        } else if (c == '(') {
+            in_parentheses = true;
+        } else if (list_read_is_blank(c) || c == ',' || c == '/') {
+            break;
+        }
+        if (c != '\n' && c != '\r') {
+            list_read_append(r, n++, c);
+        }
+        c = list_read_getc(fp);
     }
+    list_read_append(r, n, '\0');
+    // Consume the separator after the value. An end of record is left to
+    // `_lfortran_empty_read`, which skips the rest of the record.
+    while (c == ' ' || c == '\t') {
+        c = list_read_getc(fp);
+    }
+    if (c != ',' && c != EOF) {
+        ungetc(c, fp);
+    }
+    r->blank_separator = c != ',' && c != '/';
 
-    if (unit_file_bin) {
-        (void)!fread(p, sizeof(*p), 1, filep);
-    } else {
-        (void)!fscanf(filep, "%" PRId64, p);
+    size_t digits = 0;
+    while (isdigit((unsigned char)r->token[digits])) {
+        digits++;
     }
+    if (digits > 0 && r->token[digits] == '*') {
+        int64_t count = strtoll(r->token, NULL, 10);
+        if (count < 1) {
+            printf("Runtime error: Repeat count in list-directed input must be "
+                "positive, found `%s`\n", r->token);
+            exit(1);
+        }
+        memmove(r->token, r->token + digits + 1, n - digits);
+        r->repeat = count - 1;
+        r->null_value = r->token[0] == '\0';
+        return !r->null_value;
+    }
+    return true;
 }
 
-LFORTRAN_API void _lfortran_read_array_int8(int8_t *p, int array_size, int32_t unit_num)
-{
-    if (unit_num == -1) {
-        // Read from stdin
-        for (int i = 0; i < array_size; i++) {
-            (void)!scanf("%s", &p[i]);
+// Parses an integer, [sign] digits, from `s` to `end`
+static bool list_read_parse_int(const char* s, const char* end, int64_t* value) {
+    bool negative = false;
+    if (s < end && (*s == '+' || *s == '-')) {
+        negative = *s++ == '-';
+    }
+    if (s == end) {
+        return false;
+    }
+    uint64_t limit = negative ? (uint64_t)INT64_MAX + 1 : (uint64_t)INT64_MAX;
+    uint64_t v = 0;
+    for (; s < end; s++) {
+        if (!isdigit((unsigned char)*s)) {
+            return false;
         }
-        return;
+        uint64_t d = *s - '0';
+        if (v > (limit - d) / 10) {
+            return false;
+        }
+        v = 10 * v + d;
     }
+    *value = negative ? -(int64_t)(v - 1) - 1 : (int64_t)v;
+    return true;
+}
 
-    bool unit_file_bin;
-    FILE* filep = get_file_pointer_from_unit(unit_num, &unit_file_bin);
-    if (!filep) {
-        printf("No file found with given unit\n");
-        exit(1);
+// Powers of ten that are exactly representable as doubles
+static const double list_read_powers_of_ten[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+/*
+Parses a real, [sign] digits [. digits] [exponent], from `s` to `end`; the
+exponent letter is E, D or Q, and may be left out if the exponent is
+signed. Clinger's fast path converts a value exactly when its significant
+digits form an integer of at most 2^53 and the power of ten is at most
+1e22 in magnitude (2^24 and 1e10 for real(4)): both are then exact in
+floating point, so a single multiplication or division rounds correctly.
+The others, and Inf and NaN, are converted by strtod (strtof for real(4)).
+*/
+static bool list_read_parse_real(const char* s, const char* end, bool is_float,
+        double* value) {
+    const char* start = s;
+    bool negative = false;
+    if (s < end && (*s == '+' || *s == '-')) {
+        negative = *s++ == '-';
+    }
+    uint64_t mantissa = 0;
+    int digits = 0;
+    int64_t exponent = 0;
+    bool any_digit = false, truncated = false, fraction = false;
+    for (; s < end; s++) {
+        if (*s == '.' && !fraction) {
+            fraction = true;
+            continue;
+        }
+        if (!isdigit((unsigned char)*s)) {
+            break;
+        }
+        any_digit = true;
+        int d = *s - '0';
+        if (digits < 19) {
+            if (mantissa != 0 || d != 0) {
+                mantissa = 10 * mantissa + d;
+                digits++;
+            }
+            if (fraction) {
+                exponent--;
+            }
+        } else {
+            truncated = truncated || d != 0;
+            if (!fraction) {
+                exponent++;
+            }
+        }
+    }
+    const char* exponent_start = s;
+    if (!any_digit) {
+        // Inf, Infinity or NaN
+        char buffer[32];
+        size_t len = end - start;
+        if (len == 0 || len >= sizeof(buffer)) {
+            return false;
+        }
+        memcpy(buffer, start, len);
+        buffer[len] = '\0';
+        char* parse_end;
+        *value = strtod(buffer, &parse_end);
+        return *parse_end == '\0' && (isinf(*value) || isnan(*value));
+    }
+    if (s < end) {
+        if (strchr("eEdDqQ", *s) != NULL) {
+            s++;
+        } else if (*s != '+' && *s != '-') {
+            return false;
+        }
+        int64_t e;
+        if (!list_read_parse_int(s, end, &e)) {
+            return false;
+        }
+        // Saturate, the value overflows or underflows long before
+        exponent += e > 100000 ? 100000 : (e < -100000 ? -100000 : e);
+    }
+
+#if FLT_EVAL_METHOD == 0
+    if (!truncated && mantissa == 0) {
+        *value = negative ? -0.0 : 0.0;
+        return true;
+    }
+    if (!truncated && (is_float ? mantissa <= (1ull << 24) && exponent >= -10
+            && exponent <= 10 : mantissa <= (1ull << 53) && exponent >= -22
+            && exponent <= 22)) {
+        // For floats the result of the double operation is rounded again,
+        // which is still correct as a double has more than twice the bits
+        double v = (double)mantissa;
+        v = exponent < 0 ? v / list_read_powers_of_ten[-exponent]
+            : v * list_read_powers_of_ten[exponent];
+        *value = negative ? -v : v;
+        return true;
     }
+#endif
 
-    if (unit_file_bin) {
-        (void)!fread(p, sizeof(int8_t), array_size, filep);
+    // Translate the exponent to C syntax
+    size_t len = end - start;
+    char* buffer = (char*)malloc(len + 2);
+    size_t mantissa_len = exponent_start - start;
+    memcpy(buffer, start, mantissa_len);
+    size_t n = mantissa_len;
+    if (exponent_start < end) {
+        buffer[n++] = 'e';
+        const char* p = exponent_start;
+        if (strchr("eEdDqQ", *p) != NULL) {
+            p++;
+        }
+        memcpy(buffer + n, p, end - p);
+        n += end - p;
+    }
+    buffer[n] = '\0';
+    if (is_float) {
+        *value = strtof(buffer, NULL);
     } else {
-        for (int i = 0; i < array_size; i++) {
-            (void)!fscanf(filep, "%s", &p[i]);
+        *value = strtod(buffer, NULL);
+    }
+    free(buffer);
+    return true;
+}
+
+// Converts `token` to a value of `type` stored at `p`
+static bool list_read_convert(const char* token, enum list_read_type type, void* p) {
+    const char* end = token + strlen(token);
+    switch (type) {
+        case list_read_int8:
+        case list_read_int16:
+        case list_read_int32:
+        case list_read_int64: {
+            int64_t v;
+            if (!list_read_parse_int(token, end, &v)) {
+                return false;
+            }
+            if (type == list_read_int8) {
+                if (v < INT8_MIN || v > INT8_MAX) return false;
+                *(int8_t*)p = (int8_t)v;
+            } else if (type == list_read_int16) {
+                if (v < INT16_MIN || v > INT16_MAX) return false;
+                *(int16_t*)p = (int16_t)v;
+            } else if (type == list_read_int32) {
+                if (v < INT32_MIN || v > INT32_MAX) return false;
+                *(int32_t*)p = (int32_t)v;
+            } else {
+                *(int64_t*)p = v;
+            }
+            return true;
+        }
+        case list_read_real32:
+        case list_read_real64: {
+            double v;
+            if (!list_read_parse_real(token, end, type == list_read_real32, &v)) {
+                return false;
+            }
+            if (type == list_read_real32) {
+                *(float*)p = (float)v;
+            } else {
+                *(double*)p = v;
+            }
+            return true;
+        }
+        default: {
+            // (re, im), with optional blanks around the parts
+            if (*token != '(' || end[-1] != ')') {
+                return false;
+            }
+            const char* comma = strchr(token, ',');
+            if (comma == NULL) {
+                return false;
+            }
+            const char* parts[2][2] = {{token + 1, comma}, {comma + 1, end - 1}};
+            double v[2];
+            for (int i = 0; i < 2; i++) {
+                const char* s = parts[i][0];
+                const char* e = parts[i][1];
+                while (s < e && (*s == ' ' || *s == '\t')) s++;
+                while (e > s && (e[-1] == ' ' || e[-1] == '\t')) e--;
+                if (!list_read_parse_real(s, e, type == list_read_complex32, &v[i])) {
+                    return false;
+                }
+            }
+            if (type == list_read_complex32) {
+                ((float*)p)[0] = (float)v[0];
+                ((float*)p)[1] = (float)v[1];
+            } else {
+                ((double*)p)[0] = v[0];
+                ((double*)p)[1] = v[1];
+            }
+            return true;
         }
     }
 }
 
-LFORTRAN_API void _lfortran_read_array_int32(int32_t *p, int array_size, int32_t unit_num)
-{
+// Reads `n` consecutive items of `type` to `p`
+static void list_read(int32_t unit_num, enum list_read_type type, void* p,
+        int64_t n) {
+    FILE* fp;
+    struct list_read_state* r;
     if (unit_num == -1) {
         // Read from stdin
-        for (int i = 0; i < array_size; i++) {
-            (void)!scanf("%d", &p[i]);
+        _lfortran_flush_before_read();
+        fp = stdin;
+        r = &stdin_list_read;
+    } else {
+        struct UNIT_FILE* u = get_unit(unit_num);
+        if (!u) {
+            printf("No file found with given unit\n");
+            exit(1);
+        }
+        if (u->unit_file_bin) {
+            (void)!fread(p, list_read_type_size(type), n, u->filep);
+            return;
+        }
+        fp = u->filep;
+        r = &u->list_read;
+    }
+    size_t size = list_read_type_size(type);
+    bool eof = false;
+    list_read_lock(fp);
+    for (int64_t i = 0; i < n && !eof; i++) {
+        if (list_read_next(fp, r, &eof) &&
+                !list_read_convert(r->token, type, (char*)p + i * size)) {
+            list_read_unlock(fp);
+            printf("Runtime error: Bad %s value `%s` in list-directed input\n",
+                list_read_type_name(type), r->token);
+            exit(1);
         }
-        return;
     }
+    list_read_unlock(fp);
+}
 
-    bool unit_file_bin;
-    FILE* filep = get_file_pointer_from_unit(unit_num, &unit_file_bin);
-    if (!filep) {
-        printf("No file found with given unit\n");
-        exit(1);
-    }
+// Ends the list-directed read statement in progress
+static void list_read_end(struct list_read_state* r) {
+    r->repeat = 0;
+    r->slash = false;
+    r->blank_separator = false;
+}
 
-    if (unit_file_bin) {
-        (void)!fread(p, sizeof(int32_t), array_size, filep);
-    } else {
-        for (int i = 0; i < array_size; i++) {
-            (void)!fscanf(filep, "%d", &p[i]);
-        }
-    }
+LFORTRAN_API void _lfortran_read_int8(int8_t *p, int32_t unit_num)
+{
+    list_read(unit_num, list_read_int8, p, 1);
+}
+
+LFORTRAN_API void _lfortran_read_int16(int16_t *p, int32_t unit_num)
+{
+    list_read(unit_num, list_read_int16, p, 1);
+}
+
+LFORTRAN_API void _lfortran_read_int32(int32_t *p, int32_t unit_num)
+{
+    list_read(unit_num, list_read_int32, p, 1);
+}
+
+LFORTRAN_API void _lfortran_read_int64(int64_t *p, int32_t unit_num)
+{
+    list_read(unit_num, list_read_int64, p, 1);
+}
+
+LFORTRAN_API void _lfortran_read_array_int8(int8_t *p, int array_size, int32_t unit_num)
+{
+    list_read(unit_num, list_read_int8, p, array_size);
+}
+
+LFORTRAN_API void _lfortran_read_array_int16(int16_t *p, int array_size, int32_t unit_num)
+{
+    list_read(unit_num, list_read_int16, p, array_size);
+}
+
+LFORTRAN_API void _lfortran_read_array_int32(int32_t *p, int array_size, int32_t unit_num)
+{
+    list_read(unit_num, list_read_int32, p, array_size);
 }
 
+LFORTRAN_API void _lfortran_read_array_int64(int64_t *p, int array_size, int32_t unit_num)
+{
+    list_read(unit_num, list_read_int64, p, array_size);
+}
+
+LFORTRAN_API void _lfortran_read_float(float *p, int32_t unit_num)
+{
+    list_read(unit_num, list_read_real32, p, 1);
+}
+
+LFORTRAN_API void _lfortran_read_double(double *p, int32_t unit_num)
+{
+    list_read(unit_num, list_read_real64, p, 1);
+}
+
+LFORTRAN_API void _lfortran_read_array_float(float *p, int array_size, int32_t unit_num)
+{
+    list_read(unit_num, list_read_real32, p, array_size);
+}
+
+LFORTRAN_API void _lfortran_read_array_double(double *p, int array_size, int32_t unit_num)
+{
+    list_read(unit_num, list_read_real64, p, array_size);
+}
+
+LFORTRAN_API void _lfortran_read_complex_float(struct _lfortran_complex_32 *p, int32_t unit_num)
+{
+    list_read(unit_num, list_read_complex32, p, 1);
+}
+
+LFORTRAN_API void _lfortran_read_complex_double(struct _lfortran_complex_64 *p, int32_t unit_num)
+{
+    list_read(unit_num, list_read_complex64, p, 1);
+}
+
+LFORTRAN_API void _lfortran_read_array_complex_float(struct _lfortran_complex_32 *p, int array_size, int32_t unit_num)
+{
+    list_read(unit_num, list_read_complex32, p, array_size);
+}
+
+LFORTRAN_API void _lfortran_read_array_complex_double(struct _lfortran_complex_64 *p, int array_size, int32_t unit_num)
+{
+    list_read(unit_num, list_read_complex64, p, array_size);
+}
+
+// << List-directed input << --------------------------------------------------
+
 LFORTRAN_API void _lfortran_read_char(char **p, int32_t unit_num)
 {
     const char SPACE = ' ';
     int n = strlen(*p);
     if (unit_num == -1) {
         // Read from stdin
+        _lfortran_flush_before_read();
         *p = (char*)malloc(n * sizeof(char));
         (void)!fgets(*p, n + 1, stdin);
         (*p)[strcspn(*p, "\n")] = 0;
@@ -2599,84 +4337,11 @@ LFORTRAN_API void _lfortran_read_char(char **p, int32_t unit_num)
     }
 }
 
-LFORTRAN_API void _lfortran_read_float(float *p, int32_t unit_num)
-{
-    if (unit_num == -1) {
-        // Read from stdin
-        (void)!scanf("%f", p);
-        return;
-    }
-
-    bool unit_file_bin;
-    FILE* filep = get_file_pointer_from_unit(unit_num, &unit_file_bin);
-    if (!filep) {
-        printf("No file found with given unit\n");
-        exit(1);
-    }
-
-    if (unit_file_bin) {
-        (void)!fread(p, sizeof(*p), 1, filep);
-    } else {
-        (void)!fscanf(filep, "%f", p);
-    }
-}
-
-LFORTRAN_API void _lfortran_read_array_float(float *p, int array_size, int32_t unit_num)
-{
-    if (unit_num == -1) {
-        // Read from stdin
-        for (int i = 0; i < array_size; i++) {
-            (void)!scanf("%f", &p[i]);
-        }
-        return;
-    }
-
-    bool unit_file_bin;
-    FILE* filep = get_file_pointer_from_unit(unit_num, &unit_file_bin);
-    if (!filep) {
-        printf("No file found with given unit\n");
-        exit(1);
-    }
-
-    if (unit_file_bin) {
-        (void)!fread(p, sizeof(float), array_size, filep);
-    } else {
-        for (int i = 0; i < array_size; i++) {
-            (void)!fscanf(filep, "%f", &p[i]);
-        }
-    }
-}
-
-LFORTRAN_API void _lfortran_read_array_double(double *p, int array_size, int32_t unit_num)
-{
-    if (unit_num == -1) {
-        // Read from stdin
-        for (int i = 0; i < array_size; i++) {
-            (void)!scanf("%lf", &p[i]);
-        }
-        return;
-    }
-
-    bool unit_file_bin;
-    FILE* filep = get_file_pointer_from_unit(unit_num, &unit_file_bin);
-    if (!filep) {
-        printf("No file found with given unit\n");
-        exit(1);
-    }
-
-    if (unit_file_bin) {
-        (void)!fread(p, sizeof(double), array_size, filep);
-    } else {
-        for (int i = 0; i < array_size; i++) {
-            (void)!fscanf(filep, "%lf", &p[i]);
-        }
-    }
-}
-
 LFORTRAN_API void _lfortran_read_array_char(char **p, int array_size, int32_t unit_num)
 {
     if (unit_num == -1) {
         // Read from stdin
+        _lfortran_flush_before_read();
         for (int i = 0; i < array_size; i++) {
             int n = 1; // TODO: Support character length > 1
             p[i] = (char*) malloc(n * sizeof(char));
@@ -2703,28 +4368,6 @@ LFORTRAN_API void _lfortran_read_array_char(char **p, int array_size, int32_t un
     }
 }
 
-LFORTRAN_API void _lfortran_read_double(double *p, int32_t unit_num)
-{
-    if (unit_num == -1) {
-        // Read from stdin
-        (void)!scanf("%lf", p);
-        return;
-    }
-
-    bool unit_file_bin;
-    FILE* filep = get_file_pointer_from_unit(unit_num, &unit_file_bin);
-    if (!filep) {
-        printf("No file found with given unit\n");
-        exit(1);
-    }
-
-    if (unit_file_bin) {
-        (void)!fread(p, sizeof(*p), 1, filep);
-    } else {
-        (void)!fscanf(filep, "%lf", p);
-    }
-}
-
 LFORTRAN_API void _lfortran_formatted_read(int32_t unit_num, int32_t* iostat, int32_t* chunk, char* fmt, int32_t no_of_args, ...)
 {
     if (!streql(fmt, "(a)")) {
@@ -2744,20 +4387,20 @@ LFORTRAN_API void _lfortran_formatted_read(int32_t unit_num, int32_t* iostat, in
 
     if (unit_num == -1) {
         // Read from stdin
+        _lfortran_flush_before_read();
         *iostat = !(fgets(*arg, n, stdin) == *arg);
         (*arg)[strcspn(*arg, "\n")] = 0;
         va_end(args);
         return;
     }
 
-    bool unit_file_bin;
-    FILE* filep = get_file_pointer_from_unit(unit_num, &unit_file_bin);
-    if (!filep) {
+    struct UNIT_FILE* u = get_unit(unit_num);
+    if (!u) {
         printf("No file found with given unit\n");
         exit(1);
     }
 
-    *iostat = !(fgets(*arg, n+1, filep) == *arg);
+    *iostat = !(fgets(*arg, n+1, u->filep) == *arg);
     if (streql(*arg, "\n")) {
         *iostat = -2;
     }
@@ -2770,17 +4413,20 @@ LFORTRAN_API void _lfortran_formatted_read(int32_t unit_num, int32_t* iostat, in
 LFORTRAN_API void _lfortran_empty_read(int32_t unit_num, int32_t* iostat) {
     if (unit_num == -1) {
         // Read from stdin
+        _lfortran_flush_before_read();
+        list_read_end(&stdin_list_read);
         return;
     }
 
-    bool unit_file_bin;
-    FILE* fp = get_file_pointer_from_unit(unit_num, &unit_file_bin);
-    if (!fp) {
+    struct UNIT_FILE* u = get_unit(unit_num);
+    if (!u) {
         printf("No file found with given unit\n");
         exit(1);
     }
+    list_read_end(&u->list_read);
 
-    if (!unit_file_bin) {
+    if (!u->unit_file_bin) {
+        FILE* fp = u->filep;
         // The contents of `c` are ignored
         char c = fgetc(fp);
         while (c != '\n' && c != EOF) {
@@ -2812,10 +4458,12 @@ LFORTRAN_API char* _lpython_read(int64_t fd, int64_t n)
 
 LFORTRAN_API void _lfortran_file_write(int32_t unit_num, int32_t* iostat, const char *format, ...)
 {
-    bool unit_file_bin;
-    FILE* filep = get_file_pointer_from_unit(unit_num, &unit_file_bin);
-    if (!filep) {
-        filep = stdout;
+    struct UNIT_FILE* u = get_unit(unit_num);
+    FILE* filep = stdout;
+    bool unit_file_bin = false;
+    if (u != NULL) {
+        filep = u->filep;
+        unit_file_bin = u->unit_file_bin;
     }
     if (unit_file_bin) {
         va_list args;
@@ -2855,9 +4503,848 @@ LFORTRAN_API void _lfortran_file_write(int32_t unit_num, int32_t* iostat, const
         va_end(args);
         *iostat = 0;
     }
-    (void)!ftruncate(fileno(filep), ftell(filep));
+    if (_lfortran_unbuffered_io) {
+        fflush(filep);
+    }
+    if (u != NULL && u->end_file_on_write && u->access == unit_access_sequential) {
+        // The first write after positioning the unit ends the file, later
+        // ones append to it
+        (void)!ftruncate(fileno(filep), ftell(filep));
+        u->end_file_on_write = false;
+    }
+}
+
+// >> Unformatted I/O >> -------------------------------------------------------
+
+// Records longer than this are split into subrecords, like gfortran does
+#define LFORTRAN_MAX_SUBRECORD_LENGTH 2147483639
+
+// Status of a failed unformatted transfer other than the end of the file
+#define LFORTRAN_IOSTAT_UNFORMATTED_ERROR 5000
+
+struct unformatted_item {
+    int32_t rank;
+    int64_t size; // Element size, 0 for character data
+    // Bytes per element in the record. Differs from `size` only for
+    // logicals, which are stored in 1 byte but take the bytes of their kind
+    // (4 by default), like in gfortran's files. For a character scalar its
+    // declared length, or -1 for the length of the string (assumed length).
+    int64_t record_size;
+    char* data;
+    int32_t offset;
+    struct _lfortran_dimension_descriptor* dims;
+};
+
+static void unformatted_items_read(va_list* args, int32_t n_items,
+        struct unformatted_item* items) {
+    for (int32_t i = 0; i < n_items; i++) {
+        struct unformatted_item* item = &items[i];
+        item->rank = va_arg(*args, int32_t);
+        item->size = va_arg(*args, int64_t);
+        item->record_size = va_arg(*args, int64_t);
+        item->data = va_arg(*args, char*);
+        if (item->rank > 0) {
+            item->offset = va_arg(*args, int32_t);
+            item->dims = va_arg(*args, struct _lfortran_dimension_descriptor*);
+        } else {
+            item->offset = 0;
+            item->dims = NULL;
+        }
+    }
+}
+
+/*
+Calls `fn` for every run of consecutive elements of `item` in memory, in
+array element order: once for a contiguous array, once per column if only
+the first dimension is contiguous, and once per element otherwise.
+*/
+static bool unformatted_item_for_each_run(struct unformatted_item* item,
+        bool (*fn)(void* state, char* p, int64_t n), void* state) {
+    if (item->rank == 0) {
+        return fn(state, item->data, 1);
+    }
+    int64_t n = 1;
+    bool contiguous = true;
+    int64_t expected_stride = 1;
+    for (int32_t k = 0; k < item->rank; k++) {
+        if (item->dims[k].size <= 0) {
+            // Empty array or array section
+            return true;
+        }
+        n *= item->dims[k].size;
+        if (item->dims[k].size > 1 && item->dims[k].stride != expected_stride) {
+            contiguous = false;
+        }
+        expected_stride *= item->dims[k].size;
+    }
+    int64_t el_size = item->size == 0 ? (int64_t)sizeof(char*) : item->size;
+    char* base = item->data + item->offset * el_size;
+    if (contiguous) {
+        return fn(state, base, n);
+    }
+    int64_t run = item->dims[0].stride == 1 ? item->dims[0].size : 1;
+    int32_t first_dim = run > 1 ? 1 : 0;
+    int64_t index[32] = {0};
+    if (item->rank > 32) {
+        printf("Runtime error: arrays of rank %d are not supported in "
+            "unformatted I/O\n", item->rank);
+        exit(1);
+    }
+    while (1) {
+        int64_t pos = 0;
+        for (int32_t k = first_dim; k < item->rank; k++) {
+            pos += index[k] * item->dims[k].stride;
+        }
+        if (!fn(state, base + pos * el_size, run)) {
+            return false;
+        }
+        // Next run, in column major order
+        int32_t k = first_dim;
+        while (k < item->rank && ++index[k] == item->dims[k].size) {
+            index[k] = 0;
+            k++;
+        }
+        if (k == item->rank) {
+            return true;
+        }
+    }
+}
+
+static bool unformatted_count_run(void* state, char* p, int64_t n) {
+    (*(int64_t*)state) += n;
+    (void)p;
+    return true;
+}
+
+static bool unformatted_count_strings(void* state, char* p, int64_t n) {
+    char** strings = (char**)p;
+    for (int64_t i = 0; i < n; i++) {
+        (*(int64_t*)state) += strlen(strings[i]);
+    }
+    return true;
+}
+
+// Length of the character scalar `item`
+static int64_t unformatted_string_length(struct unformatted_item* item) {
+    return item->record_size >= 0 ? item->record_size
+        : (int64_t)strlen(item->data);
+}
+
+// Number of bytes that `item` occupies in a record
+static int64_t unformatted_item_length(struct unformatted_item* item) {
+    if (item->size == 0 && item->rank == 0) {
+        return unformatted_string_length(item);
+    }
+    int64_t n = 0;
+    unformatted_item_for_each_run(item, item->size == 0 ?
+        unformatted_count_strings : unformatted_count_run, &n);
+    return item->size == 0 ? n : n * item->record_size;
+}
+
+/*
+A record being transferred. On units with sequential access each
+(sub)record is enclosed by 4 byte markers with its length: the leading
+marker is negative if the record continues in another subrecord, the
+trailing one if the subrecord continues a previous one.
+*/
+struct unformatted_record {
+    FILE* filep;
+    bool markers;
+    int64_t element_size;     // Of the item being transferred
+    int64_t record_element_size; // Bytes per element in the record
+    int64_t record_left;      // Bytes left in the record, when writing
+    int64_t subrecord_left;   // Bytes left in the current subrecord
+    int32_t subrecord_length;
+    bool continued;           // More subrecords follow the current one
+    bool continuation;        // The current subrecord continues a record
+    bool eof;
+    bool error;
+};
+
+static void unformatted_write_marker(struct unformatted_record* r, int32_t marker) {
+    if (fwrite(&marker, sizeof(marker), 1, r->filep) != 1) {
+        r->error = true;
+    }
+}
+
+static void unformatted_begin_write_subrecord(struct unformatted_record* r) {
+    int64_t length = r->record_left;
+    if (length > LFORTRAN_MAX_SUBRECORD_LENGTH) {
+        length = LFORTRAN_MAX_SUBRECORD_LENGTH;
+    }
+    r->subrecord_length = length;
+    r->subrecord_left = length;
+    r->continued = r->record_left > length;
+    unformatted_write_marker(r, r->continued ? -(int32_t)length : (int32_t)length);
+}
+
+static void unformatted_end_write_subrecord(struct unformatted_record* r) {
+    unformatted_write_marker(r, r->continuation ? -r->subrecord_length
+        : r->subrecord_length);
+    r->continuation = true;
+}
+
+static bool unformatted_write_bytes(struct unformatted_record* r,
+        const char* p, int64_t n) {
+    while (n > 0 && !r->error) {
+        int64_t chunk = n;
+        if (r->markers && chunk > r->subrecord_left) {
+            chunk = r->subrecord_left;
+        }
+        if (fwrite(p, 1, chunk, r->filep) != (size_t)chunk) {
+            r->error = true;
+        }
+        p += chunk;
+        n -= chunk;
+        if (r->markers) {
+            r->subrecord_left -= chunk;
+            r->record_left -= chunk;
+            if (r->subrecord_left == 0 && r->record_left > 0) {
+                unformatted_end_write_subrecord(r);
+                unformatted_begin_write_subrecord(r);
+            }
+        }
+    }
+    return !r->error;
+}
+
+// Writes the string `p` padded with blanks to `len` characters
+static bool unformatted_write_string(struct unformatted_record* r,
+        const char* p, int64_t len) {
+    int64_t n = strnlen(p, len);
+    unformatted_write_bytes(r, p, n);
+    char blanks[64];
+    memset(blanks, ' ', sizeof(blanks));
+    for (; n < len && !r->error; n += sizeof(blanks)) {
+        int64_t chunk = len - n;
+        unformatted_write_bytes(r, blanks,
+            chunk < (int64_t)sizeof(blanks) ? chunk : (int64_t)sizeof(blanks));
+    }
+    return !r->error;
+}
+
+static bool unformatted_write_run(void* state, char* p, int64_t n) {
+    struct unformatted_record* r = (struct unformatted_record*)state;
+    if (r->element_size == 0) {
+        char** strings = (char**)p;
+        for (int64_t i = 0; i < n; i++) {
+            if (!unformatted_write_bytes(r, strings[i], strlen(strings[i]))) {
+                return false;
+            }
+        }
+        return true;
+    }
+    if (r->record_element_size != r->element_size) {
+        // Logicals, written as integers of their kind with the value 0 or 1
+        for (int64_t i = 0; i < n; i++) {
+            int64_t value = p[i] != 0;
+            char bytes[8];
+            if (r->record_element_size == 1) {
+                int8_t v = value; memcpy(bytes, &v, 1);
+            } else if (r->record_element_size == 2) {
+                int16_t v = value; memcpy(bytes, &v, 2);
+            } else if (r->record_element_size == 4) {
+                int32_t v = value; memcpy(bytes, &v, 4);
+            } else {
+                memcpy(bytes, &value, 8);
+            }
+            if (!unformatted_write_bytes(r, bytes, r->record_element_size)) {
+                return false;
+            }
+        }
+        return true;
+    }
+    return unformatted_write_bytes(r, p, n * r->element_size);
+}
+
+static bool unformatted_read_marker(struct unformatted_record* r, int32_t* marker) {
+    if (fread(marker, sizeof(*marker), 1, r->filep) != 1) {
+        if (feof(r->filep)) {
+            r->eof = true;
+        } else {
+            r->error = true;
+        }
+        return false;
+    }
+    return true;
+}
+
+static bool unformatted_begin_read_subrecord(struct unformatted_record* r) {
+    int32_t marker;
+    if (!unformatted_read_marker(r, &marker)) {
+        return false;
+    }
+    r->continued = marker < 0;
+    r->subrecord_length = marker < 0 ? -marker : marker;
+    r->subrecord_left = r->subrecord_length;
+    return true;
+}
+
+static bool unformatted_end_read_subrecord(struct unformatted_record* r) {
+    int32_t marker;
+    if (!unformatted_read_marker(r, &marker)) {
+        // The record was started, so a missing marker is an error
+        r->eof = false;
+        r->error = true;
+        return false;
+    }
+    if ((marker < 0 ? -marker : marker) != r->subrecord_length) {
+        r->error = true;
+        return false;
+    }
+    return true;
+}
+
+static bool unformatted_read_bytes(struct unformatted_record* r, char* p, int64_t n) {
+    while (n > 0) {
+        int64_t chunk = n;
+        if (r->markers) {
+            if (r->subrecord_left == 0) {
+                if (!r->continued) {
+                    // The I/O list is longer than the record, which is
+                    // skipped like on other errors
+                    unformatted_end_read_subrecord(r);
+                    r->error = true;
+                    return false;
+                }
+                if (!unformatted_end_read_subrecord(r) ||
+                        !unformatted_begin_read_subrecord(r)) {
+                    r->eof = false;
+                    r->error = true;
+                    return false;
+                }
+                continue;
+            }
+            if (chunk > r->subrecord_left) {
+                chunk = r->subrecord_left;
+            }
+        }
+        if (fread(p, 1, chunk, r->filep) != (size_t)chunk) {
+            if (feof(r->filep) && !r->markers) {
+                r->eof = true;
+            } else {
+                r->error = true;
+            }
+            return false;
+        }
+        p += chunk;
+        n -= chunk;
+        r->subrecord_left -= chunk;
+    }
+    return true;
+}
+
+static bool unformatted_read_run(void* state, char* p, int64_t n) {
+    struct unformatted_record* r = (struct unformatted_record*)state;
+    if (r->element_size == 0) {
+        char** strings = (char**)p;
+        for (int64_t i = 0; i < n; i++) {
+            if (!unformatted_read_bytes(r, strings[i], strlen(strings[i]))) {
+                return false;
+            }
+        }
+        return true;
+    }
+    if (r->record_element_size != r->element_size) {
+        // Logicals, any nonzero value is true
+        for (int64_t i = 0; i < n; i++) {
+            char bytes[8];
+            if (!unformatted_read_bytes(r, bytes, r->record_element_size)) {
+                return false;
+            }
+            bool value = false;
+            for (int64_t k = 0; k < r->record_element_size; k++) {
+                value = value || bytes[k] != 0;
+            }
+            p[i] = value;
+        }
+        return true;
+    }
+    return unformatted_read_bytes(r, p, n * r->element_size);
+}
+
+// Skips what the I/O list did not read of the current record
+static bool unformatted_skip_record(struct unformatted_record* r) {
+    while (1) {
+        if (r->subrecord_left > 0 &&
+                fseek(r->filep, r->subrecord_left, SEEK_CUR) != 0) {
+            r->error = true;
+            return false;
+        }
+        r->subrecord_left = 0;
+        if (!unformatted_end_read_subrecord(r)) {
+            return false;
+        }
+        if (!r->continued) {
+            return true;
+        }
+        if (!unformatted_begin_read_subrecord(r)) {
+            r->eof = false;
+            r->error = true;
+            return false;
+        }
+    }
+}
+
+static void unformatted_check_unit(struct UNIT_FILE* u, int32_t unit_num,
+        const char* statement) {
+    if (u == NULL) {
+        printf("Runtime error: unit %d in unformatted %s is not connected\n",
+            unit_num, statement);
+        exit(1);
+    }
+    if (!u->unit_file_bin) {
+        printf("Runtime error: unformatted %s on unit %d, which is connected "
+            "for formatted I/O\n", statement, unit_num);
+        exit(1);
+    }
+}
+
+static struct UNIT_FILE* unformatted_unit(int32_t unit_num, const char* statement) {
+    struct UNIT_FILE* u = get_unit(unit_num);
+    unformatted_check_unit(u, unit_num, statement);
+    return u;
+}
+
+static int32_t unformatted_status(struct unformatted_record* r) {
+    if (r->eof) {
+        return -1;
+    } else if (r->error) {
+        return LFORTRAN_IOSTAT_UNFORMATTED_ERROR;
+    }
+    return 0;
+}
+
+// Whether the next write on `u` ends the file, see `end_file_on_write`
+static bool unformatted_end_file(struct UNIT_FILE* u) {
+    bool end_file = u->end_file_on_write && u->access == unit_access_sequential;
+    if (end_file) {
+        u->end_file_on_write = false;
+    }
+    return end_file;
+}
+
+static void unformatted_set_iostat(struct UNIT_FILE* u, int32_t* iostat,
+        struct unformatted_record* r, const char* statement) {
+    int32_t status = unformatted_status(r);
+    if (iostat != NULL) {
+        *iostat = status;
+    } else if (status != 0) {
+        printf("Runtime error: %s in unformatted %s on unit %d\n",
+            r->eof ? "End of file" : "I/O error", statement, u->unit);
+        exit(1);
+    }
+}
+
+// Writes `items` as one record, and ends the file after it if `end_file`.
+// Only uses `filep`, not the unit table, as it also runs on the thread doing
+// asynchronous transfers
+static void unformatted_write_items(FILE* filep, enum unit_access access,
+        bool end_file, int32_t n_items, struct unformatted_item* items,
+        struct unformatted_record* r) {
+    memset(r, 0, sizeof(*r));
+    r->filep = filep;
+    r->markers = access == unit_access_sequential;
+    if (r->markers) {
+        // The length of the record comes first, so it is computed upfront
+        for (int32_t i = 0; i < n_items; i++) {
+            r->record_left += unformatted_item_length(&items[i]);
+        }
+        unformatted_begin_write_subrecord(r);
+    }
+    for (int32_t i = 0; i < n_items && !r->error; i++) {
+        r->element_size = items[i].size;
+        r->record_element_size = items[i].record_size;
+        if (items[i].size == 0 && items[i].rank == 0) {
+            unformatted_write_string(r, items[i].data,
+                unformatted_string_length(&items[i]));
+        } else {
+            unformatted_item_for_each_run(&items[i], unformatted_write_run, r);
+        }
+    }
+    if (r->markers && !r->error) {
+        unformatted_end_write_subrecord(r);
+    }
+    if (_lfortran_unbuffered_io) {
+        fflush(filep);
+    }
+    if (end_file) {
+        (void)!ftruncate(fileno(filep), ftell(filep));
+    }
+}
+
+// Reads one record into `items`, like `unformatted_write_items`
+static void unformatted_read_items(FILE* filep, enum unit_access access,
+        int32_t n_items, struct unformatted_item* items,
+        struct unformatted_record* r) {
+    memset(r, 0, sizeof(*r));
+    r->filep = filep;
+    r->markers = access == unit_access_sequential;
+    bool ok = !r->markers || unformatted_begin_read_subrecord(r);
+    for (int32_t i = 0; i < n_items && ok; i++) {
+        r->element_size = items[i].size;
+        r->record_element_size = items[i].record_size;
+        if (items[i].size == 0 && items[i].rank == 0) {
+            ok = unformatted_read_bytes(r, items[i].data,
+                unformatted_string_length(&items[i]));
+        } else {
+            ok = unformatted_item_for_each_run(&items[i], unformatted_read_run, r);
+        }
+    }
+    if (ok && r->markers) {
+        unformatted_skip_record(r);
+    }
+}
+
+LFORTRAN_API void _lfortran_unformatted_write(int32_t unit_num, int32_t* iostat, int32_t n_items, ...)
+{
+    struct UNIT_FILE* u = unformatted_unit(unit_num, "WRITE");
+    struct unformatted_item items_buffer[16];
+    struct unformatted_item* items = n_items > 16 ? (struct unformatted_item*)
+        malloc(n_items * sizeof(struct unformatted_item)) : items_buffer;
+    va_list args;
+    va_start(args, n_items);
+    unformatted_items_read(&args, n_items, items);
+    va_end(args);
+
+    struct unformatted_record r;
+    unformatted_write_items(u->filep, u->access, unformatted_end_file(u),
+        n_items, items, &r);
+    if (items != items_buffer) {
+        free(items);
+    }
+    unformatted_set_iostat(u, iostat, &r, "WRITE");
+}
+
+LFORTRAN_API void _lfortran_unformatted_read(int32_t unit_num, int32_t* iostat, int32_t n_items, ...)
+{
+    struct UNIT_FILE* u = unformatted_unit(unit_num, "READ");
+    struct unformatted_item items_buffer[16];
+    struct unformatted_item* items = n_items > 16 ? (struct unformatted_item*)
+        malloc(n_items * sizeof(struct unformatted_item)) : items_buffer;
+    va_list args;
+    va_start(args, n_items);
+    unformatted_items_read(&args, n_items, items);
+    va_end(args);
+
+    struct unformatted_record r;
+    unformatted_read_items(u->filep, u->access, n_items, items, &r);
+    if (items != items_buffer) {
+        free(items);
+    }
+    unformatted_set_iostat(u, iostat, &r, "READ");
+}
+
+// << Unformatted I/O << -------------------------------------------------------
+
+// >> Asynchronous I/O >> ------------------------------------------------------
+
+/*
+Unformatted transfers with ASYNCHRONOUS="yes" are queued and done in order
+by a single worker thread, so that the program continues while the data is
+written or read. The transfers of a unit get increasing ids; WAIT blocks
+until they completed, and so does any other statement on the unit, through
+`get_unit`. Errors of asynchronous transfers are reported by WAIT.
+
+The values of scalars written are copied when the transfer starts, arrays
+and the variables read must not be referenced until the transfer completed,
+as for any asynchronous transfer in Fortran. Without threads (Windows and
+WebAssembly) the transfers are done when they start.
+*/
+
+struct async_transfer {
+    struct async_unit* unit;
+    int32_t id;
+    bool read;
+    FILE* filep;
+    enum unit_access access;
+    bool end_file;
+    int32_t n_items;
+    struct unformatted_item* items; // Allocated with the transfer
+    struct async_transfer* next;
+};
+
+#ifdef LFORTRAN_ASYNC_IO_THREAD
+static pthread_mutex_t async_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t async_queued = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t async_completed = PTHREAD_COND_INITIALIZER;
+// The transfer at the head of the queue is being done by the worker
+static struct async_transfer* async_queue_head = NULL;
+static struct async_transfer* async_queue_tail = NULL;
+static enum {
+    async_worker_none, async_worker_running, async_worker_failed
+} async_worker_state = async_worker_none;
+#endif
+
+static void async_transfer_run(struct async_transfer* t,
+        struct unformatted_record* r) {
+    if (t->read) {
+        unformatted_read_items(t->filep, t->access, t->n_items, t->items, r);
+    } else {
+        unformatted_write_items(t->filep, t->access, t->end_file, t->n_items,
+            t->items, r);
+    }
+}
+
+// Records the completion of `t`; with the worker thread, `async_mutex` is
+// held by the caller
+static void async_transfer_complete(struct async_transfer* t,
+        struct unformatted_record* r) {
+    struct async_unit* a = t->unit;
+    int32_t status = unformatted_status(r);
+    a->completed_id = t->id;
+    if (status != 0 && a->error_id == 0) {
+        a->error_id = t->id;
+        a->error_status = status;
+        a->error_read = t->read;
+    }
+}
+
+#ifdef LFORTRAN_ASYNC_IO_THREAD
+static void* async_worker(void* arg) {
+    (void)arg;
+    pthread_mutex_lock(&async_mutex);
+    while (1) {
+        while (async_queue_head == NULL) {
+            pthread_cond_wait(&async_queued, &async_mutex);
+        }
+        struct async_transfer* t = async_queue_head;
+        pthread_mutex_unlock(&async_mutex);
+        struct unformatted_record r;
+        async_transfer_run(t, &r);
+        pthread_mutex_lock(&async_mutex);
+        async_queue_head = t->next;
+        if (async_queue_head == NULL) {
+            async_queue_tail = NULL;
+        }
+        async_transfer_complete(t, &r);
+        pthread_cond_broadcast(&async_completed);
+        free(t);
+    }
+    return NULL;
+}
+
+// Program termination closes the units, so the queued transfers are done
+static void async_wait_all(void) {
+    pthread_mutex_lock(&async_mutex);
+    while (async_queue_head != NULL) {
+        pthread_cond_wait(&async_completed, &async_mutex);
+    }
+    pthread_mutex_unlock(&async_mutex);
+}
+#endif
+
+static void async_transfer_start(struct async_transfer* t) {
+#ifdef LFORTRAN_ASYNC_IO_THREAD
+    if (async_worker_state == async_worker_none) {
+        pthread_t thread;
+        if (pthread_create(&thread, NULL, async_worker, NULL) == 0) {
+            pthread_detach(thread);
+            atexit(async_wait_all);
+            async_worker_state = async_worker_running;
+        } else {
+            async_worker_state = async_worker_failed;
+        }
+    }
+    if (async_worker_state == async_worker_running) {
+        t->next = NULL;
+        pthread_mutex_lock(&async_mutex);
+        if (async_queue_tail == NULL) {
+            async_queue_head = t;
+        } else {
+            async_queue_tail->next = t;
+        }
+        async_queue_tail = t;
+        pthread_cond_signal(&async_queued);
+        pthread_mutex_unlock(&async_mutex);
+        return;
+    }
+#endif
+    struct unformatted_record r;
+    async_transfer_run(t, &r);
+    async_transfer_complete(t, &r);
+    free(t);
+}
+
+// Waits until the transfers of the unit up to `id` completed
+static void async_unit_wait_id(struct async_unit* a, int32_t id) {
+#ifdef LFORTRAN_ASYNC_IO_THREAD
+    pthread_mutex_lock(&async_mutex);
+    while (a->completed_id < id) {
+        pthread_cond_wait(&async_completed, &async_mutex);
+    }
+    pthread_mutex_unlock(&async_mutex);
+#else
+    (void)a; (void)id;
+#endif
+}
+
+static void async_unit_wait(struct async_unit* a) {
+    async_unit_wait_id(a, a->last_id);
+}
+
+static inline size_t async_align(size_t n) {
+    return (n + 15) & ~(size_t)15;
+}
+
+static void unformatted_start_async(int32_t unit_num, int32_t* iostat,
+        int32_t* id, int32_t n_items, va_list* args, bool read) {
+    const char* statement = read ? "READ" : "WRITE";
+    struct UNIT_FILE* u = find_unit(unit_num);
+    unformatted_check_unit(u, unit_num, statement);
+    if (u->async == NULL) {
+        printf("Runtime error: asynchronous %s on unit %d, which is not "
+            "connected with ASYNCHRONOUS=\"yes\"\n", statement, unit_num);
+        exit(1);
+    }
+    struct unformatted_item items_buffer[16];
+    struct unformatted_item* items = n_items > 16 ? (struct unformatted_item*)
+        malloc(n_items * sizeof(struct unformatted_item)) : items_buffer;
+    unformatted_items_read(args, n_items, items);
+
+    // The transfer is allocated together with its items, their dimension
+    // descriptors, which may be temporaries, and the scalars written
+    size_t size = async_align(sizeof(struct async_transfer))
+        + async_align(n_items * sizeof(struct unformatted_item));
+    for (int32_t i = 0; i < n_items; i++) {
+        if (items[i].rank > 0) {
+            size += async_align(items[i].rank *
+                sizeof(struct _lfortran_dimension_descriptor));
+        } else if (!read) {
+            size += async_align(items[i].size == 0 ?
+                (size_t)unformatted_string_length(&items[i]) + 1
+                : (size_t)items[i].size);
+        }
+    }
+    char* p = (char*) malloc(size);
+    if (p == NULL) {
+        printf("Runtime error: Memory allocation failed for an asynchronous "
+            "%s on unit %d\n", statement, unit_num);
+        exit(1);
+    }
+    struct async_transfer* t = (struct async_transfer*) p;
+    p += async_align(sizeof(struct async_transfer));
+    t->items = (struct unformatted_item*) p;
+    p += async_align(n_items * sizeof(struct unformatted_item));
+    for (int32_t i = 0; i < n_items; i++) {
+        struct unformatted_item* item = &t->items[i];
+        *item = items[i];
+        if (item->rank > 0) {
+            size_t n = item->rank * sizeof(struct _lfortran_dimension_descriptor);
+            memcpy(p, items[i].dims, n);
+            item->dims = (struct _lfortran_dimension_descriptor*) p;
+            p += async_align(n);
+        } else if (!read && item->size == 0) {
+            // Padded to its length when written
+            int64_t len = unformatted_string_length(item);
+            size_t n = strnlen(items[i].data, len);
+            memcpy(p, items[i].data, n);
+            p[n] = '\0';
+            item->data = p;
+            item->record_size = len;
+            p += async_align(len + 1);
+        } else if (!read) {
+            memcpy(p, items[i].data, item->size);
+            item->data = p;
+            p += async_align(item->size);
+        }
+    }
+    if (items != items_buffer) {
+        free(items);
+    }
+    t->unit = u->async;
+    t->id = ++u->async->last_id;
+    t->read = read;
+    t->filep = u->filep;
+    t->access = u->access;
+    t->end_file = !read && unformatted_end_file(u);
+    t->n_items = n_items;
+    if (id != NULL) {
+        *id = t->id;
+    }
+    if (iostat != NULL) {
+        *iostat = 0;
+    }
+    async_transfer_start(t);
+}
+
+LFORTRAN_API void _lfortran_unformatted_write_async(int32_t unit_num, int32_t* iostat,
+    int32_t* id, int32_t n_items, ...)
+{
+    va_list args;
+    va_start(args, n_items);
+    unformatted_start_async(unit_num, iostat, id, n_items, &args, false);
+    va_end(args);
+}
+
+LFORTRAN_API void _lfortran_unformatted_read_async(int32_t unit_num, int32_t* iostat,
+    int32_t* id, int32_t n_items, ...)
+{
+    va_list args;
+    va_start(args, n_items);
+    unformatted_start_async(unit_num, iostat, id, n_items, &args, true);
+    va_end(args);
+}
+
+/*
+WAIT statement: waits for the transfer `id` of the unit, or for all its
+transfers if `id` is -1, and reports the first error among them. The id 0
+stands for a transfer that was done synchronously.
+*/
+LFORTRAN_API void _lfortran_wait(int32_t unit_num, int32_t id, int32_t* iostat)
+{
+    struct UNIT_FILE* u = find_unit(unit_num);
+    int32_t status = 0;
+    bool read = false;
+    if (id == 0) {
+        // Nothing to wait for
+    } else if (u == NULL || u->async == NULL) {
+        // Without ID= this is allowed and does nothing
+        if (id > 0) {
+            if (iostat == NULL) {
+                printf("Runtime error: WAIT with ID=%d on unit %d, which is "
+                    "not connected for asynchronous I/O\n", id, unit_num);
+                exit(1);
+            }
+            status = LFORTRAN_IOSTAT_UNFORMATTED_ERROR;
+        }
+    } else if (id > u->async->last_id) {
+        if (iostat == NULL) {
+            printf("Runtime error: WAIT with ID=%d on unit %d, which has no "
+                "such transfer\n", id, unit_num);
+            exit(1);
+        }
+        status = LFORTRAN_IOSTAT_UNFORMATTED_ERROR;
+    } else {
+        struct async_unit* a = u->async;
+        if (id < 0) {
+            id = a->last_id;
+        }
+        async_unit_wait_id(a, id);
+#ifdef LFORTRAN_ASYNC_IO_THREAD
+        pthread_mutex_lock(&async_mutex);
+#endif
+        if (a->error_id != 0 && a->error_id <= id) {
+            status = a->error_status;
+            read = a->error_read;
+            a->error_id = 0;
+        }
+#ifdef LFORTRAN_ASYNC_IO_THREAD
+        pthread_mutex_unlock(&async_mutex);
+#endif
+    }
+    if (iostat != NULL) {
+        *iostat = status;
+    } else if (status != 0) {
+        printf("Runtime error: %s in asynchronous %s on unit %d\n",
+            status == -1 ? "End of file" : "I/O error",
+            read ? "READ" : "WRITE", unit_num);
+        exit(1);
+    }
 }
 
+// << Asynchronous I/O << ------------------------------------------------------
+
 LFORTRAN_API void _lfortran_string_write(char **str, int32_t* iostat, const char *format, ...) {
     va_list args;
     va_start(args, format);
@@ -2884,13 +5371,19 @@ LFORTRAN_API void _lpython_close(int64_t fd)
 
 LFORTRAN_API void _lfortran_close(int32_t unit_num)
 {
-    bool unit_file_bin;
-    FILE* filep = get_file_pointer_from_unit(unit_num, &unit_file_bin);
-    if (!filep) {
+    struct UNIT_FILE* u = get_unit(unit_num);
+    if (!u) {
         printf("No file found with given unit\n");
         exit(1);
     }
-    if (fclose(filep) != 0) {
+    if (u->async != NULL && u->async->error_id != 0) {
+        // The failed asynchronous transfer was not waited for
+        printf("Runtime error: %s in asynchronous %s on unit %d\n",
+            u->async->error_status == -1 ? "End of file" : "I/O error",
+            u->async->error_read ? "READ" : "WRITE", unit_num);
+        exit(1);
+    }
+    if (fclose(u->filep) != 0) {
         printf("Error in closing the file!\n");
         exit(1);
     }
@@ -2931,6 +5424,7 @@ LFORTRAN_API char *_lpython_get_argv(int32_t index) {
 LFORTRAN_API void _lpython_call_initial_functions(int32_t argc_1, char *argv_1[]) {
     _lpython_set_argv(argc_1, argv_1);
     _lfortran_init_random_clock();
+    _lfortran_init_io();
 }
 // << Initial setup << ---------------------------------------------------------
 
@@ -66,7 +66,26 @@ typedef double _Complex double_complex_t;
 #endif
 
 LFORTRAN_API double _lfortran_sum(int n, double *v);
+LFORTRAN_API float _lfortran_sum_r4(int64_t n, float *v);
+LFORTRAN_API double _lfortran_sum_r8(int64_t n, double *v);
+LFORTRAN_API float _lfortran_sum_fast_r4(int64_t n, float *v);
+LFORTRAN_API double _lfortran_sum_fast_r8(int64_t n, double *v);
+LFORTRAN_API float _lfortran_product_r4(int64_t n, float *v);
+LFORTRAN_API double _lfortran_product_r8(int64_t n, double *v);
+LFORTRAN_API float _lfortran_maxval_r4(int64_t n, float *v);
+LFORTRAN_API double _lfortran_maxval_r8(int64_t n, double *v);
+LFORTRAN_API float _lfortran_minval_r4(int64_t n, float *v);
+LFORTRAN_API double _lfortran_minval_r8(int64_t n, double *v);
+LFORTRAN_API float _lfortran_norm2_r4(int64_t n, float *v);
+LFORTRAN_API double _lfortran_norm2_r8(int64_t n, double *v);
+LFORTRAN_API float _lfortran_norm2_fast_r4(int64_t n, float *v);
+LFORTRAN_API double _lfortran_norm2_fast_r8(int64_t n, double *v);
 LFORTRAN_API void _lfortran_random_number(int n, double *v);
+LFORTRAN_API void _lfortran_random_number_r4(int64_t n, float *v);
+LFORTRAN_API void _lfortran_random_number_r8(int64_t n, double *v);
+LFORTRAN_API int32_t _lfortran_random_seed_size();
+LFORTRAN_API void _lfortran_random_seed_put(int32_t *put);
+LFORTRAN_API void _lfortran_random_seed_get(int32_t *get);
 LFORTRAN_API void _lfortran_init_random_clock();
 LFORTRAN_API void _lfortran_init_random_seed(unsigned seed);
 LFORTRAN_API double _lfortran_random();
@@ -195,6 +214,9 @@ LFORTRAN_API int32_t _lpython_bit_length8(int64_t num);
 LFORTRAN_API void _lfortran_strrepeat(char** s, int32_t n, char** dest);
 LFORTRAN_API char* _lfortran_strrepeat_c(char* s, int32_t n);
 LFORTRAN_API void _lfortran_strcat(char** s1, char** s2, char** dest);
+LFORTRAN_API void _lfortran_strcat_scratch(char** s1, char** s2, char** dest);
+LFORTRAN_API int64_t _lfortran_string_scratch_mark();
+LFORTRAN_API void _lfortran_string_scratch_release(int64_t mark);
 LFORTRAN_API void _lfortran_strcpy(char** x, char *y, int8_t free_target);
 LFORTRAN_API int32_t _lfortran_str_len(char** s);
 LFORTRAN_API int _lfortran_str_ord(char** s);
@@ -209,9 +231,12 @@ LFORTRAN_API void _lfortran_free(char* ptr);
 LFORTRAN_API void _lfortran_alloc(char** ptr, int32_t len);
 LFORTRAN_API void _lfortran_string_init(int size_plus_one, char *s);
 LFORTRAN_API char* _lfortran_str_item(char* s, int32_t idx);
+LFORTRAN_API char* _lfortran_str_item_scratch(char* s, int32_t idx);
 LFORTRAN_API char* _lfortran_str_copy(char* s, int32_t idx1, int32_t idx2); // idx1 and idx2 both start from 1
 LFORTRAN_API char* _lfortran_str_slice(char* s, int32_t idx1, int32_t idx2, int32_t step,
                         bool idx1_present, bool idx2_present);
+LFORTRAN_API char* _lfortran_str_slice_scratch(char* s, int32_t idx1, int32_t idx2, int32_t step,
+                        bool idx1_present, bool idx2_present);
 LFORTRAN_API char* _lfortran_str_slice_assign(char* s, char *r, int32_t idx1, int32_t idx2, int32_t step,
                         bool idx1_present, bool idx2_present);
 LFORTRAN_API int32_t _lfortran_mvbits32(int32_t from, int32_t frompos,
@@ -231,18 +256,28 @@ LFORTRAN_API double _lfortran_time();
 LFORTRAN_API float _lfortran_sp_rand_num();
 LFORTRAN_API double _lfortran_dp_rand_num();
 LFORTRAN_API int64_t _lpython_open(char *path, char *flags);
-LFORTRAN_API int64_t _lfortran_open(int32_t unit_num, char *f_name, char *status, char* form);
+LFORTRAN_API int64_t _lfortran_open(int32_t unit_num, char *f_name, char *status, char* form, char* access, char* asynchronous);
 LFORTRAN_API void _lfortran_flush(int32_t unit_num);
 LFORTRAN_API void _lfortran_inquire(char *f_name, bool *exists, int32_t unit_num, bool *opened);
+LFORTRAN_API int32_t _lfortran_newunit();
 LFORTRAN_API void _lfortran_formatted_read(int32_t unit_num, int32_t* iostat, int32_t* chunk, char* fmt, int32_t no_of_args, ...);
 LFORTRAN_API char* _lpython_read(int64_t fd, int64_t n);
+LFORTRAN_API void _lfortran_read_int8(int8_t *p, int32_t unit_num);
+LFORTRAN_API void _lfortran_read_int16(int16_t *p, int32_t unit_num);
 LFORTRAN_API void _lfortran_read_int32(int32_t *p, int32_t unit_num);
 LFORTRAN_API void _lfortran_read_int64(int64_t *p, int32_t unit_num);
+LFORTRAN_API void _lfortran_read_array_int8(int8_t *p, int array_size, int32_t unit_num);
+LFORTRAN_API void _lfortran_read_array_int16(int16_t *p, int array_size, int32_t unit_num);
 LFORTRAN_API void _lfortran_read_array_int32(int32_t *p, int array_size, int32_t unit_num);
+LFORTRAN_API void _lfortran_read_array_int64(int64_t *p, int array_size, int32_t unit_num);
 LFORTRAN_API void _lfortran_read_double(double *p, int32_t unit_num);
 LFORTRAN_API void _lfortran_read_float(float *p, int32_t unit_num);
 LFORTRAN_API void _lfortran_read_array_float(float *p, int array_size, int32_t unit_num);
 LFORTRAN_API void _lfortran_read_array_double(double *p, int array_size, int32_t unit_num);
+LFORTRAN_API void _lfortran_read_complex_float(struct _lfortran_complex_32 *p, int32_t unit_num);
+LFORTRAN_API void _lfortran_read_complex_double(struct _lfortran_complex_64 *p, int32_t unit_num);
+LFORTRAN_API void _lfortran_read_array_complex_float(struct _lfortran_complex_32 *p, int array_size, int32_t unit_num);
+LFORTRAN_API void _lfortran_read_array_complex_double(struct _lfortran_complex_64 *p, int array_size, int32_t unit_num);
 LFORTRAN_API void _lfortran_read_char(char **p, int32_t unit_num);
 LFORTRAN_API void _lfortran_string_write(char **str, int32_t* iostat, const char *format, ...);
 LFORTRAN_API void _lfortran_file_write(int32_t unit_num, int32_t* iostat, const char *format, ...);
@@ -262,6 +297,89 @@ LFORTRAN_API int _lfortran_exec_command(char *cmd);
 
 LFORTRAN_API char* _lcompilers_string_format_fortran(int count, const char* format, ...);
 
+// Mirrors the `dimension_descriptor` of arrays in the LLVM backend
+struct _lfortran_dimension_descriptor {
+    int32_t stride, lower_bound, size;
+};
+
+/*
+Types of the items passed to `_lcompilers_string_format_fortran_array`.
+Each item is passed as its type and rank (both int32_t) followed by
+* for a scalar: its value as int64_t (_lfortran_format_int64), double
+  (_lfortran_format_real64), two doubles (_lfortran_format_complex64),
+  "True" or "False" (_lfortran_format_logical) or char*
+  (_lfortran_format_character)
+* for an array: the data pointer, the int32_t offset and the pointer to
+  the dimension descriptors, as stored in the array descriptor; the
+  elements are read in memory with the size given by the type
+*/
+enum _lfortran_format_type {
+    _lfortran_format_int8 = 0,
+    _lfortran_format_int16 = 1,
+    _lfortran_format_int32 = 2,
+    _lfortran_format_int64 = 3,
+    _lfortran_format_real32 = 4,
+    _lfortran_format_real64 = 5,
+    _lfortran_format_complex32 = 6,
+    _lfortran_format_complex64 = 7,
+    _lfortran_format_logical = 8,
+    _lfortran_format_character = 9
+};
+
+LFORTRAN_API char* _lcompilers_string_format_fortran_array(const char* format, int32_t n_items, ...);
+
+/*
+Opcodes of the formats compiled at compile time (see libasr/fortran_format.h)
+and interpreted by `_lcompilers_string_format_fortran_compiled`, which takes
+its items like `_lcompilers_string_format_fortran_array`. Each instruction
+is an opcode byte followed by its operands, unsigned LEB128 numbers:
+* literal n: followed by the n bytes of the string
+* space n (nX), tab n (Tn), scale negative n (nP)
+* repeat n: runs the instructions up to the matching repeat_end n times
+* reversion: where format reversion continues once the format is exhausted
+* unlimited: the format has an unlimited repeat group, *(...)
+* a w, i w m+1 (0 when .m is not given), f w d, e/es/d w d e, en w d, l w
+*/
+enum _lfortran_format_op {
+    _lfortran_format_op_end = 0,
+    _lfortran_format_op_literal = 1,
+    _lfortran_format_op_newline = 2,
+    _lfortran_format_op_space = 3,
+    _lfortran_format_op_tab = 4,
+    _lfortran_format_op_scale = 5,
+    _lfortran_format_op_unlimited = 6,
+    _lfortran_format_op_reversion = 7,
+    _lfortran_format_op_repeat = 8,
+    _lfortran_format_op_repeat_end = 9,
+    _lfortran_format_op_a = 10,
+    _lfortran_format_op_i = 11,
+    _lfortran_format_op_f = 12,
+    _lfortran_format_op_e = 13,
+    _lfortran_format_op_es = 14,
+    _lfortran_format_op_en = 15,
+    _lfortran_format_op_d = 16,
+    _lfortran_format_op_l = 17
+};
+
+LFORTRAN_API char* _lcompilers_string_format_fortran_compiled(const uint8_t* code, int32_t n_items, ...);
+
+/*
+Unformatted data transfer of a whole I/O list as one record. Each item is
+passed as its rank (int32_t), its element size in bytes (int64_t, 0 for
+character data), the size of an element in the record (int64_t, the kind
+of a logical, the length of a character scalar or -1 to take the length of
+the string, otherwise the element size) and its data pointer, followed for
+an array (or array section) by the int32_t offset and the pointer to the
+dimension descriptors, as stored in the array descriptor. Character data
+is a char* for a scalar and the char** of its elements for an array.
+`iostat` is NULL if the statement has no IOSTAT=, then errors are fatal.
+*/
+LFORTRAN_API void _lfortran_unformatted_write(int32_t unit_num, int32_t* iostat, int32_t n_items, ...);
+LFORTRAN_API void _lfortran_unformatted_read(int32_t unit_num, int32_t* iostat, int32_t n_items, ...);
+LFORTRAN_API void _lfortran_unformatted_write_async(int32_t unit_num, int32_t* iostat, int32_t* id, int32_t n_items, ...);
+LFORTRAN_API void _lfortran_unformatted_read_async(int32_t unit_num, int32_t* iostat, int32_t* id, int32_t n_items, ...);
+LFORTRAN_API void _lfortran_wait(int32_t unit_num, int32_t id, int32_t* iostat);
+
 #ifdef __cplusplus
 }
 #endif
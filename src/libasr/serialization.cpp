@@ -23,6 +23,10 @@ class ASRSerializationVisitor :
         public ASR::SerializationBaseVisitor<ASRSerializationVisitor>
 {
 public:
+    // If set, the (symbol table id, name) of every symbol that is referenced
+    // is appended to it
+    std::vector<std::pair<uint64_t, std::string>> *symbol_refs = nullptr;
+
     void write_bool(bool b) {
         if (b) {
             write_int8(1);
@@ -35,6 +39,10 @@ public:
         write_int64(symbol_parent_symtab(&x)->counter);
         write_int8(x.type);
         write_string(symbol_name(&x));
+        if (symbol_refs) {
+            symbol_refs->push_back(std::make_pair(
+                symbol_parent_symtab(&x)->counter, symbol_name(&x)));
+        }
     }
 };
 
@@ -49,6 +57,20 @@ std::string serialize(const ASR::TranslationUnit_t &unit) {
     return serialize((ASR::asr_t&)(unit));
 }
 
+std::string serialize_symbol(const ASR::symbol_t &sym,
+        std::vector<std::pair<uint64_t, std::string>> &symbol_refs) {
+    ASRSerializationVisitor v;
+    v.symbol_refs = &symbol_refs;
+    v.visit_symbol(sym);
+    return v.get_str();
+}
+
+std::string serialize_string(const std::string &s) {
+    ASRSerializationVisitor v;
+    v.write_string(s);
+    return v.get_str();
+}
+
 class ASRDeserializationVisitor :
 #ifdef WITH_LFORTRAN_BINARY_MODFILES
         public BinaryReader,
@@ -58,7 +80,7 @@ class ASRDeserializationVisitor :
         public ASR::DeserializationBaseVisitor<ASRDeserializationVisitor>
 {
 public:
-    ASRDeserializationVisitor(Allocator &al, const std::string &s,
+    ASRDeserializationVisitor(Allocator &al, std::string_view s,
         bool load_symtab_id) :
 #ifdef WITH_LFORTRAN_BINARY_MODFILES
             BinaryReader(s),
@@ -72,11 +94,23 @@ public:
         return (b == 1);
     }
 
+    // Strings and data are copied from the input directly into the arena
+
     char* read_cstring() {
-        std::string s = read_string();
-        LCompilers::Str cs;
-        cs.from_str_view(s);
-        char* p = cs.c_str(al);
+        std::string_view s = read_string_view();
+        char *p = al.allocate<char>(s.size()+1);
+        std::memcpy(p, s.data(), s.size());
+        p[s.size()] = '\0';
+        return p;
+    }
+
+    void* read_void(int64_t n_data) {
+        void *p = al.allocate<char>(n_data);
+#ifdef WITH_LFORTRAN_BINARY_MODFILES
+        BinaryReader::read_void(p, n_data);
+#else
+        TextReader::read_void(p, n_data);
+#endif
         return p;
     }
 
@@ -158,6 +192,11 @@ class FixParentSymtabVisitor : public BaseWalkVisitor<FixParentSymtabVisitor>
 private:
     SymbolTable *current_symtab;
 public:
+    void visit_symbol_in(SymbolTable *symtab, const symbol_t &x) {
+        current_symtab = symtab;
+        this->visit_symbol(x);
+    }
+
     void visit_TranslationUnit(const TranslationUnit_t &x) {
         current_symtab = x.m_symtab;
         x.m_symtab->asr_owner = (asr_t*)&x;
@@ -409,12 +448,12 @@ void fix_external_symbols(ASR::TranslationUnit_t &unit,
     }
 }
 
-ASR::asr_t* deserialize_asr(Allocator &al, const std::string &s,
+ASR::asr_t* deserialize_asr(Allocator &al, std::string_view s,
         bool load_symtab_id, SymbolTable & /*external_symtab*/) {
     return deserialize_asr(al, s, load_symtab_id);
 }
 
-ASR::asr_t* deserialize_asr(Allocator &al, const std::string &s,
+ASR::asr_t* deserialize_asr(Allocator &al, std::string_view s,
         bool load_symtab_id) {
     ASRDeserializationVisitor v(al, s, load_symtab_id);
     ASR::asr_t *node = v.deserialize_node();
@@ -436,4 +475,22 @@ ASR::asr_t* deserialize_asr(Allocator &al, const std::string &s,
     return node;
 }
 
+ASR::symbol_t* deserialize_symbol(Allocator &al, std::string_view s,
+        SymbolTable &symtab, const std::string &name,
+        std::map<uint64_t, SymbolTable*> &id_symtab_map) {
+    ASRDeserializationVisitor v(al, s, false);
+    v.id_symtab_map.swap(id_symtab_map);
+    ASR::symbol_t *sym = ASR::down_cast<ASR::symbol_t>(
+        v.deserialize_symbol());
+    v.symtab_insert_symbol(symtab, name, sym);
+    v.id_symtab_map.swap(id_symtab_map);
+
+    // The symbol may have been referenced (and put into `symtab`) before,
+    // use the one in the symbol table
+    sym = symtab.get_symbol(name);
+    ASR::FixParentSymtabVisitor p;
+    p.visit_symbol_in(&symtab, *sym);
+    return sym;
+}
+
 } // namespace LCompilers
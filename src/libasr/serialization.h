@@ -1,17 +1,33 @@
 #ifndef LIBASR_SERIALIZATION_H
 #define LIBASR_SERIALIZATION_H
 
+#include <string_view>
+
 #include <libasr/asr.h>
 
 namespace LCompilers {
 
     std::string serialize(const ASR::asr_t &asr);
     std::string serialize(const ASR::TranslationUnit_t &unit);
-    ASR::asr_t* deserialize_asr(Allocator &al, const std::string &s,
+    ASR::asr_t* deserialize_asr(Allocator &al, std::string_view s,
             bool load_symtab_id, SymbolTable &symtab);
-    ASR::asr_t* deserialize_asr(Allocator &al, const std::string &s,
+    ASR::asr_t* deserialize_asr(Allocator &al, std::string_view s,
             bool load_symtab_id);
 
+    // Serializes a single symbol, the same way it is serialized as part of
+    // its symbol table. The (symbol table id, name) of all symbols that it
+    // references are appended to `symbol_refs`.
+    std::string serialize_symbol(const ASR::symbol_t &sym,
+            std::vector<std::pair<uint64_t, std::string>> &symbol_refs);
+    // Serializes a string, the same way as symbol names are serialized
+    std::string serialize_string(const std::string &s);
+    // Deserializes a symbol from serialize_symbol() into `symtab` as `name`.
+    // `id_symtab_map` maps the serialized symbol table ids to the symbol
+    // tables loaded so far, the symbol tables of the symbol are added to it.
+    ASR::symbol_t* deserialize_symbol(Allocator &al, std::string_view s,
+            SymbolTable &symtab, const std::string &name,
+            std::map<uint64_t, SymbolTable*> &id_symtab_map);
+
     void fix_external_symbols(ASR::TranslationUnit_t &unit,
             SymbolTable &external_symtab);
 } // namespace LCompilers
@@ -6,6 +6,7 @@
 #include <fstream>
 #include <iomanip>
 #include <sstream>
+#include <functional>
 
 #include <libasr/string_utils.h>
 #include <libasr/containers.h>
@@ -157,6 +158,61 @@ bool is_relative_path(const std::string &path) {
     return !startswith(path, "/");
 }
 
+uint64_t string_hash(std::string_view s, uint64_t h) {
+    for (char c : s) {
+        h ^= (uint8_t)c;
+        h *= 1099511628211ULL;
+    }
+    uint64_t n = s.size();
+    for (int i = 0; i < 8; i++) {
+        h ^= (uint8_t)(n >> 8*i);
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+void StringInterner::grow() {
+    std::vector<Entry> old_table(std::max<size_t>(64, 2*table.size()),
+        Entry{0, 0, nullptr});
+    old_table.swap(table);
+    size_t mask = table.size() - 1;
+    for (auto &e : old_table) {
+        if (e.s) {
+            size_t i = e.hash & mask;
+            while (table[i].s) i = (i + 1) & mask;
+            table[i] = e;
+        }
+    }
+}
+
+char* StringInterner::intern(std::string_view s) {
+    // Keep the load factor at most 1/2
+    if (2*(n_entries + 1) > table.size()) {
+        grow();
+    }
+    size_t h = std::hash<std::string_view>()(s);
+    size_t mask = table.size() - 1;
+    size_t i = h & mask;
+    for (; table[i].s; i = (i + 1) & mask) {
+        if (table[i].hash == h && table[i].n == s.size()
+                && std::memcmp(table[i].s, s.data(), s.size()) == 0) {
+            return table[i].s;
+        }
+    }
+    char *p = al.allocate<char>(s.size() + 1);
+    std::memcpy(p, s.data(), s.size());
+    p[s.size()] = '\0';
+    table[i] = Entry{h, s.size(), p};
+    n_entries++;
+    return p;
+}
+
+std::string hash_to_hex(uint64_t h) {
+    std::stringstream ss;
+    ss << std::setfill('0') << std::setw(16) << std::hex << h;
+    return ss.str();
+}
+
 std::string join_paths(const std::vector<std::string> &paths) {
     std::string p;
     std::string delim = "/";
@@ -2,6 +2,7 @@
 #define LFORTRAN_STRING_UTILS_H
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <cctype>
 
@@ -38,6 +39,48 @@ bool is_relative_path(const std::string &path);
 // Joins paths (paths can be empty)
 std::string join_paths(const std::vector<std::string> &paths);
 
+// Returns a stable (platform independent) 64-bit FNV-1a hash of `s`. Pass
+// a previous hash as `h` to hash several strings in a row; the length of
+// each string is hashed after it, so that ("ab", "c") and ("a", "bc") hash
+// differently.
+uint64_t string_hash(std::string_view s,
+    uint64_t h=14695981039346656037ULL);
+// Returns the hash as a fixed length hexadecimal string
+std::string hash_to_hex(uint64_t h);
+
+// Returns NULL terminated copies of strings allocated using an Allocator,
+// such that equal strings are returned as the same pointer and can be
+// compared by address. Used for the identifiers, the returned strings must
+// not be modified.
+class StringInterner
+{
+    Allocator &al;
+    struct Entry {
+        size_t hash;
+        size_t n;
+        char *s;
+    };
+    // Open addressing (linear probing), empty or a power of two in size
+    std::vector<Entry> table;
+    size_t n_entries = 0;
+
+    void grow();
+
+public:
+    StringInterner(Allocator &al) : al{al} {}
+    StringInterner(const StringInterner&) = delete;
+    StringInterner& operator=(const StringInterner&) = delete;
+
+    char* intern(std::string_view s);
+    char* intern(const Str &s) {
+        return intern(std::string_view(s.p, s.n));
+    }
+
+    size_t size() const {
+        return n_entries;
+    }
+};
+
 // Escapes special characters from the given string
 // using C style escaping
 std::string str_escape_c(const std::string &s);
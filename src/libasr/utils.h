@@ -2,7 +2,9 @@
 #define LIBASR_UTILS_H
 
 #include <string>
+#include <string_view>
 #include <vector>
+#include <memory>
 #include <filesystem>
 #include <libasr/containers.h>
 
@@ -40,10 +42,13 @@ struct PassOptions {
     bool verbose = false; // For developer debugging
     bool dump_all_passes = false; // For developer debugging
     bool dump_fortran = false; // For developer debugging
+    bool time_report = false; // Report the time and memory of each pass
+    bool time_report_json = false; // Print the report of the passes as JSON
     bool pass_cumulative = false; // Apply passes cumulatively
     bool disable_main = false;
     bool use_loop_variable_after_loop = false;
     bool realloc_lhs = false;
+    bool formatted_array_io = false; // for print_arr pass
     std::vector<int64_t> skip_optimization_func_instantiation;
     bool module_name_mangling = false;
     bool global_symbols_mangling = false;
@@ -81,6 +86,13 @@ struct CompilerOptions {
     bool tree = false;
     bool visualize = false;
     bool fast = false;
+    int opt_level = 0; // LLVM optimization level (-O0 ... -O3)
+    int opt_size_level = 0; // 1 for -Os, 2 for -Oz
+    // Number of parts the LLVM module is split into, which are optimized
+    // and compiled to machine code in parallel
+    size_t codegen_units = 1;
+    // Number of threads that parse the program units of a free-form file
+    size_t parse_jobs = 1;
     bool openmp = false;
     std::string openmp_lib_dir = "";
     bool generate_object_code = false;
@@ -99,6 +111,7 @@ struct CompilerOptions {
     bool use_loop_variable_after_loop = false;
     std::string target = "";
     std::string arg_o = "";
+    std::string cache_dir = ""; // compilation cache, disabled if empty
     bool emit_debug_info = false;
     bool emit_debug_line_column = false;
     bool enable_cpython = false;
@@ -117,6 +130,39 @@ struct CompilerOptions {
 };
 
 bool read_file(const std::string &filename, std::string &text);
+
+// Read-only contents of a file, mapped into memory where possible
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile();
+
+    bool load(const std::string &filename);
+
+    std::string_view view() const {
+        return std::string_view(data, size);
+    }
+
+    // Identifies the version of the file on disk that was loaded
+    uint64_t file_id, file_size;
+    int64_t file_mtime;
+
+private:
+    const char *data = nullptr;
+    size_t size = 0;
+    bool mapped = false;
+    // Used if the file is not mapped
+    std::string text;
+};
+
+// Returns the contents of the file `filename`, or nullptr if it cannot be
+// read. Each file is mapped once per process and shared by all the users
+// until it changes on disk, so a file must be replaced (e.g. by renaming
+// a new file over it) instead of being modified in place.
+std::shared_ptr<const MappedFile> map_file(const std::string &filename);
 bool present(Vec<char*> &v, const char* name);
 bool present(char** const v, size_t n, const std::string name);
 int initialize();
@@ -1,6 +1,11 @@
 #ifdef _WIN32
 #define NOMINMAX
 #include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #endif
 
 #include <iostream>
@@ -8,6 +13,8 @@
 #include <filesystem>
 #include <random>
 #include <sstream>
+#include <map>
+#include <mutex>
 
 #include <libasr/exception.h>
 #include <libasr/utils.h>
@@ -45,6 +52,99 @@ bool read_file(const std::string &filename, std::string &text)
     return true;
 }
 
+#ifndef _WIN32
+static void get_file_id(const struct stat &st, uint64_t &file_id,
+        uint64_t &file_size, int64_t &file_mtime) {
+    file_id = st.st_ino;
+    file_size = st.st_size;
+#ifdef __APPLE__
+    file_mtime = st.st_mtimespec.tv_sec * 1000000000LL
+        + st.st_mtimespec.tv_nsec;
+#else
+    file_mtime = st.st_mtim.tv_sec * 1000000000LL + st.st_mtim.tv_nsec;
+#endif
+}
+#endif
+
+static bool get_file_id(const std::string &filename, uint64_t &file_id,
+        uint64_t &file_size, int64_t &file_mtime) {
+#ifdef _WIN32
+    std::error_code ec;
+    file_size = std::filesystem::file_size(filename, ec);
+    if (ec) return false;
+    file_mtime = std::filesystem::last_write_time(filename, ec)
+        .time_since_epoch().count();
+    if (ec) return false;
+    file_id = 0;
+#else
+    struct stat st;
+    if (stat(filename.c_str(), &st) != 0) return false;
+    get_file_id(st, file_id, file_size, file_mtime);
+#endif
+    return true;
+}
+
+MappedFile::~MappedFile() {
+#ifndef _WIN32
+    if (mapped) {
+        munmap(const_cast<char*>(data), size);
+    }
+#endif
+}
+
+bool MappedFile::load(const std::string &filename) {
+#ifndef _WIN32
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return false;
+    }
+    get_file_id(st, file_id, file_size, file_mtime);
+    if (st.st_size > 0) {
+        void *p = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p != MAP_FAILED) {
+            data = (const char*)p;
+            size = st.st_size;
+            mapped = true;
+        }
+    }
+    close(fd);
+    if (mapped) return true;
+#else
+    if (!get_file_id(filename, file_id, file_size, file_mtime)) return false;
+#endif
+    if (!read_file(filename, text)) return false;
+    data = text.data();
+    size = text.size();
+    return true;
+}
+
+std::shared_ptr<const MappedFile> map_file(const std::string &filename) {
+    static std::mutex files_mutex;
+    static std::map<std::string, std::shared_ptr<const MappedFile>> files;
+
+    uint64_t file_id, file_size;
+    int64_t file_mtime;
+    if (!get_file_id(filename, file_id, file_size, file_mtime)) {
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(files_mutex);
+    auto it = files.find(filename);
+    if (it != files.end() && it->second->file_id == file_id
+            && it->second->file_size == file_size
+            && it->second->file_mtime == file_mtime) {
+        return it->second;
+    }
+    std::shared_ptr<MappedFile> f = std::make_shared<MappedFile>();
+    if (!f->load(filename)) {
+        return nullptr;
+    }
+    files[filename] = f;
+    return f;
+}
+
 bool present(Vec<char*> &v, const char* name) {
     for (auto &a : v) {
         if (std::string(a) == std::string(name)) {
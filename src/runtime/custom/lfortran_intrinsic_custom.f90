@@ -5,20 +5,12 @@ contains
 
     subroutine newunit(unit)
         implicit none
-        integer, parameter :: LUN_MIN=0, LUN_MAX=1000
-        logical :: opened
-        integer :: lun
         integer, intent(out) :: unit
-
-        do lun=LUN_MIN,LUN_MAX
-            inquire(unit=lun,opened=opened)
-            if (.not. opened) then
-                unit = lun
-                return
-            end if
-        end do
-        print *, "All unit numbers are utilized"
-        error stop
+        interface
+            integer(4) function c_newunit() bind(c, name="_lfortran_newunit")
+            end function
+        end interface
+        unit = c_newunit()
     end subroutine newunit
 
 end module